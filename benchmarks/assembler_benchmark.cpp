@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <format>
+
+#include "core/assembler.hpp"
+#include "legacy_assembler.hpp"
+
+namespace {
+    constexpr size_t BLOCK_COUNT = 5000;
+
+    /**
+     * Формирует исходный код из повторяющихся блоков с метками, модификаторами, числами разных форматов,
+     * символами и комментариями.
+     */
+    std::string GenerateSource() {
+        std::string source;
+
+        for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+            source += std::format(
+                "Value{0}: {0}\n"
+                "Real{0}: r {0}.25 // число с плавающей запятой\n"
+                "Loop{0}:\n"
+                "    Load & Value{0}\n"
+                "    Add sw -{0}\n"
+                "    Sub w 0x{0:X}\n"
+                "    Mul 0b{0:b}\n"
+                "    Load c ' '\n"
+                "    SkipLo && Value{0}\n"
+                "    Store Value{0}\n"
+                "    Output c\n"
+                "    Jump Loop{0}\n",
+                i);
+        }
+
+        return source + "Halt\n";
+    }
+}
+
+template <typename T>
+static void BM_Assembler(benchmark::State& state) {
+    static const std::string source = GenerateSource();
+    const auto line_count = static_cast<int64_t>(std::ranges::count(source, '\n'));
+    T assembler{};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(assembler.Compile(source));
+    }
+
+    // Пропускная способность в строках исходного кода в секунду
+    state.SetItemsProcessed(state.iterations() * line_count);
+}
+
+BENCHMARK_TEMPLATE(BM_Assembler, Assembler)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Assembler, legacy::LegacyAssembler)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include "core/assembler.hpp"
+#include "core/batch_runner.hpp"
+
+namespace {
+    constexpr size_t JOB_COUNT = 1000;
+
+    /**
+     * Суммирует числа от 1 до введённого значения.
+     */
+    const std::string SUM = R"(
+        n: 0
+        sum: 0
+        Input
+        Store n
+        Loop:
+            Load & sum
+            Add & n
+            Store sum
+            Load & n
+            Sub 1
+            Store n
+            SkipEq 0
+            Jump Loop
+        Load & sum
+        Output
+    )";
+}
+
+/**
+ * Исполнение пакета заданий разной длительности. Аргумент: количество потоков.
+ */
+static void BM_BatchRunner(benchmark::State& state) {
+    Assembler assembler{};
+    const snm::ByteCode byte_code = assembler.Compile(SUM);
+
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < JOB_COUNT; ++i) {
+        inputs.push_back(std::to_string(i % 100 * 100 + 1));
+    }
+
+    const BatchRunner runner(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runner.Run(byte_code, inputs));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * JOB_COUNT));
+}
+
+BENCHMARK(BM_BatchRunner)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * Запись значения в snm::Bytes и чтение обратно в тот же тип.
+ */
+template <typename T>
+static void BM_BytesRoundTrip(benchmark::State& state) {
+    T value = 1;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value);
+        const snm::Bytes bytes(value);
+        benchmark::DoNotOptimize(bytes);
+        value = static_cast<T>(bytes);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_BytesRoundTrip, snm::Byte);
+BENCHMARK_TEMPLATE(BM_BytesRoundTrip, snm::Word);
+BENCHMARK_TEMPLATE(BM_BytesRoundTrip, snm::SignedWord);
+BENCHMARK_TEMPLATE(BM_BytesRoundTrip, snm::Real);
+
+/**
+ * Строковые представления, используемые при отображении памяти и регистров.
+ */
+static void BM_BytesToString(benchmark::State& state, const bool binary) {
+    snm::Bytes bytes(static_cast<snm::Word>(0xDEADBEEF));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(binary ? bytes.ToBinString() : bytes.ToHexString());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_BytesToString, hex, false);
+BENCHMARK_CAPTURE(BM_BytesToString, bin, true);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "core/assembler.hpp"
+#include "core/processor.hpp"
+#include "null_io.hpp"
+
+namespace {
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+}
+
+/**
+ * Исполнение программы из docs/examples от сброса до завершения. На запросы ввода возвращается единица.
+ */
+static void BM_Example(benchmark::State& state, const std::filesystem::path& path, const snm::ExecutionMode mode) {
+    Assembler assembler{};
+    MemoryManager memory;
+    NullIo io;
+    Processor processor(memory, nullptr, &io);
+
+    memory.Load(assembler.Compile(ReadFile(path)));
+    processor.SetExecutionMode(mode);
+
+    uint64_t instructions = 0;
+
+    for (auto _ : state) {
+        memory.ResetData();
+        processor.Reset();
+        processor.Run();
+        instructions += processor.GetInstructionCount();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(instructions));
+}
+
+/**
+ * Регистрирует BM_Example для каждого файла .snm из SNM_EXAMPLES_DIR. Имена имеют вид BM_Example/stack/threaded.
+ */
+[[maybe_unused]] static const bool EXAMPLE_BENCHMARKS_REGISTERED = [] {
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::directory_iterator(SNM_EXAMPLES_DIR)) {
+        if (entry.path().extension() == ".snm") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(paths);
+
+    const std::initializer_list<std::pair<snm::ExecutionMode, std::string_view>> modes = {
+        {snm::ExecutionMode::JIT, "jit"},
+        {snm::ExecutionMode::FUSED, "fused"},
+        {snm::ExecutionMode::THREADED, "threaded"},
+        {snm::ExecutionMode::REFERENCE, "reference"}
+    };
+
+    for (const auto& [mode, mode_name] : modes) {
+        for (const auto& path : paths) {
+            const std::string name = std::format("BM_Example/{}/{}", path.stem().string(), mode_name);
+
+            benchmark::RegisterBenchmark(name.c_str(), BM_Example, path, mode);
+        }
+    }
+
+    return true;
+}();
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <limits>
+
+#include "core/memory_manager.hpp"
+
+namespace {
+    /**
+     * Максимальное количество инструкций, принимаемое MemoryManager::Load().
+     */
+    constexpr int64_t MAX_INSTRUCTION_COUNT = std::numeric_limits<snm::Address>::max() / (1 + snm::ARGUMENT_SIZE);
+    /**
+     * Шаг между записываемыми ячейками, равный размеру страницы, отслеживаемой ResetData().
+     */
+    constexpr snm::Address PAGE_STRIDE = 256;
+
+    snm::ByteCode GenerateProgram(const size_t instruction_count) {
+        snm::ByteCode byte_code;
+        for (size_t i = 0; i < instruction_count; ++i) {
+            byte_code.push_back(snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::SW));
+            const snm::Bytes argument(static_cast<snm::Word>(i));
+            byte_code.insert(byte_code.end(), argument.begin(), argument.end());
+        }
+        return byte_code;
+    }
+}
+
+/**
+ * Загрузка байт-кода в память. Аргумент: количество инструкций.
+ */
+static void BM_MemoryLoad(benchmark::State& state) {
+    MemoryManager memory;
+    const snm::ByteCode byte_code = GenerateProgram(state.range(0));
+
+    for (auto _ : state) {
+        memory.Load(byte_code);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(byte_code.size()));
+}
+
+BENCHMARK(BM_MemoryLoad)->RangeMultiplier(8)->Range(8, MAX_INSTRUCTION_COUNT);
+
+/**
+ * Изменение данных и их восстановление. Аргумент: количество изменённых страниц памяти. Запись одной ячейки
+ * на страницу входит в измерение, так как приостановка таймера обходится дороже самого сброса.
+ */
+static void BM_MemoryResetData(benchmark::State& state) {
+    MemoryManager memory;
+    memory.Load(GenerateProgram(MAX_INSTRUCTION_COUNT));
+
+    for (auto _ : state) {
+        for (int64_t page = 0; page < state.range(0); ++page) {
+            const auto address = static_cast<snm::Address>(page * PAGE_STRIDE);
+            memory.WriteArgument(snm::Bytes(static_cast<snm::Word>(page)), address);
+        }
+        memory.ResetData();
+    }
+}
+
+BENCHMARK(BM_MemoryResetData)->Arg(0)->Arg(1)->Arg(16)->Arg(snm::CODE_MEMORY_SIZE / PAGE_STRIDE);
+
+/**
+ * Снимок памяти. Аргумент: количество изменённых страниц памяти.
+ */
+static void BM_MemorySnapshot(benchmark::State& state) {
+    MemoryManager memory;
+    memory.Load(GenerateProgram(MAX_INSTRUCTION_COUNT));
+    for (int64_t page = 0; page < state.range(0); ++page) {
+        memory.WriteArgument(snm::Bytes(static_cast<snm::Word>(page)), static_cast<snm::Address>(page * PAGE_STRIDE));
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(memory.TakeSnapshot());
+    }
+}
+
+BENCHMARK(BM_MemorySnapshot)->Arg(0)->Arg(1)->Arg(16)->Arg(snm::CODE_MEMORY_SIZE / PAGE_STRIDE);
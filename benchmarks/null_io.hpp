@@ -0,0 +1,27 @@
+#ifndef NULL_IO_HPP
+#define NULL_IO_HPP
+
+#include "core/processor_io.hpp"
+
+/**
+ * Ввод-вывод без задержек: вывод игнорируется, на запрос ввода сразу возвращается заданное значение.
+ * Измеряется только стоимость обращения процессора к устройству.
+ */
+class NullIo final : public ProcessorIo {
+public:
+    explicit NullIo(const snm::Bytes input = snm::Bytes(1)) :
+        input_(input) {
+    }
+
+    void InputRequest(snm::Type, const InputCallback callback) override {
+        callback(input_);
+    }
+
+    void OutputRequest(snm::Bytes, snm::Type) override {
+    }
+
+private:
+    snm::Bytes input_;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <format>
+
+#include "core/processor.hpp"
+#include "null_io.hpp"
+
+namespace {
+    /**
+     * Количество инструкций в программе. Ограничено размером байт-кода, принимаемого MemoryManager::Load().
+     */
+    constexpr snm::Address INSTRUCTION_COUNT = 10000;
+    /**
+     * Адрес ячейки данных за пределами программы, в которую пишет STORE.
+     */
+    constexpr snm::Address DATA_ADDRESS = INSTRUCTION_COUNT + 1;
+
+    /**
+     * Возвращает аргумент инструкции по адресу. Переходы ведут на следующую инструкцию, остальные команды
+     * получают единицу, поэтому деление корректно, а условия пропусков при нулевом аккумуляторе не выполняются.
+     */
+    snm::Bytes ArgumentFor(const snm::OpCode opcode, const snm::TypeModifier type_modifier,
+                           const snm::Address address) {
+        switch (opcode) {
+            case snm::OpCode::STORE:
+                return snm::Bytes(static_cast<snm::Word>(DATA_ADDRESS));
+            case snm::OpCode::JUMP:
+            case snm::OpCode::JUMPNSTORE:
+                return snm::Bytes(static_cast<snm::Word>(address + 1));
+            default:
+                return type_modifier == snm::TypeModifier::R ? snm::Bytes(1.0f) : snm::Bytes(1);
+        }
+    }
+
+    /**
+     * Формирует программу из INSTRUCTION_COUNT одинаковых инструкций без модификатора аргумента.
+     */
+    snm::ByteCode GenerateProgram(const snm::OpCode opcode, const snm::TypeModifier type_modifier) {
+        snm::ByteCode byte_code;
+        byte_code.reserve(INSTRUCTION_COUNT * (1 + snm::ARGUMENT_SIZE));
+
+        for (snm::Address address = 0; address < INSTRUCTION_COUNT; ++address) {
+            byte_code.push_back(snm::InstructionByte(opcode, type_modifier));
+            const snm::Bytes argument = ArgumentFor(opcode, type_modifier, address);
+            byte_code.insert(byte_code.end(), argument.begin(), argument.end());
+        }
+
+        return byte_code;
+    }
+}
+
+/**
+ * Пропускная способность исполнения одной комбинации команды и модификатора типа.
+ *
+ * Условия пропусков не выполняются. JNS записывает адрес возврата в следующую ячейку и переходит через неё,
+ * поэтому для него исполняется половина программы. Количество инструкций берётся из счётчика процессора.
+ */
+static void BM_Instruction(benchmark::State& state, const snm::OpCode opcode, const snm::TypeModifier type_modifier,
+                           const snm::ExecutionMode mode) {
+    MemoryManager memory;
+    NullIo io;
+    Processor processor(memory, nullptr, &io);
+
+    memory.Load(GenerateProgram(opcode, type_modifier));
+    processor.SetExecutionMode(mode);
+
+    uint64_t instructions = 0;
+
+    for (auto _ : state) {
+        memory.ResetData();
+        processor.Reset();
+        processor.Run();
+        instructions += processor.GetInstructionCount();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(instructions));
+}
+
+/**
+ * Регистрирует BM_Instruction для всех допустимых модификаторов типа каждой команды, кроме HALT.
+ * Имена имеют вид BM_Instruction/ADD/SW/threaded.
+ */
+[[maybe_unused]] static const bool INSTRUCTION_BENCHMARKS_REGISTERED = [] {
+    constexpr std::array<std::string_view, 4> TYPE_MODIFIER_NAMES = {"C", "W", "SW", "R"};
+
+    for (const auto mode : {snm::ExecutionMode::THREADED, snm::ExecutionMode::REFERENCE}) {
+        for (int i = 0; i < static_cast<int>(snm::OpCode::HALT); ++i) {
+            const auto opcode = static_cast<snm::OpCode>(i);
+            const auto& properties = snm::OPCODE_PROPERTIES.at(opcode);
+
+            for (const auto type_modifier : properties.allowed_type_modifiers) {
+                const std::string name = std::format(
+                    "BM_Instruction/{}/{}/{}", properties.name,
+                    TYPE_MODIFIER_NAMES[static_cast<size_t>(type_modifier)],
+                    mode == snm::ExecutionMode::THREADED ? "threaded" : "reference");
+
+                benchmark::RegisterBenchmark(name.c_str(), BM_Instruction, opcode, type_modifier, mode);
+            }
+        }
+    }
+
+    return true;
+}();
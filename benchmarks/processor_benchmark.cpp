@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include "core/assembler.hpp"
+#include "core/processor.hpp"
+
+namespace {
+    /**
+     * Наблюдатель, игнорирующий все уведомления. Измеряется только стоимость их формирования.
+     */
+    class NullObserver final : public ProcessorObserver {
+    public:
+        void OnRegisterIpChanged(const snm::Address&) override {
+        }
+
+        void OnRegisterAccChanged(const snm::Bytes&) override {
+        }
+
+        void OnRegisterAuxChanged(const snm::Bytes&) override {
+        }
+
+        void OnMemoryChanged(const snm::Address&) override {
+        }
+
+        void OnStateChanged(const snm::ProcessorState&) override {
+        }
+    };
+
+    const std::string COUNTING_LOOP = R"(
+        i: 0
+        n: 100000
+        Loop:
+            Load & i
+            SkipLo & n
+            Jump End
+            Load & i
+            Add 1
+            Store i
+            Jump Loop
+        End:
+    )";
+}
+
+static void BM_ObserverOverhead(benchmark::State& state, const snm::ExecutionMode mode, const bool observed) {
+    Assembler assembler{};
+    MemoryManager memory;
+    NullObserver observer;
+    Processor processor(memory, observed ? &observer : nullptr);
+
+    memory.Load(assembler.Compile(COUNTING_LOOP));
+    processor.SetExecutionMode(mode);
+
+    uint64_t instructions = 0;
+
+    for (auto _ : state) {
+        memory.ResetData();
+        processor.Reset();
+        processor.Run();
+        instructions += processor.GetInstructionCount();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(instructions));
+}
+
+BENCHMARK_CAPTURE(BM_ObserverOverhead, threaded_unobserved, snm::ExecutionMode::THREADED, false);
+BENCHMARK_CAPTURE(BM_ObserverOverhead, threaded_observed, snm::ExecutionMode::THREADED, true);
+BENCHMARK_CAPTURE(BM_ObserverOverhead, reference_unobserved, snm::ExecutionMode::REFERENCE, false);
+BENCHMARK_CAPTURE(BM_ObserverOverhead, reference_observed, snm::ExecutionMode::REFERENCE, true);
+
+static void BM_ProfilerOverhead(benchmark::State& state, const snm::ExecutionMode mode) {
+    Assembler assembler{};
+    MemoryManager memory;
+    Processor processor(memory);
+    Profiler profiler;
+
+    memory.Load(assembler.Compile(COUNTING_LOOP));
+    processor.SetExecutionMode(mode);
+    processor.SetProfiler(&profiler);
+
+    uint64_t instructions = 0;
+
+    for (auto _ : state) {
+        memory.ResetData();
+        processor.Reset();
+        processor.Run();
+        instructions += processor.GetInstructionCount();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(instructions));
+}
+
+BENCHMARK_CAPTURE(BM_ProfilerOverhead, threaded, snm::ExecutionMode::THREADED);
+BENCHMARK_CAPTURE(BM_ProfilerOverhead, reference, snm::ExecutionMode::REFERENCE);
@@ -0,0 +1,200 @@
+#ifndef AOT_RUNTIME_HPP
+#define AOT_RUNTIME_HPP
+
+#include <bitset>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+#include "core/memory_manager.hpp"
+#include "core/processor.hpp"
+#include "core/processor_io.hpp"
+
+class AotRuntime;
+
+/**
+ * @struct AotProgram
+ * @brief Программа, оттранслированная sandm-aot в исходный код C++ (см. AotTranslator).
+ */
+struct AotProgram {
+    std::span<const snm::Byte> byte_code; ///< Байт-код, из которого получена функция
+    void (*run)(AotRuntime& runtime); ///< Исполняет программу с регистров среды до завершения
+};
+
+/**
+ * @class AotRuntime
+ * @brief Среда исполнения программ, оттранслированных sandm-aot.
+ *
+ * Хранит память программы, регистры и счётчик инструкций, передаёт ввод-вывод обработчику ProcessorIo.
+ * Оттранслированный код встраивает аргументы инструкций как константы, поэтому запись в ячейку с кодом
+ * операции, отличным от NOPE, передаёт исполнение интерпретатору Processor с текущими регистрами и памятью.
+ * Результаты, включая сообщения об ошибках и количество инструкций, совпадают с Processor::Run().
+ */
+class AotRuntime {
+public:
+    /**
+     * @brief Конструктор класса AotRuntime.
+     * @param program Оттранслированная программа. Её байт-код загружается в память среды.
+     * @param io Обработчик ввода-вывода. Ввод ожидается, если значение передаётся асинхронно.
+     */
+    AotRuntime(const AotProgram& program, ProcessorIo& io);
+
+    /**
+     * @brief Исполняет программу с текущих регистров до останова.
+     *
+     * Ошибка исполнения выбрасывается так же, как из Processor::Run(); регистры и количество инструкций
+     * к этому моменту обновлены.
+     */
+    void Run();
+    /**
+     * @brief Восстанавливает исходные аргументы памяти и обнуляет регистры и счётчик инструкций.
+     */
+    void Reset();
+
+    [[nodiscard]] const Registers& GetRegisters() const;
+    [[nodiscard]] uint64_t GetInstructionCount() const;
+    [[nodiscard]] const MemoryManager& GetMemory() const;
+    /**
+     * @brief Проверяет, передавалось ли исполнение интерпретатору с последнего Reset().
+     */
+    [[nodiscard]] bool IsInterpreted() const;
+
+    /**
+     * @brief Точка входа исполняемого файла, сгенерированного sandm-aot.
+     *
+     * Ввод читается из stdin или из файла, заданного параметром -i, вывод пишется в stdout, отчёт о выполнении
+     * в формате sandm-run — в stderr, если не задан параметр -q.
+     *
+     * @return Код завершения: 0 при успехе, 1 при ошибке исполнения, 2 при неверных аргументах.
+     */
+    static int Main(int argc, char* argv[], const AotProgram& program);
+
+    /*
+     *  Операции, вызываемые оттранслированным кодом
+     */
+
+    [[nodiscard]] snm::Bytes Read(const snm::Address address) const {
+        return memory_.ReadArgument(address);
+    }
+
+    /**
+     * @brief Записывает аргумент командой JnS.
+     * @return true, если записана ячейка с кодом и исполнение нужно передать интерпретатору.
+     */
+    bool Write(const snm::Bytes value, const snm::Address address) {
+        memory_.WriteArgument(value, address);
+        return code_cells_.test(address);
+    }
+
+    /**
+     * @brief Записывает аргумент командой Store с проверкой адреса, как в Processor.
+     * @return true, если записана ячейка с кодом и исполнение нужно передать интерпретатору.
+     */
+    bool Store(const snm::Bytes value, const snm::Bytes address, const snm::Address instruction_pointer) {
+        const auto target = static_cast<snm::Word>(address);
+        if (target >= snm::CODE_MEMORY_SIZE) [[unlikely]] {
+            ThrowAddressOutOfRange(target, instruction_pointer);
+        }
+        return Write(value, static_cast<snm::Address>(target));
+    }
+
+    /**
+     * @brief Запрашивает ввод и ожидает значение.
+     */
+    snm::Bytes Input(snm::Type type);
+
+    void Output(const snm::Bytes value, const snm::Type type) {
+        io_.OutputRequest(value, type);
+    }
+
+    /**
+     * @brief Сохраняет регистры и количество инструкций при выходе из оттранслированного кода.
+     */
+    void Finish(const Registers& registers, uint64_t instruction_count);
+    /**
+     * @brief Продолжает исполнение интерпретатором с заданных регистров после записи в ячейку с кодом.
+     */
+    void Interpret(const Registers& registers, uint64_t instruction_count);
+
+private:
+    MemoryManager memory_; ///< Память программы
+    ProcessorIo& io_; ///< Обработчик ввода-вывода
+    const AotProgram& program_; ///< Исполняемая программа
+    std::bitset<snm::CODE_MEMORY_SIZE> code_cells_; ///< Ячейки программы с кодом операции, отличным от NOPE
+    Registers registers_{}; ///< Регистры после последнего выхода из программы
+    uint64_t instruction_count_ = 0; ///< Количество выполненных инструкций
+    bool interpreted_ = false; ///< Исполнение передавалось интерпретатору
+
+    std::mutex input_mutex_; ///< Защищает input_
+    std::condition_variable input_ready_; ///< Оповещает о поступлении ввода
+    std::optional<snm::Bytes> input_; ///< Введённое значение, ещё не переданное программе
+
+    [[noreturn]] static void ThrowAddressOutOfRange(snm::Word address, snm::Address instruction_pointer);
+};
+
+/**
+ * @brief Операции над регистрами для оттранслированного кода. Совпадают с обработчиками Processor.
+ */
+namespace snm::aot {
+    template <typename T>
+    Bytes Add(const Bytes lhs, const Bytes rhs) {
+        return Bytes(static_cast<T>(static_cast<T>(lhs) + static_cast<T>(rhs)));
+    }
+
+    template <typename T>
+    Bytes Sub(const Bytes lhs, const Bytes rhs) {
+        return Bytes(static_cast<T>(static_cast<T>(lhs) - static_cast<T>(rhs)));
+    }
+
+    template <typename T>
+    Bytes Mul(const Bytes lhs, const Bytes rhs) {
+        return Bytes(static_cast<T>(static_cast<T>(lhs) * static_cast<T>(rhs)));
+    }
+
+    template <typename T>
+    Bytes Div(const Bytes lhs, const Bytes rhs) {
+        const T value = static_cast<T>(rhs);
+        if (value == static_cast<T>(0)) {
+            throw std::runtime_error("Error: Division by zero");
+        }
+        return Bytes(static_cast<T>(static_cast<T>(lhs) / value));
+    }
+
+    template <typename T>
+    Bytes Mod(const Bytes lhs, const Bytes rhs) {
+        const T value = static_cast<T>(rhs);
+        if (value == static_cast<T>(0)) {
+            throw std::runtime_error("Error: Modulo by zero");
+        }
+        if constexpr (std::is_same_v<T, Real>) {
+            return Bytes(::fmodf(static_cast<T>(lhs), value));
+        } else {
+            return Bytes(static_cast<T>(static_cast<T>(lhs) % value));
+        }
+    }
+
+    template <typename T>
+    Bytes Load(const Bytes value) {
+        return Bytes(static_cast<T>(value));
+    }
+
+    template <typename T>
+    bool Lower(const Bytes lhs, const Bytes rhs) {
+        return static_cast<T>(lhs) < static_cast<T>(rhs);
+    }
+
+    template <typename T>
+    bool Greater(const Bytes lhs, const Bytes rhs) {
+        return static_cast<T>(lhs) > static_cast<T>(rhs);
+    }
+
+    template <typename T>
+    bool Equal(const Bytes lhs, const Bytes rhs) {
+        return static_cast<T>(lhs) == static_cast<T>(rhs);
+    }
+}
+
+#endif
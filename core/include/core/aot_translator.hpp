@@ -0,0 +1,37 @@
+#ifndef AOT_TRANSLATOR_HPP
+#define AOT_TRANSLATOR_HPP
+
+#include <span>
+#include <string>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * @class AotTranslator
+ * @brief Транслятор байт-кода SANDM в единицу трансляции C++ для исполнения без интерпретатора.
+ *
+ * Каждая ячейка программы становится помеченным блоком функции, который выполняет инструкцию с аргументом,
+ * встроенным как константа. Переходы и пропуски с известным адресом становятся goto на блок, переходы
+ * по адресу из памяти выполняются через switch по всем адресам программы. Ввод-вывод, запись памяти
+ * и переход к интерпретатору после записи в ячейку с кодом выполняет AotRuntime, с библиотекой которой
+ * собирается результат.
+ *
+ * Результат определяет переменную AotProgram с заданным именем или, если имя не задано, функцию main,
+ * вызывающую AotRuntime::Main().
+ */
+class AotTranslator {
+public:
+    /**
+     * @brief Транслирует байт-код в исходный код C++.
+     *
+     * @param byte_code Байт-код в формате MemoryManager::Load().
+     * @param name Имя определяемой переменной AotProgram. Если пусто, определяется функция main.
+     * @param labels Адреса меток, добавляемых в результат комментариями.
+     * @return Исходный код единицы трансляции.
+     * @throws std::invalid_argument Если формат байт-кода некорректен или имя не является идентификатором C++.
+     */
+    [[nodiscard]] static std::string Translate(std::span<const snm::Byte> byte_code, const std::string& name = {},
+                                               const snm::LabelMap& labels = {});
+};
+
+#endif
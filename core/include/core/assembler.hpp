@@ -7,12 +7,13 @@
 #include <format>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <numeric>
-#include <regex>
+#include <optional>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <set>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "core/common_definitions.hpp"
@@ -31,10 +32,19 @@ struct Instruction {
     snm::TypeModifier type_modifier = snm::TypeModifier::SW; ///< Модификатор типа
     std::optional<snm::Bytes> argument{}; ///< Значение аргумента команды
     std::optional<std::string> using_label_name; ///< Имя метки, используемой в качестве аргумента
-    std::optional<std::string> label_name; ///< Имя метки этой инструкции
+    std::optional<std::string> label_name; ///< Имя метки этой инструкции в верхнем регистре
     unsigned int line_number = 0; ///< Номер строки в исходном коде
 };
 
+/**
+ * @brief Результат трансляции программы с отладочной информацией.
+ */
+struct Program {
+    snm::ByteCode byte_code; ///< Байт-код программы
+    snm::LabelMap labels; ///< Адреса меток. Имена меток в верхнем регистре.
+    snm::SourceToBytecodeMap source_map; ///< Соответствие строк исходного кода адресам байт-кода
+};
+
 /**
  * @brief Класс, реализующий ассемблер для компиляции исходного кода в байт-код.
  *
@@ -70,6 +80,14 @@ public:
      * строк исходного кода адресам байт-кода.
      */
     std::pair<snm::ByteCode, snm::SourceToBytecodeMap> CompileWithDebugInfo(const std::string& source);
+    /**
+     * @brief Компилирует исходный код в байт-код с таблицей меток и отладочной информацией.
+     *
+     * @param source Исходный код для компиляции, представленный в виде строки.
+     * @return Байт-код программы, адреса меток и карта соответствий строк исходного кода адресам байт-кода.
+     * @throw std::runtime_error В случае наличия ошибок в исходном коде.
+     */
+    Program CompileProgram(const std::string& source);
     /**
      * @brief Проверяет исходный код на наличие ошибок.
      *
@@ -85,12 +103,13 @@ public:
     std::vector<std::string> TestSource(const std::string& source);
 
 private:
-    std::unordered_map<std::string, snm::OpCode> opcode_map_;
+    /**
+     * @brief Разбивает строку исходного кода на токены без копирования.
+     */
+    class Tokenizer;
+
+    std::vector<std::pair<std::string, snm::OpCode>> opcodes_;
     ///< Соответствие строковых имен команд в верхнем регистре перечислению
-    std::unordered_map<std::string, snm::TypeModifier> type_modifier_map_;
-    ///< Соответствие строковых имен модификаторов типов в верхнем регистре перечислению
-    std::unordered_map<std::string, snm::ArgModifier> arg_modifier_map_;
-    ///< Соответствие строковых имен модификаторов адресов в верхнем регистре перечислению
     unsigned int line_number_; ///< Номер текущей обрабатываемой строки в исходном коде
 
     /**
@@ -119,18 +138,21 @@ private:
     static T Exception(const std::string& message, unsigned int line_number);
 
     /**
-     * @brief Удаляет начальные и конечные пробелы, а также избыточные пробельные символы
-     * внутри строки.
+     * @brief Удаляет начальные и конечные пробелы и табуляции.
+     * @param str Исходная строка.
+     * @return Часть строки без начальных и конечных пробельных символов.
+     */
+    static std::string_view Trim(std::string_view str);
+    /**
+     * @brief Приводит строку к виду, используемому в сообщениях об ошибках.
      *
-     * Метод обрезает лишние пробелы и табуляции с начала и конца строки, а также заменяет
-     * последовательности пробельных символов внутри строки на один пробел. Это позволяет
-     * получить строку в упрощённом формате без лишних пробелов.
+     * Последовательности пробелов и табуляций внутри строки заменяются одним пробелом.
+     * Вызывается только при формировании сообщения, поэтому при успешном разборе строка не копируется.
      *
-     * @param str Исходная строка, из которой требуется удалить лишние пробелы.
-     * @return Результирующая строка с удалёнными начальными, конечными и избыточными
-     * пробельными символами.
+     * @param line Строка без комментария, начальных и конечных пробельных символов.
+     * @return Строка с одиночными пробелами между токенами.
      */
-    static std::string Trim(const std::string& str);
+    static std::string NormalizeLine(std::string_view line);
     /**
      * @brief Проверяет, является ли заданное имя допустимым именем метки.
      *
@@ -142,7 +164,7 @@ private:
      * @return true, если имя соответствует правилам именования меток;
      *         false, если имя недопустимо.
      */
-    static bool IsValidLabelName(const std::string& name);
+    static bool IsValidLabelName(std::string_view name);
     /**
      * @brief Проверяет, является ли переданная строка допустимым символом.
      *
@@ -153,44 +175,30 @@ private:
      * @param token Строка, представляющая предполагаемый символьный литерал.
      * @return true, если строка является допустимым символом; false в противном случае.
      */
-    static bool IsValidChar(const std::string& token) ;
-    /**
-     * @brief Проверяет, является ли значение допустимым для заданного модификатора типа.
-     *
-     * Метод осуществляет валидацию значения в зависимости от типа модификатора,
-     * чтобы убедиться, что значение находится в пределах допустимого диапазона
-     * для этого типа.
-     *
-     * @param bytes Значение, представленное в виде последовательности байтов.
-     * @param type_modifier Модификатор типа, определяющий, какой тип значения проверяется.
-     * @return true, если значение допустимо для указанного модификатора типа, иначе false.
-     */
-    static bool IsNumberValidForType(snm::Bytes bytes, snm::TypeModifier type_modifier);
+    static bool IsValidChar(std::string_view token);
     /**
      * @brief Преобразует числовую строку в представление в байтах.
      *
-     * Метод принимает строку, представляющую число в разных форматах (двоичный, шестнадцатеричный или десятичный),
-     * производит ее валидацию, преобразует в число заданного типа и возвращает результат в виде массива байтов.
+     * Поддерживаются двоичные (префикс "0b", до 32 цифр), шестнадцатеричные (префикс "0x", до 8 цифр),
+     * целые и дробные десятичные числа с необязательным знаком '-'. Дробное число для модификатора,
+     * отличного от R, усекается до целой части. Целые числа приводятся к unsigned long с переполнением,
+     * как при std::stoul.
      *
-     * @param str Строка, содержащая числовое значение (может быть представлена в формате "0b" для двоичного числа,
-     * "0x" для шестнадцатеричного числа, или как обычное десятичное число).
-     * @param type_modifier Модификатор типа, определяющий формат числа. Например, используется для указания,
-     * является ли число с плавающей запятой, если требуется.
-     * @return snm::Bytes Результат преобразования числа в виде массива байтов.
-     * @throws std::invalid_argument Если строка содержит некорректное или слишком длинное число.
+     * @param str Строка, содержащая числовое значение.
+     * @param type_modifier Модификатор типа, определяющий, разбирается ли десятичное число как число с плавающей запятой.
+     * @return Результат преобразования числа в виде массива байтов или std::nullopt, если строка не является
+     * допустимым числом или значение не помещается в тип.
      */
-    snm::Bytes ParseNumber(const std::string& str, const snm::TypeModifier& type_modifier);
+    static std::optional<snm::Bytes> ParseNumber(std::string_view str, snm::TypeModifier type_modifier);
     /**
-     * @brief Считывает и обрабатывает строку из входного потока, удаляя комментарии и лишние пробелы.
+     * @brief Находит в исходном коде следующую строку, содержащую инструкцию.
      *
-     * Метод извлекает строку из переданного потока, увеличивает счётчик строк,
-     * удаляет комментарии и внешние пробелы. Если строка не пустая после обработки, она возвращается.
+     * Метод увеличивает счётчик строк для каждой прочитанной строки, удаляет комментарии и внешние пробелы.
      *
-     * @param stream Входной поток, содержащий строки данных для обработки.
-     * @return Обработанная строка без комментариев и лишних пробелов. Если строка пуста после обработки,
-     * метод продолжает чтение, пока не найдет непустую строку или поток не закончится.
+     * @param source Непрочитанная часть исходного кода. Сдвигается за конец возвращённой строки.
+     * @return Строка без комментария и внешних пробелов. Пустая строка означает конец исходного кода.
      */
-    std::string GetLine(std::istringstream& stream);
+    std::string_view GetLine(std::string_view& source);
     /**
      * @brief Преобразует строку текста в объект Instruction, содержащий данные об инструкции.
      *
@@ -201,70 +209,51 @@ private:
      *
      * @param line Строка, содержащая текстовую инструкцию для разбора.
      * @return Объект Instruction, содержащий все данные, связанные с данной инструкцией.
+     * Имя метки инструкции приводится к верхнему регистру.
      * @throws std::runtime_error Если строка имеет некорректный формат или содержит
      * невалидные элементы.
      */
-    Instruction GetInstruction(const std::string& line);
+    Instruction GetInstruction(std::string_view line);
     /**
-     * @brief Разбирает модификаторы инструкции из входного потока.
+     * @brief Разбирает модификаторы инструкции.
      *
-     * Метод анализирует входной поток, определяет и назначает типовые и аргументные
-     * модификаторы для заданной инструкции. При необходимости использует значения
-     * по умолчанию для модификаторов типа. В случае недопустимости указанного
-     * модификатора выбрасывается исключение.
+     * Метод определяет и назначает типовые и аргументные модификаторы для заданной инструкции.
+     * При необходимости использует значения по умолчанию для модификаторов типа. В случае
+     * недопустимости указанного модификатора выбрасывается исключение.
      *
-     * @param stream Входной поток, содержащий текстовые представления модификаторов.
+     * @param tokens Токены строки, начиная с возможного модификатора типа.
      * @param instr Инструкция, для которой будут назначены модификаторы.
      */
-    void ParseModifiers(std::istringstream& stream, Instruction& instr);
+    void ParseModifiers(Tokenizer& tokens, Instruction& instr);
     /**
-     * @brief Парсит аргумент инструкции из входящего потока и обновляет указанный объект инструкции.
+     * @brief Разбирает аргумент инструкции и обновляет указанный объект инструкции.
      *
-     * Метод обрабатывает входной поток, извлекает следующий токен, проверяет его корректность
-     * как имени ярлыка, символа или числа, и обновляет поля объекта инструкции в соответствии
-     * с результатами.
+     * Метод извлекает следующий токен, проверяет его корректность как имени ярлыка, символа или числа,
+     * и обновляет поля объекта инструкции в соответствии с результатами. Если токен не является аргументом,
+     * он остаётся непрочитанным.
      *
-     * @param stream входной поток, содержащий строковое представление инструкций для парсинга.
+     * @param tokens Токены строки, начиная с возможного аргумента.
      * @param instr объект инструкции, который будет обновлен в зависимости от результата обработки.
      */
-    void ParseArgument(std::istringstream& stream, Instruction& instr);
+    static void ParseArgument(Tokenizer& tokens, Instruction& instr);
     /**
-     * @brief Проверяет, является ли указанный токен модификатором аргумента.
-     *
-     * Метод определяет, представляет ли строковый токен модификатор аргумента,
-     * используя внутреннее сопоставление ключей и преобразование текста в верхний регистр.
-     *
-     * @param token Строка, содержащая токен, который может быть модификатором аргумента.
-     * @return true, если токен является модификатором аргумента, иначе false.
+     * @brief Находит команду по имени без учёта регистра.
+     * @param token Имя команды.
+     * @return Код операции или std::nullopt, если команды с таким именем нет.
      */
-    [[nodiscard]] bool IsArgumentModifier(std::string& token) const;
+    [[nodiscard]] std::optional<snm::OpCode> FindOpCode(std::string_view token) const;
     /**
-     * @brief Проверяет, является ли переданный токен модификатором типа.
-     *
-     * Метод осуществляет проверку, содержится ли переданный токен в карте модификаторов типов.
-     * Токен предварительно преобразуется к верхнему регистру перед проверкой.
-     *
-     * @param token Ссылка на строку, представляющую токен для проверки.
-     * @return Возвращает true, если токен является модификатором типа, иначе false.
+     * @brief Находит модификатор типа по имени без учёта регистра.
+     * @param token Имя модификатора.
+     * @return Модификатор типа или std::nullopt, если токен не является модификатором типа.
      */
-    [[nodiscard]] bool IsTypeModifier(std::string& token) const;
+    static std::optional<snm::TypeModifier> FindTypeModifier(std::string_view token);
     /**
-     * @brief Валидирует строку, представляющую число в различных форматах.
-     *
-     * Метод проверяет строку на соответствие одному из поддерживаемых форматов чисел:
-     * двоичный, шестнадцатеричный, с плавающей точкой и целое число. Если строка
-     * не соответствует ни одному из форматов, выбрасывается исключение с описанием
-     * причины недопустимости строки.
-     *
-     * @param str Строка, представляющая число, подлежащее проверке.
-     *            Формат может быть: двоичным (с префиксом "0b"),
-     *            шестнадцатеричным (с префиксом "0x"),
-     *            с плавающей точкой (содержит один символ '.'),
-     *            либо целым числом.
-     *
-     * @throws std::invalid_argument Если строка не соответствует ни одному из поддерживаемых форматов чисел.
+     * @brief Находит модификатор аргумента по его обозначению.
+     * @param token Обозначение модификатора ("&" или "&&").
+     * @return Модификатор аргумента или std::nullopt, если токен не является модификатором аргумента.
      */
-    void ValidateStringNumber(const std::string& str);
+    static std::optional<snm::ArgModifier> FindArgModifier(std::string_view token);
     /**
      * @brief Удаляет комментарий из строки кода.
      *
@@ -275,29 +264,32 @@ private:
      * @return Строка без части, содержащей комментарий, или исходная строка,
      *         если комментария нет.
      */
-    static std::string RemoveComment(const std::string& line);
+    static std::string_view RemoveComment(std::string_view line);
     /**
-     * @brief Преобразует все символы строки в верхний регистр.
-     *
-     * Метод выполняет преобразование всех символов в переданной строке в их
-     * заглавный эквивалент.
-     *
-     * @param str Ссылка на строку, которую необходимо преобразовать в верхний регистр.
-     * @return Преобразованная строка, где все символы приведены к верхнему регистру.
+     * @brief Возвращает копию строки, все символы которой приведены к верхнему регистру.
+     * @param str Исходная строка.
+     * @return Строка в верхнем регистре.
      */
-    static std::string ToUpper(std::string& str);
+    static std::string ToUpper(std::string_view str);
+    /**
+     * @brief Сравнивает строку с ключевым словом в верхнем регистре без учёта регистра строки.
+     * @param str Сравниваемая строка.
+     * @param keyword Ключевое слово в верхнем регистре.
+     * @return true, если строки совпадают без учёта регистра.
+     */
+    static bool EqualsIgnoreCase(std::string_view str, std::string_view keyword);
     /**
      * @brief Компилирует исходный код в байт-код и создает карту соответствий между строками исходного кода и байт-кодом.
      *
      * Метод парсит переданный исходный код, преобразует его в машину байт-кода, обрабатывает метки,
-     * и возвращает пару, состоящую из скомпилированного байт-кода и карты соответствий строк исходного
+     * и возвращает скомпилированный байт-код, адреса меток и карту соответствий строк исходного
      * кода к байт-кодам.
      *
      * @param source Строка, представляющая исходный код программы, который нужно скомпилировать.
-     * @return Пара, содержащая скомпилированный байт-код и карту сопоставлений строк исходного кода с байт-кодом.
+     * @return Скомпилированная программа с таблицей меток и картой сопоставлений строк исходного кода с байт-кодом.
      * @throw std::runtime_error В случае наличия ошибок в процессе парсинга исходного кода.
      */
-    std::pair<snm::ByteCode, snm::SourceToBytecodeMap> CompileInternal(const std::string& source);
+    Program CompileInternal(const std::string& source);
     /**
      * @brief Парсит исходный код ассемблера и преобразует его в список инструкций.
      *
@@ -310,11 +302,9 @@ private:
      *         - отображение адресов меток (std::unordered_map<std::string, uint32_t>),
      *         - список ошибок (std::vector<std::string>).
      */
-    std::tuple<std::vector<Instruction>, std::unordered_map<std::string, snm::Address>, std::vector<std::string>>
+    std::tuple<std::vector<Instruction>, snm::LabelMap, std::vector<std::string>>
     ParseSource(
         const std::string& source);
 };
 
-
-
 #endif
@@ -0,0 +1,72 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/processor.hpp"
+
+/**
+ * @struct BatchResult
+ * @brief Результат исполнения программы на одном наборе входных данных.
+ */
+struct BatchResult {
+    std::string output; ///< Вывод программы в формате StreamIo
+    Registers registers; ///< Регистры после завершения
+    uint64_t instruction_count = 0; ///< Количество выполненных инструкций
+    std::string error; ///< Сообщение об ошибке исполнения. Пусто, если программа завершилась без ошибок.
+};
+
+/**
+ * @class BatchRunner
+ * @brief Параллельное исполнение одной программы на множестве наборов входных данных.
+ *
+ * Байт-код один раз разбирается в ProgramImage, который разделяется памятью всех потоков. Каждый поток хранит
+ * только скопированные при записи страницы и перед каждым заданием возвращает их к образу через
+ * MemoryManager::ResetData(). Задания изначально делятся между потоками поровну. Поток, исчерпавший свою
+ * очередь, забирает задания с конца очереди другого потока, поэтому различия во времени исполнения заданий
+ * не приводят к простою.
+ *
+ * Ввод и вывод каждого задания выполняются через StreamIo: значения во входной строке разделяются
+ * пробельными символами. Ошибки исполнения, включая исчерпание ввода, сохраняются в результате задания
+ * и не прерывают остальные задания.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief Конструктор класса BatchRunner.
+     * @param thread_count Количество потоков. При нуле используется количество аппаратных потоков.
+     */
+    explicit BatchRunner(size_t thread_count = 0);
+
+    /**
+     * @brief Устанавливает режим исполнения инструкций.
+     * @param mode Режим исполнения.
+     */
+    void SetExecutionMode(snm::ExecutionMode mode);
+
+    /**
+     * @brief Возвращает количество потоков, используемых для исполнения.
+     */
+    [[nodiscard]] size_t GetThreadCount() const;
+
+    /**
+     * @brief Исполняет программу на каждом наборе входных данных.
+     *
+     * Метод блокирует вызывающий поток до завершения всех заданий.
+     *
+     * @param byte_code Байт-код программы.
+     * @param inputs Входные данные заданий.
+     * @return Результаты заданий в порядке входных данных.
+     * @throws std::invalid_argument Если байт-код не может быть загружен.
+     */
+    [[nodiscard]] std::vector<BatchResult> Run(std::span<const snm::Byte> byte_code,
+                                               const std::vector<std::string>& inputs) const;
+
+private:
+    size_t thread_count_; ///< Количество потоков
+    snm::ExecutionMode execution_mode_ = snm::ExecutionMode::THREADED; ///< Режим исполнения инструкций
+};
+
+#endif
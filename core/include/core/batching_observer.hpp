@@ -0,0 +1,134 @@
+#ifndef BATCHING_OBSERVER_HPP
+#define BATCHING_OBSERVER_HPP
+
+#include <bitset>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include "core/processor.hpp"
+#include "core/processor_observer.hpp"
+
+/**
+ * @struct ProcessorChanges
+ * @brief Накопленные изменения состояния процессора, доставляемые одним пакетом.
+ *
+ * Флаги показывают, какие регистры изменялись с момента предыдущего пакета, а в registers
+ * находятся их последние значения. Адреса изменённых ячеек памяти не повторяются и упорядочены по возрастанию.
+ */
+struct ProcessorChanges {
+    bool accumulator = false; ///< Изменялся аккумулятор
+    bool auxiliary = false; ///< Изменялся вспомогательный регистр
+    bool instruction_pointer = false; ///< Изменялся указатель инструкций
+    Registers registers{}; ///< Последние известные значения регистров
+    std::optional<snm::ProcessorState> state; ///< Новое состояние процессора, если оно изменилось
+    std::vector<snm::Address> memory; ///< Адреса изменённых ячеек памяти
+    uint64_t instructions = 0; ///< Количество изменений IP, вошедших в пакет
+
+    /**
+     * @brief Проверяет, содержит ли пакет хотя бы одно изменение.
+     * @return true, если изменений нет.
+     */
+    [[nodiscard]] bool Empty() const {
+        return !accumulator && !auxiliary && !instruction_pointer && !state && memory.empty() && instructions == 0;
+    }
+};
+
+/**
+ * @class ProcessorChangesObserver
+ * @brief Интерфейс получателя пакетов изменений от BatchingObserver.
+ */
+class ProcessorChangesObserver {
+public:
+    /**
+     * @brief Вызывается при каждом изменении указателя инструкций, без накопления.
+     *
+     * Предназначен для точной проверки точек останова и должен выполняться быстро.
+     *
+     * @param instruction_pointer Новое значение указателя инструкций.
+     */
+    virtual void OnInstructionPointerChanged(const snm::Address& /*instruction_pointer*/) {
+    }
+
+    /**
+     * @brief Вызывается с накопленным пакетом изменений.
+     * @param changes Изменения с момента предыдущего пакета.
+     */
+    virtual void OnChanges(const ProcessorChanges& changes) = 0;
+
+    virtual ~ProcessorChangesObserver() = default;
+};
+
+/**
+ * @class BatchingObserver
+ * @brief Наблюдатель, объединяющий уведомления процессора в пакеты.
+ *
+ * Уведомления об изменении регистров и памяти накапливаются и передаются получателю одним пакетом
+ * не чаще заданного интервала и/или после заданного количества изменений IP. Изменение состояния процессора
+ * доставляется сразу вместе со всем накопленным. Каждое изменение IP дополнительно передаётся получателю
+ * немедленно через ProcessorChangesObserver::OnInstructionPointerChanged.
+ *
+ * Методы вызываются из потока, исполняющего процессор. Flush() из другого потока допустим только при остановленном процессоре.
+ */
+class BatchingObserver final : public ProcessorObserver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Конструктор класса BatchingObserver.
+     * @param target Получатель пакетов изменений.
+     * @param interval Минимальный интервал между пакетами. Нулевой интервал отключает ограничение по времени.
+     * @param instruction_limit Количество изменений IP, после которого пакет передаётся независимо от интервала.
+     * Ноль отключает ограничение по количеству.
+     */
+    explicit BatchingObserver(ProcessorChangesObserver& target,
+                              Clock::duration interval = std::chrono::microseconds(1000000 / 60),
+                              uint64_t instruction_limit = 0);
+
+    /**
+     * @brief Устанавливает минимальный интервал между пакетами.
+     * @param interval Интервал. Нулевое значение отключает ограничение по времени.
+     */
+    void SetInterval(Clock::duration interval);
+    /**
+     * @brief Устанавливает количество изменений IP, после которого пакет передаётся независимо от интервала.
+     * @param instruction_limit Количество изменений IP. Ноль отключает ограничение.
+     */
+    void SetInstructionLimit(uint64_t instruction_limit);
+    /**
+     * @brief Немедленно передаёт получателю накопленные изменения, если они есть.
+     */
+    void Flush();
+    /**
+     * @brief Отбрасывает накопленные изменения без передачи.
+     */
+    void Discard();
+
+    void OnRegisterIpChanged(const snm::Address& instruction_pointer) override;
+    void OnRegisterAccChanged(const snm::Bytes& accumulator) override;
+    void OnRegisterAuxChanged(const snm::Bytes& auxiliary) override;
+    void OnMemoryChanged(const snm::Address& address) override;
+    void OnStateChanged(const snm::ProcessorState& state) override;
+
+private:
+    /**
+     * @brief Через сколько изменений IP проверяется истечение интервала.
+     *
+     * Время не запрашивается на каждой инструкции, так как это дороже самой инструкции.
+     */
+    static constexpr uint64_t CLOCK_CHECK_PERIOD = 256;
+
+    ProcessorChangesObserver& target_; ///< Получатель пакетов
+    Clock::duration interval_; ///< Минимальный интервал между пакетами
+    uint64_t instruction_limit_; ///< Количество изменений IP в пакете, при достижении которого он передаётся
+    Clock::time_point last_flush_; ///< Время передачи предыдущего пакета
+    ProcessorChanges changes_; ///< Накапливаемый пакет
+    std::bitset<snm::CODE_MEMORY_SIZE> dirty_memory_; ///< Признаки ячеек, уже вошедших в пакет
+
+    /**
+     * @brief Передаёт пакет, если достигнуто ограничение по количеству изменений IP или истёк интервал.
+     */
+    void FlushIfDue();
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <limits>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -64,7 +65,46 @@ namespace snm {
         STOPPED, ///< Остановлен. Процессор не был запущен или был остановлен.
         RUNNING, ///< Выполняется.
         PAUSED_BY_IO, ///< Приостановлен. Процессор работает, но не может выполняться ни одна инструкция, ожидает завершения ввода извне.
-        PAUSED ///< Приостановлен
+        PAUSED, ///< Приостановлен
+        BREAKPOINT ///< Приостановлен на точке останова. Выполнение продолжается повторным запуском с текущего IP.
+    };
+
+    /**
+     * @enum StopReason
+     * @brief Перечисление причин возврата управления из Processor::RunFor() и Processor::Resume().
+     */
+    enum class StopReason {
+        HALTED, ///< Программа завершилась или процессор остановлен вызовом Stop().
+        BUDGET_EXHAUSTED, ///< Выполнено заданное количество инструкций. Процессор приостановлен.
+        INPUT_NEEDED, ///< Программа ожидает ввода, значение ещё не поступило.
+        BREAKPOINT, ///< Достигнута точка останова.
+        EXECUTION_ERROR ///< Ошибка исполнения инструкции. Процессор остановлен.
+    };
+
+    /**
+     * @enum ExecutionMode
+     * @brief Перечисление режимов исполнения инструкций процессором.
+     */
+    enum class ExecutionMode {
+        REFERENCE, ///< Эталонный интерпретатор: каждая инструкция читается, декодируется и вызывается через таблицу обработчиков.
+        THREADED, ///< Программа декодируется один раз в таблицу специализированных обработчиков, которые вызываются напрямую.
+        FUSED, ///< Как THREADED, дополнительно типовые последовательности инструкций исполняются одним обработчиком (см. Fusion).
+        JIT ///< Участки программы транслируются в машинный код x86-64 (см. JitCompiler). На других платформах, а также с наблюдателем, профилировщиком или точками останова исполняется как FUSED.
+    };
+
+    /**
+     * @enum Fusion
+     * @brief Перечисление типовых последовательностей инструкций, которые в режиме ExecutionMode::FUSED
+     * исполняются одной слитой операцией.
+     *
+     * Все последовательности начинаются с LOAD. Типы LOAD и второй инструкции совпадают либо являются
+     * сочетанием W и SW.
+     */
+    enum class Fusion {
+        INCREMENT, ///< `Load & x`, `Add a` или `Sub a`, `Store x`: изменение переменной на величину
+        LOOP_TEST, ///< `Load & x`, `SkipLo a`, `SkipGt a` или `SkipEq a`, `Jump L`: проверка условия цикла
+        CALL, ///< `Load a`, `JnS f`: вызов подпрограммы с аргументом в аккумуляторе
+        RETURN ///< `Load a`, `Jump & f`: возврат из подпрограммы со значением в аккумуляторе
     };
 
     using Byte = unsigned char;
@@ -76,11 +116,19 @@ namespace snm {
 
     static constexpr size_t ARGUMENT_SIZE = sizeof(Word);
     static constexpr size_t CODE_MEMORY_SIZE = std::numeric_limits<Address>::max() + 1;
+    /**
+     * @brief Код операции, которым заполнены ячейки памяти за пределами программы.
+     *
+     * Соответствует HALT с нулевыми модификаторами, который ассемблер не формирует. При исполнении
+     * останавливает процессор без ошибки и не учитывается как выполненная инструкция.
+     */
+    static constexpr Byte END_OF_CODE = 0b11110000;
 
     using Bytes = Bytes<ARGUMENT_SIZE>;
     using ByteCode = std::vector<Byte>;
     using SourceToBytecodeMap = std::unordered_map<unsigned int, Address>;
     using BytecodeToSourceMap = std::unordered_map<Address, unsigned int>;
+    using LabelMap = std::unordered_map<std::string, Address>;
 
     /**
      * @struct OpCodeProperties
@@ -299,6 +347,25 @@ namespace snm {
                static_cast<uint8_t>(static_cast<uint8_t>(type_modifier) << 2) |
                static_cast<uint8_t>(argument_modifier);
     }
+
+    /**
+     * @brief Проверяет, определена ли в наборе команд комбинация команды и модификатора типа.
+     *
+     * Соответствует набору обработчиков эталонного интерпретатора Processor. HALT определён только кодом 0xFF,
+     * который проверяется отдельно. Используется предварительно декодированным кодом и AotTranslator.
+     */
+    constexpr bool IsInstructionDefined(const OpCode opcode, const TypeModifier type_modifier) {
+        switch (opcode) {
+        case OpCode::STORE:
+        case OpCode::JUMP:
+        case OpCode::JUMPNSTORE:
+            return type_modifier == TypeModifier::W;
+        case OpCode::HALT:
+            return false;
+        default:
+            return true;
+        }
+    }
 }
 
 #endif
@@ -0,0 +1,158 @@
+#ifndef EXECUTION_HISTORY_HPP
+#define EXECUTION_HISTORY_HPP
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "core/common_definitions.hpp"
+#include "core/processor.hpp"
+
+/**
+ * @struct UndoRecord
+ * @brief Запись журнала отмены: состояние, которое изменила одна исполненная инструкция.
+ */
+struct UndoRecord {
+    Registers registers; ///< Регистры перед исполнением инструкции
+    snm::Bytes argument{}; ///< Аргумент ячейки перед записью, если инструкция записала память
+    snm::Address address = 0; ///< Адрес записанной ячейки
+    bool memory_written = false; ///< Инструкция записала аргумент ячейки (Store или JnS)
+};
+
+/**
+ * @class ExecutionHistory
+ * @brief Ограниченный журнал исполнения для обратного исполнения (Processor::StepBack(), ReverseContinue()).
+ *
+ * Заполняется процессором, которому журнал передан через Processor::SetHistory(). На каждую инструкцию
+ * приходится одна запись UndoRecord с регистрами до её исполнения и прежним значением записанной ячейки.
+ * Записи хранятся в кольцевом буфере ёмкостью GetCapacity(): при переполнении вытесняются самые старые.
+ * Каждые GetCheckpointInterval() инструкций сохраняется снимок процессора, поэтому возврат на много инструкций
+ * назад восстанавливает ближайший снимок и отменяет не более интервала записей. Снимки разделяют
+ * неизменённые страницы памяти (см. MemoryManager::TakeSnapshot()), а снимки старше самой старой записи
+ * удаляются, поэтому их не больше GetCapacity() / GetCheckpointInterval() + 1.
+ *
+ * Журнал непрерывен: если процессор исполняет инструкцию не с того счётчика, на котором журнал закончился,
+ * или коды операций памяти изменились, журнал начинается заново.
+ */
+class ExecutionHistory {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20; ///< Ёмкость по умолчанию, записей
+    static constexpr uint64_t DEFAULT_CHECKPOINT_INTERVAL = 1 << 14; ///< Интервал снимков по умолчанию, инструкций
+
+    /**
+     * @brief Конструктор класса ExecutionHistory.
+     * @param capacity Максимальное количество записей, то есть инструкций, на которые можно вернуться.
+     * @param checkpoint_interval Количество инструкций между снимками процессора.
+     * @throws std::invalid_argument Если ёмкость или интервал равны нулю.
+     */
+    explicit ExecutionHistory(size_t capacity = DEFAULT_CAPACITY,
+                              uint64_t checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL);
+
+    /**
+     * @brief Изменяет ёмкость журнала. Лишние старые записи и снимки удаляются.
+     * @throws std::invalid_argument Если ёмкость равна нулю.
+     */
+    void SetCapacity(size_t capacity);
+    [[nodiscard]] size_t GetCapacity() const;
+    [[nodiscard]] uint64_t GetCheckpointInterval() const;
+    /**
+     * @brief Возвращает количество записей.
+     */
+    [[nodiscard]] size_t Size() const;
+    /**
+     * @brief Возвращает количество сохранённых снимков.
+     */
+    [[nodiscard]] size_t GetCheckpointCount() const;
+    /**
+     * @brief Возвращает счётчик инструкций самого раннего состояния, на которое можно вернуться.
+     */
+    [[nodiscard]] uint64_t GetFirstInstructionCount() const;
+    /**
+     * @brief Возвращает счётчик инструкций после последней записи.
+     */
+    [[nodiscard]] uint64_t GetEndInstructionCount() const;
+    /**
+     * @brief Удаляет все записи и снимки.
+     */
+    void Clear();
+
+    /*
+     *  Операции, вызываемые процессором
+     */
+
+    /**
+     * @brief Проверяет, продолжает ли инструкция с заданного счётчика журнал без разрыва.
+     * @param instruction_count Счётчик инструкций перед исполнением инструкции.
+     * @param code_revision Ревизия кодов операций памяти.
+     */
+    [[nodiscard]] bool Continues(uint64_t instruction_count, size_t code_revision) const;
+    /**
+     * @brief Очищает журнал и начинает его с заданного счётчика.
+     */
+    void Start(uint64_t instruction_count, size_t code_revision);
+    /**
+     * @brief Проверяет, нужно ли сохранить снимок перед следующей записью.
+     */
+    [[nodiscard]] bool NeedsCheckpoint() const;
+    /**
+     * @brief Сохраняет снимок процессора, сделанный на счётчике GetEndInstructionCount().
+     */
+    void AddCheckpoint(std::shared_ptr<const ProcessorSnapshot> checkpoint);
+    /**
+     * @brief Добавляет запись об инструкции, которая исполняется с заданных регистров.
+     */
+    void Record(const Registers& registers);
+    /**
+     * @brief Сохраняет прежнее значение ячейки, записываемой инструкцией последней записи.
+     */
+    void RecordMemoryWrite(snm::Address address, snm::Bytes previous);
+    /**
+     * @brief Удаляет и возвращает последнюю запись.
+     *
+     * Вызывается только для непустого журнала.
+     */
+    UndoRecord PopBack();
+    /**
+     * @brief Отбрасывает записи после ближайшего снимка, сделанного не раньше заданного счётчика.
+     *
+     * @param instruction_count Счётчик, на который выполняется возврат.
+     * @return Снимок, от которого до заданного счётчика остаётся отменить записи журнала, или nullptr,
+     *         если такого снимка до конца журнала нет и журнал не изменён.
+     */
+    std::shared_ptr<const ProcessorSnapshot> RewindToCheckpoint(uint64_t instruction_count);
+    /**
+     * @brief Сообщает ревизию кодов операций после восстановления памяти из снимка журнала.
+     */
+    void UpdateCodeRevision(size_t code_revision);
+    /**
+     * @brief Находит последнюю запись, исполнявшую инструкцию по одному из адресов.
+     * @param addresses Адреса инструкций, например точки останова.
+     * @return Счётчик инструкций перед исполнением найденной записи.
+     */
+    [[nodiscard]] std::optional<uint64_t> FindLast(const std::bitset<snm::CODE_MEMORY_SIZE>& addresses) const;
+
+private:
+    std::vector<UndoRecord> records_; ///< Кольцевой буфер записей. Растёт до ёмкости по мере заполнения.
+    size_t capacity_; ///< Максимальное количество записей
+    size_t first_ = 0; ///< Индекс самой старой записи в records_
+    size_t size_ = 0; ///< Количество записей
+    uint64_t checkpoint_interval_; ///< Количество инструкций между снимками
+    std::deque<std::shared_ptr<const ProcessorSnapshot>> checkpoints_; ///< Снимки по возрастанию счётчика
+    uint64_t end_instruction_count_ = 0; ///< Счётчик инструкций после последней записи
+    size_t code_revision_ = 0; ///< Ревизия кодов операций, с которой ведётся журнал
+    bool started_ = false; ///< Журнал начат и может продолжаться
+
+    /**
+     * @brief Возвращает запись по номеру от самой старой.
+     */
+    [[nodiscard]] const UndoRecord& At(size_t index) const;
+    /**
+     * @brief Удаляет снимки вне диапазона от самой старой записи до конца журнала.
+     */
+    void DropCheckpoints();
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef INPUT_FEED_IO_HPP
+#define INPUT_FEED_IO_HPP
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "core/processor_io.hpp"
+
+/**
+ * @class InputFeedIo
+ * @brief Ввод-вывод процессора с заранее разобранными входными данными.
+ *
+ * Входные значения разбираются в snm::Bytes один раз при создании, поэтому запрос ввода обслуживается
+ * синхронно, без разбора строк, и процессор не переходит в состояние snm::ProcessorState::PAUSED_BY_IO.
+ * Значение, тип которого отличается от запрошенного, разбирается из записи по правилам
+ * VirtualMachine::BytesFromString, поэтому результат совпадает с вводом того же текста с консоли.
+ * Вывод, а также ввод после исчерпания данных передаются вложенному обработчику ввода-вывода.
+ */
+class InputFeedIo final : public ProcessorIo {
+public:
+    /**
+     * @struct Value
+     * @brief Входное значение, тип, в котором оно записано, и исходная запись.
+     */
+    struct Value {
+        snm::Type type; ///< Тип записи значения
+        snm::Bytes bytes; ///< Значение
+        std::string text; ///< Запись значения для запроса другого типа
+    };
+
+    /**
+     * @brief Конструктор класса InputFeedIo.
+     * @param input Входные значения в порядке ввода.
+     * @param io Обработчик вывода и ввода после исчерпания входных значений.
+     */
+    InputFeedIo(std::vector<Value> input, ProcessorIo& io);
+
+    /**
+     * @brief Разбирает входные значения из текста.
+     *
+     * Значения разделяются пробельными символами, текст от `#` до конца строки игнорируется. Запись с точкой
+     * или экспонентой разбирается как snm::Type::REAL, запись со знаком минус как snm::Type::SIGNED_WORD,
+     * остальные как snm::Type::WORD.
+     *
+     * @param input Поток с текстом входных значений.
+     * @return Входные значения в порядке записи.
+     * @throws std::runtime_error Если значение не удалось разобрать.
+     */
+    [[nodiscard]] static std::vector<Value> Parse(std::istream& input);
+
+    /**
+     * @brief Передаёт процессору очередное входное значение.
+     *
+     * Ответ передаётся синхронно, до возврата из метода. После исчерпания входных значений запрос
+     * передаётся вложенному обработчику.
+     *
+     * @throws std::runtime_error Если запись значения не представима в запрошенном типе.
+     */
+    void InputRequest(snm::Type type, InputCallback callback) override;
+    void OutputRequest(snm::Bytes bytes, snm::Type type) override;
+
+    /**
+     * @brief Возвращает ввод к первому значению.
+     */
+    void Rewind();
+    /**
+     * @brief Возвращает количество ещё не введённых значений.
+     */
+    [[nodiscard]] size_t GetRemaining() const;
+
+private:
+    std::vector<Value> input_; ///< Входные значения
+    size_t next_ = 0; ///< Индекс следующего вводимого значения
+    ProcessorIo& io_; ///< Обработчик вывода и ввода после исчерпания значений
+
+    /**
+     * @brief Приводит значение к запрошенному типу.
+     * @throws std::runtime_error Если запись значения не представима в запрошенном типе.
+     */
+    static snm::Bytes Convert(const Value& value, snm::Type type);
+};
+
+#endif
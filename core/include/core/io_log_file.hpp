@@ -0,0 +1,85 @@
+#ifndef IO_LOG_FILE_HPP
+#define IO_LOG_FILE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * @struct IoEvent
+ * @brief Записанный обмен процессора с обработчиком ввода-вывода.
+ */
+struct IoEvent {
+    /**
+     * @enum Kind
+     * @brief Направление обмена.
+     */
+    enum class Kind : uint8_t {
+        INPUT, ///< Значение, переданное процессору в ответ на запрос ввода
+        OUTPUT ///< Значение, выведенное процессором
+    };
+
+    Kind kind; ///< Направление обмена
+    snm::Type type; ///< Тип запрошенного или выведенного значения
+    snm::Bytes bytes; ///< Значение
+    uint64_t instruction_count; ///< Счётчик инструкций при запросе, включая инструкцию ввода или вывода
+};
+
+/**
+ * @class IoLogFile
+ * @brief Двоичный формат записи ввода-вывода (.snmr), сделанной RecordingIo и воспроизводимой ReplayIo.
+ *
+ * Все числа записываются в порядке little-endian:
+ *
+ * | Смещение | Размер | Содержимое                                                      |
+ * |----------|--------|-----------------------------------------------------------------|
+ * | 0        | 4      | Сигнатура "SNMR"                                                |
+ * | 4        | 2      | Версия формата                                                  |
+ * | 6        | 2      | Зарезервировано, 0                                              |
+ * | 8        | 4      | Количество событий N                                            |
+ * | 12       |        | N событий в порядке обмена                                      |
+ *
+ * Событие начинается байтом, в котором старший бит равен 1 для вывода и 0 для ввода, а два младших бита
+ * содержат snm::Type. Далее следуют значение (4 байта, в порядке snm::Bytes) и приращение счётчика
+ * инструкций относительно предыдущего события в формате unsigned LEB128, поэтому событие обычно занимает
+ * 6–8 байт.
+ */
+class IoLogFile {
+public:
+    static constexpr std::string_view EXTENSION = ".snmr"; ///< Расширение файлов записи ввода-вывода
+    static constexpr uint16_t VERSION = 1; ///< Версия формата, записываемая в файл
+
+    /**
+     * @brief Формирует содержимое файла записи.
+     * @param events События в порядке обмена. Счётчики инструкций не убывают.
+     * @return Содержимое файла.
+     * @throws std::invalid_argument Если счётчик инструкций события меньше счётчика предыдущего события.
+     */
+    static snm::ByteCode Serialize(std::span<const IoEvent> events);
+    /**
+     * @brief Восстанавливает события из содержимого файла.
+     * @param data Содержимое файла.
+     * @return События в порядке обмена.
+     * @throws std::invalid_argument Если данные не являются записью ввода-вывода, имеют неподдерживаемую
+     *                               версию или повреждены.
+     */
+    static std::vector<IoEvent> Deserialize(std::span<const snm::Byte> data);
+    /**
+     * @brief Записывает события в файл.
+     * @throws std::runtime_error Если файл не удалось записать.
+     */
+    static void Write(const std::string& path, std::span<const IoEvent> events);
+    /**
+     * @brief Читает события из файла.
+     * @throws std::runtime_error Если файл не удалось открыть.
+     * @throws std::invalid_argument Если файл не является записью ввода-вывода, имеет неподдерживаемую версию
+     *                               или повреждён.
+     */
+    static std::vector<IoEvent> Read(const std::string& path);
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef JIT_COMPILER_HPP
+#define JIT_COMPILER_HPP
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "core/common_definitions.hpp"
+#include "core/memory_manager.hpp"
+
+struct Registers;
+
+/**
+ * @class JitCompiler
+ * @brief Транслятор участков программы в машинный код x86-64 для режима snm::ExecutionMode::JIT.
+ *
+ * Участок — непрерывный диапазон не более MAX_BLOCK_LENGTH инструкций, который начинается с адреса входа
+ * и заканчивается перед первой инструкцией, не поддерживаемой транслятором: DIV, MOD, ввод-вывод, HALT,
+ * неопределённые коды операций и snm::END_OF_CODE. Такие инструкции исполняет цикл процессора. Переходы
+ * и пропуски на адреса внутри участка выполняются в машинном коде, остальные возвращают управление циклу
+ * процессора с новым значением IP. На каждом переходе назад машинный код проверяет бюджет инструкций,
+ * запрос остановки и запрос снимка.
+ *
+ * Аргументы, совпадающие с исходными значениями образа, встраиваются в машинный код как константы,
+ * а их ячейки отмечаются через MemoryManager::WatchArgument(). Запись в такую ячейку командами Store и JnS,
+ * в том числе выполненная в другом режиме исполнения, снимает все участки, которые её содержат; если запись
+ * выполнена машинным кодом, участок завершается сразу после неё. Записанная ячейка больше не встраивается,
+ * и её аргумент читается из памяти при исполнении. Изменённые аргументы не встраиваются вовсе, поэтому
+ * MemoryManager::ResetData() не делает машинный код устаревшим. После записи инструкций (изменения ревизии
+ * кодов операций) все участки транслируются заново.
+ *
+ * Трансляция выполняется только на Linux x86-64 (см. IsSupported()). Если исполняемую память выделить
+ * не удалось, GetBlock() не возвращает участков и программа исполняется циклом процессора.
+ */
+class JitCompiler {
+public:
+    static constexpr size_t MAX_BLOCK_LENGTH = 256; ///< Максимальное количество инструкций участка
+
+    /**
+     * @struct Block
+     * @brief Оттранслированный участок программы.
+     */
+    struct Block {
+        using Entry = void (*)(void* frame);
+
+        Entry entry = nullptr; ///< Машинный код участка. nullptr, если участок не оттранслирован.
+        uint32_t length = 0; ///< Количество инструкций участка
+        bool rejected = false; ///< Признак инструкции, с которой участок не может начинаться
+    };
+
+    /**
+     * @brief Конструктор класса JitCompiler.
+     * @param memory Память исполняемой программы.
+     * @param stop_requested Флаг запроса остановки, проверяемый на переходах назад.
+     * @param snapshot_requested Флаг запроса снимка, проверяемый на переходах назад.
+     */
+    JitCompiler(MemoryManager& memory, const std::atomic<bool>& stop_requested,
+                const std::atomic<bool>& snapshot_requested);
+    ~JitCompiler();
+
+    JitCompiler(const JitCompiler&) = delete;
+    JitCompiler& operator=(const JitCompiler&) = delete;
+
+    /**
+     * @brief Проверяет, поддерживается ли трансляция на текущей платформе.
+     */
+    [[nodiscard]] static bool IsSupported();
+
+    /**
+     * @brief Возвращает участок, начинающийся с адреса, и при первом обращении транслирует его.
+     *
+     * Перед поиском снимает участки, устаревшие из-за записи отмеченных ячеек или инструкций.
+     *
+     * @param address Адрес входа.
+     * @return Участок или nullptr, если инструкция по адресу не транслируется.
+     */
+    [[nodiscard]] const Block* GetBlock(snm::Address address);
+    /**
+     * @brief Исполняет участок с текущими значениями регистров.
+     *
+     * Исполнение завершается при выходе за пределы участка, после записи в отмеченную ячейку, а на переходе
+     * назад также при запросе остановки или снимка и при приближении к бюджету.
+     *
+     * @param block Участок, полученный от GetBlock() после последнего изменения памяти.
+     * @param registers Регистры процессора. Изменяются по результатам исполнения.
+     * @param budget Максимальное количество инструкций. Не меньше длины участка.
+     * @return Количество выполненных инструкций.
+     */
+    uint64_t Execute(const Block& block, Registers& registers, uint64_t budget);
+
+    /**
+     * @brief Возвращает количество оттранслированных участков с момента создания.
+     */
+    [[nodiscard]] size_t GetTranslationCount() const;
+    /**
+     * @brief Возвращает количество участков, снятых из-за записи встроенных аргументов.
+     */
+    [[nodiscard]] size_t GetInvalidationCount() const;
+
+private:
+    /**
+     * @brief Состояние, передаваемое машинному коду участка. Определено в единице трансляции.
+     */
+    struct Frame;
+
+    MemoryManager& memory_; ///< Память исполняемой программы
+    const std::atomic<bool>& stop_requested_; ///< Флаг запроса остановки процессора
+    const std::atomic<bool>& snapshot_requested_; ///< Флаг запроса снимка процессора
+    std::vector<Block> blocks_; ///< Участки. Индекс соответствует адресу входа.
+    std::bitset<snm::CODE_MEMORY_SIZE> written_; ///< Ячейки, встроенные аргументы которых были перезаписаны
+    size_t code_revision_; ///< Ревизия кодов операций, по которой оттранслированы участки
+    uint8_t* code_ = nullptr; ///< Исполняемая память участков. nullptr, если выделить её не удалось.
+    size_t code_used_ = 0; ///< Занятая часть исполняемой памяти
+    size_t translation_count_ = 0; ///< Количество трансляций
+    size_t invalidation_count_ = 0; ///< Количество снятых участков
+
+    /**
+     * @brief Снимает все участки и отметки ячеек и освобождает исполняемую память.
+     */
+    void Flush();
+    /**
+     * @brief Снимает участки, содержащие записанные отмеченные ячейки.
+     * @param addresses Адреса записанных ячеек.
+     */
+    void Invalidate(const std::vector<snm::Address>& addresses);
+    /**
+     * @brief Транслирует участок, начинающийся с адреса, и сохраняет его в blocks_.
+     * @param address Адрес входа.
+     */
+    void Translate(snm::Address address);
+    /**
+     * @brief Копирует машинный код в исполняемую память.
+     * @return Адрес скопированного кода или nullptr, если память исчерпана.
+     */
+    uint8_t* Install(const std::vector<uint8_t>& code);
+    /**
+     * @brief Записывает аргумент по запросу машинного кода.
+     *
+     * @param compiler Транслятор, которому принадлежит участок.
+     * @param value Записываемое значение.
+     * @param address Адрес ячейки. Усекается до snm::Address, как в обработчиках процессора.
+     * @return Ненулевое значение, если записана отмеченная ячейка и участок нужно завершить.
+     */
+    static uint32_t WriteArgument(JitCompiler* compiler, uint32_t value, uint32_t address) noexcept;
+};
+
+#endif
@@ -1,21 +1,101 @@
 #ifndef MEMORY_MANAGER_HPP
 #define MEMORY_MANAGER_HPP
 
+#include <array>
+#include <bitset>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <limits>
+#include <memory>
+#include <span>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "core/common_definitions.hpp"
+#include "core/program_image.hpp"
+
+/**
+ * @class MemorySnapshot
+ * @brief Неизменяемая копия памяти MemoryManager на момент создания.
+ *
+ * Страницы, не изменявшиеся после загрузки или сброса, берутся из разделяемого образа программы, а после
+ * MemoryManager::Restore() — из восстановленного снимка, поэтому копируются только собственные страницы
+ * менеджера. Снимок создаётся потоком, исполняющим программу, и после создания может читаться из любого потока.
+ */
+class MemorySnapshot {
+public:
+    MemorySnapshot(const MemorySnapshot&) = delete;
+    MemorySnapshot& operator=(const MemorySnapshot&) = delete;
+    MemorySnapshot(MemorySnapshot&&) noexcept = default;
+    MemorySnapshot& operator=(MemorySnapshot&&) noexcept = default;
+
+    /**
+     * @brief Читает инструкцию и её аргумент по указанному адресу.
+     */
+    [[nodiscard]] std::pair<snm::Byte, snm::Bytes> ReadInstruction(const snm::Address address) const {
+        const MemoryCell& cell = pages_[address / ProgramImage::PAGE_SIZE][address % ProgramImage::PAGE_SIZE];
+        return {cell.opcode, cell.argument};
+    }
+
+    /**
+     * @brief Читает аргумент по указанному адресу.
+     */
+    [[nodiscard]] snm::Bytes ReadArgument(const snm::Address address) const {
+        return pages_[address / ProgramImage::PAGE_SIZE][address % ProgramImage::PAGE_SIZE].argument;
+    }
+
+    /**
+     * @brief Возвращает образ программы, коды операций которого содержит снимок.
+     */
+    [[nodiscard]] const std::shared_ptr<const ProgramImage>& GetImage() const {
+        return image_;
+    }
+
+    /**
+     * @brief Возвращает адреса ячеек, аргументы которых отличаются от исходных значений образа, по возрастанию.
+     *
+     * Проверяются только страницы, скопированные из образа.
+     */
+    [[nodiscard]] std::vector<snm::Address> GetWrittenCells() const;
+    /**
+     * @brief Возвращает адреса ячеек, код операции или аргумент которых отличается в двух снимках, по возрастанию.
+     *
+     * Страницы, общие для обоих снимков, например страницы одного образа, не сравниваются, поэтому
+     * стоимость пропорциональна количеству страниц, изменённых хотя бы в одном из снимков.
+     *
+     * @param other Снимок для сравнения.
+     */
+    [[nodiscard]] std::vector<snm::Address> Diff(const MemorySnapshot& other) const;
+
+private:
+    friend class MemoryManager;
+
+    MemorySnapshot() = default;
+
+    std::shared_ptr<const ProgramImage> image_; ///< Образ, на страницы которого ссылается таблица страниц
+    std::shared_ptr<const MemorySnapshot> base_; ///< Восстановленный снимок, на страницы которого ссылается таблица
+    std::vector<ProgramImage::Page> copies_; ///< Копии собственных страниц менеджера
+    std::array<const MemoryCell*, ProgramImage::PAGE_COUNT> pages_{}; ///< Таблица страниц снимка
+};
 
 /**
  * @class MemoryManager
  * @brief Класс для управления памятью.
+ *
+ * Загруженная программа хранится в неизменяемом образе ProgramImage, который может разделяться между
+ * несколькими менеджерами. Чтение выполняется через таблицу страниц, покрывающую все адресное пространство
+ * snm::Address, поэтому чтение и запись по любому адресу не требуют проверки границ. При первой записи
+ * аргумента в страницу менеджер копирует её из образа (copy-on-write), поэтому собственная память менеджера
+ * пропорциональна количеству изменённых страниц, а не размеру программы. Ячейки за пределами программы
+ * содержат код операции snm::END_OF_CODE.
  */
 class MemoryManager {
 public:
-    MemoryManager() = default;
+    MemoryManager();
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
 
     /**
      * @brief Загружает байт-код в память менеджера.
@@ -27,12 +107,39 @@ public:
      * @throws std::invalid_argument Если размер байт-кода превышает максимально допустимый размер памяти или формат байт-кода некорректен.
      */
     void Load(const snm::ByteCode& byte_code);
+    /**
+     * @brief Загружает байт-код из непрерывной области памяти.
+     *
+     * Инструкции записываются в ячейки напрямую, без промежуточного копирования байт-кода. Используется
+     * для загрузки байт-кода из отображённого в память файла.
+     *
+     * @param byte_code Байт-код в том же формате, что и для Load(const snm::ByteCode&).
+     * @throws std::invalid_argument Если размер байт-кода превышает максимально допустимый размер памяти или формат байт-кода некорректен.
+     */
+    void Load(std::span<const snm::Byte> byte_code);
+    /**
+     * @brief Загружает готовый образ программы без копирования.
+     *
+     * Образ разделяется с другими менеджерами, загрузившими его. Изменения аргументов остаются в собственных
+     * страницах менеджера, а запись инструкций выполняется в копию образа.
+     *
+     * @param image Образ программы.
+     */
+    void Load(std::shared_ptr<const ProgramImage> image);
+
+    /**
+     * @brief Возвращает образ загруженной программы.
+     *
+     * Образ содержит исходные аргументы и не отражает изменения, внесённые WriteArgument().
+     */
+    [[nodiscard]] std::shared_ptr<const ProgramImage> GetImage() const;
 
     /**
      * @brief Записывает инструкцию в память по указанному адресу.
      *
      * Метод записывает код инструкции и соответствующий аргумент в структуру данных,
      * хранящую инструкции.
+     * Аргумент также становится исходным значением ячейки, которое восстанавливает ResetData().
      *
      * @param code Код инструкции, представленный в виде объекта snm::Byte.
      * @param argument Аргумент инструкции, представленный в виде контейнера snm::Bytes.
@@ -44,9 +151,11 @@ public:
      *
      * Метод добавляет код инструкции и связанный с ним аргумент в соответствующие структуры данных,
      * хранящие инструкции.
+     * Аргумент также становится исходным значением ячейки, которое восстанавливает ResetData().
      *
      * @param code Код инструкции, представленный в виде объекта snm::Byte.
      * @param argument Аргумент инструкции, представленный в виде контейнера snm::Bytes.
+     * @throws std::out_of_range Если программа уже занимает всю память.
      */
     void WriteInstruction(snm::Byte code, snm::Bytes argument);
     /**
@@ -57,42 +166,100 @@ public:
      * а второй элемент — это вектор байтов, представляющий аргументы команды.
      *
      * @param address Адрес в памяти, откуда требуется прочитать инструкцию и её аргументы.
-     *                Адрес должен быть допустимым и находиться в пределах доступного диапазона памяти.
      *
      * @return Пара, содержащая опкод команды и её аргументы. Первый элемент — это байт с опкодом,
-     *         второй элемент — вектор байтов, представляющий аргументы команды.
-     *
-     * @throws std::out_of_range Если адрес выходит за пределы доступной памяти или память пуста.
+     *         второй элемент — вектор байтов, представляющий аргументы команды. За пределами программы
+     *         опкод равен snm::END_OF_CODE.
      */
-    std::pair<snm::Byte, snm::Bytes> ReadInstruction(snm::Address address);
+    [[nodiscard]] std::pair<snm::Byte, snm::Bytes> ReadInstruction(const snm::Address address) const {
+        const MemoryCell& cell = pages_[address / PAGE_SIZE][address % PAGE_SIZE];
+        return {cell.opcode, cell.argument};
+    }
 
     /**
      * @brief Записывает данные аргумента в память по указанному адресу.
      *
-     * Метод проверяет, что адрес памяти допустим, и при необходимости расширяет структуру данных, хранящую аргументы.
-     * Затем сохраняет переданный аргумент по указанному адресу.
+     * Код операции в ячейке не меняется, поэтому запись за пределами программы не расширяет её.
+     * При первой записи в страницу после загрузки или сброса страница копируется из образа.
      *
      * @param argument Данные аргумента, представленные в виде контейнера snm::Bytes.
      * @param address Адрес памяти, в который записываются данные аргумента.
      */
-    void WriteArgument(snm::Bytes argument, snm::Address address);
+    void WriteArgument(const snm::Bytes argument, const snm::Address address) {
+        const size_t page = address / PAGE_SIZE;
+        if (!private_pages_[page]) [[unlikely]] {
+            CopyPage(page);
+        }
+        (*private_pages_[page])[address % PAGE_SIZE].argument = argument;
+
+        if (watched_.test(address)) [[unlikely]] {
+            watched_.reset(address);
+            watched_writes_.push_back(address);
+        }
+    }
     /**
      * @brief Читает аргумент из памяти по указанному адресу.
      *
-     * Проверяет доступность аргумента по заданному адресу и возвращает его,
-     * если адрес валиден. Если адрес выходит за пределы списка аргументов
-     * или список аргументов пуст, возвращается пустой результат.
+     * Ячейки, в которые ничего не записывалось, содержат нулевой аргумент.
      *
      * @param address Адрес, по которому необходимо прочитать аргумент.
-     * @return Аргумент, расположенный по указанному адресу, или пустой результат, если
-     *         адрес невалиден.
+     * @return Аргумент, расположенный по указанному адресу.
      */
-    [[nodiscard]] snm::Bytes ReadArgument(snm::Address address) const;
+    [[nodiscard]] snm::Bytes ReadArgument(const snm::Address address) const {
+        return pages_[address / PAGE_SIZE][address % PAGE_SIZE].argument;
+    }
+
+    /**
+     * @brief Возвращает таблицу страниц для чтения.
+     *
+     * Таблица содержит PAGE_COUNT указателей на страницы по ProgramImage::PAGE_SIZE ячеек. Адрес таблицы
+     * не изменяется за время жизни менеджера, а её элементы заменяются при копировании страниц, сбросе
+     * и загрузке, поэтому указатель на страницу нельзя сохранять между записями.
+     */
+    [[nodiscard]] const MemoryCell* const* GetPageTable() const {
+        return pages_.data();
+    }
+
+    /**
+     * @brief Восстанавливает коды операций и аргументы из снимка.
+     *
+     * Снимок не копируется: таблица страниц ссылается на его страницы, а страница копируется в собственную
+     * при первой записи, поэтому несколько менеджеров, восстановленных из одного снимка, исполняются
+     * независимо и занимают память только под изменённые страницы. ResetData() возвращает память
+     * к исходным аргументам образа, а не к снимку. Ревизия кодов операций увеличивается.
+     *
+     * @param snapshot Снимок. Удерживается менеджером до следующей загрузки, сброса или восстановления.
+     */
+    void Restore(std::shared_ptr<const MemorySnapshot> snapshot);
+
+    /**
+     * @brief Отмечает ячейку, запись аргумента которой через WriteArgument() должна быть зафиксирована.
+     *
+     * Используется JIT-компилятором для ячеек, аргументы которых встроены в машинный код. Отметка снимается
+     * первой записью, после чего адрес возвращается TakeWatchedWrites().
+     *
+     * @param address Адрес ячейки.
+     */
+    void WatchArgument(snm::Address address);
+    /**
+     * @brief Проверяет, были ли записаны аргументы отмеченных ячеек с последнего вызова TakeWatchedWrites().
+     */
+    [[nodiscard]] bool HasWatchedWrites() const {
+        return !watched_writes_.empty();
+    }
+    /**
+     * @brief Возвращает адреса отмеченных ячеек, аргументы которых были записаны, и очищает их список.
+     */
+    [[nodiscard]] std::vector<snm::Address> TakeWatchedWrites();
+    /**
+     * @brief Снимает все отметки и очищает список записанных отмеченных ячеек.
+     */
+    void ClearWatches();
 
     /**
      * @brief Сбрасывает состояние памяти менеджера.
      *
-     * Метод очищает внутренние структуры данных класса, включая списки инструкций и аргументов,
+     * Метод заполняет все ячейки кодом операции snm::END_OF_CODE и нулевыми аргументами,
      * возвращая память менеджера в изначальное пустое состояние.
      */
     void Reset();
@@ -100,7 +267,9 @@ public:
      * @brief Сбрасывает данные аргументов памяти на исходное состояние.
      *
      * Метод восстанавливает текущие данные аргументов до их оригинального состояния,
-     * используя сохранённую копию исходных данных, которая была получена после метода Load.
+     * возвращая изменённые страницы к страницам образа. Аргументы за пределами программы обнуляются.
+     * Восстановленный снимок освобождается.
+     * Освобождённые страницы сохраняются для повторного использования при следующих записях.
      */
     void ResetData();
     /**
@@ -108,11 +277,64 @@ public:
      * @return Размер в виде количества инструкций.
      */
     [[nodiscard]] size_t Size() const;
+    /**
+     * @brief Возвращает номер ревизии кодов операций.
+     *
+     * Значение увеличивается при каждом изменении кодов операций (Load, WriteInstruction, Reset, Restore).
+     * Запись аргументов ревизию не меняет. Используется для проверки актуальности
+     * предварительно декодированной программы.
+     *
+     * @return Номер текущей ревизии кодов операций.
+     */
+    [[nodiscard]] size_t CodeRevision() const;
+    /**
+     * @brief Возвращает количество страниц, скопированных из образа или снимка после загрузки, сброса
+     * или восстановления.
+     */
+    [[nodiscard]] size_t GetPrivatePageCount() const;
+    /**
+     * @brief Создаёт снимок памяти.
+     *
+     * Стоимость пропорциональна количеству страниц, изменённых после загрузки, сброса или восстановления:
+     * остальные страницы разделяются с образом и восстановленным снимком.
+     *
+     * @return Снимок текущего содержимого памяти.
+     */
+    [[nodiscard]] MemorySnapshot TakeSnapshot() const;
 
 private:
-    std::vector<snm::Byte> opcodes_; ///< Коды операций. Индекс соответствует адресу.
-    std::vector<snm::Bytes> arguments_; ///< Аргументы операций. Индекс соответствует адресу.
-    std::vector<snm::Bytes> arguments_original_; ///< Исходные аргументы операций, заполненные при Load. Используется при частичном сбросе.
+    static constexpr size_t PAGE_SIZE = ProgramImage::PAGE_SIZE; ///< Количество ячеек в странице
+    static constexpr size_t PAGE_COUNT = ProgramImage::PAGE_COUNT; ///< Количество страниц памяти
+
+    using Page = ProgramImage::Page;
+
+    size_t code_revision_ = 0; ///< Ревизия кодов операций
+    std::shared_ptr<const ProgramImage> image_; ///< Образ загруженной программы
+    bool image_owned_ = false; ///< Признак образа, созданного менеджером. Только такой образ изменяется без копирования.
+    std::array<const MemoryCell*, PAGE_COUNT> pages_{}; ///< Таблица страниц для чтения: страницы образа или собственные копии
+    std::array<std::unique_ptr<Page>, PAGE_COUNT> private_pages_; ///< Собственные копии страниц, изменённых после сброса
+    std::vector<std::unique_ptr<Page>> spare_pages_; ///< Освобождённые копии страниц для повторного использования
+    std::shared_ptr<const MemorySnapshot> base_; ///< Восстановленный снимок, страницы которого ещё не скопированы
+    std::bitset<snm::CODE_MEMORY_SIZE> watched_; ///< Отмеченные ячейки, запись аргументов которых фиксируется
+    std::vector<snm::Address> watched_writes_; ///< Записанные отмеченные ячейки
+
+    /**
+     * @brief Копирует страницу, на которую указывает таблица страниц, в собственную и направляет на неё таблицу.
+     */
+    void CopyPage(size_t page);
+    /**
+     * @brief Направляет таблицу страниц на страницы восстановленного снимка или образа, кроме страниц,
+     * имеющих собственные копии.
+     */
+    void MapPages();
+    /**
+     * @brief Копирует изменённые страницы восстановленного снимка в собственные и освобождает снимок.
+     */
+    void DetachBase();
+    /**
+     * @brief Возвращает образ для изменения, предварительно копируя его, если он разделяется с другими владельцами.
+     */
+    ProgramImage& MutableImage();
 };
 
 #endif
@@ -0,0 +1,36 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/**
+ * @class OutputBuffer
+ * @brief Буфер вывода программы между потоком исполнения и потоком, отображающим вывод.
+ *
+ * Поток исполнения дописывает вывод через Write(), а поток отображения периодически забирает всё накопленное
+ * одним фрагментом через Drain(), поэтому отображение не зависит от количества инструкций вывода.
+ * Порядок вывода сохраняется. Буфер и строка, переданная в Drain(), обмениваются содержимым, поэтому
+ * при повторном использовании одной строки память выделяется только при росте объёма вывода.
+ */
+class OutputBuffer {
+public:
+    /**
+     * @brief Дописывает вывод в буфер.
+     * @param text Выводимый текст.
+     */
+    void Write(std::string_view text);
+    /**
+     * @brief Забирает весь накопленный вывод.
+     * @param output Строка, в которую помещается вывод. Прежнее содержимое строки удаляется.
+     * @return true, если вывод не пуст.
+     */
+    bool Drain(std::string& output);
+
+private:
+    std::mutex mutex_; ///< Защищает накопленный вывод
+    std::string pending_; ///< Вывод, ещё не забранный через Drain()
+};
+
+#endif
@@ -1,18 +1,28 @@
 #ifndef PROCESSOR_HPP
 #define PROCESSOR_HPP
 
+#include <atomic>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <bitset>
+#include <condition_variable>
 #include <functional>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <cmath>
-// ReSharper disable once CppUnusedIncludeDirective
-#include <thread>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
 
 #include "core/common_definitions.hpp"
+#include "core/jit_compiler.hpp"
 #include "core/memory_manager.hpp"
 #include "core/processor_io.hpp"
 #include "core/processor_observer.hpp"
+#include "core/profiler.hpp"
+
+class ExecutionHistory;
 
 /**
  * @struct Registers
@@ -27,6 +37,52 @@ struct Registers {
     snm::Address instruction_pointer = 0;
 };
 
+/**
+ * @struct ProcessorSnapshot
+ * @brief Согласованный снимок регистров, состояния и памяти процессора на границе инструкций.
+ */
+struct ProcessorSnapshot {
+    Registers registers; ///< Значения регистров
+    snm::ProcessorState state; ///< Состояние процессора
+    uint64_t instruction_count; ///< Количество выполненных инструкций
+    MemorySnapshot memory; ///< Содержимое памяти
+};
+
+/**
+ * @struct SnapshotDiff
+ * @brief Различия двух снимков процессора.
+ */
+struct SnapshotDiff {
+    bool accumulator = false; ///< Различаются значения аккумулятора
+    bool auxiliary = false; ///< Различаются значения вспомогательного регистра
+    bool instruction_pointer = false; ///< Различаются значения указателя инструкций
+    bool state = false; ///< Различаются состояния процессора
+    bool instruction_count = false; ///< Различаются счётчики инструкций
+    std::vector<snm::Address> cells; ///< Адреса ячеек с различными кодами операций или аргументами, по возрастанию
+
+    /**
+     * @brief Сравнивает два снимка.
+     *
+     * Ячейки сравниваются через MemorySnapshot::Diff(), поэтому страницы, общие для снимков, не просматриваются.
+     */
+    [[nodiscard]] static SnapshotDiff Compare(const ProcessorSnapshot& before, const ProcessorSnapshot& after);
+
+    /**
+     * @brief Проверяет, совпадают ли снимки.
+     */
+    [[nodiscard]] bool Empty() const;
+};
+
+/**
+ * @class Processor
+ * @brief Процессор, исполняющий программу из памяти MemoryManager.
+ *
+ * Модель многопоточности: регистры, память и настройки процессора принадлежат потоку, который вызывает Run(),
+ * RunFor(), Step() и остальные изменяющие методы; одновременно их может вызывать только один поток.
+ * Из других потоков во время исполнения допустимы только GetState(), Stop(), GetSnapshot() и передача
+ * ввода через обработчик ввода-вывода. Для чтения регистров и памяти во время исполнения используется
+ * GetSnapshot().
+ */
 class Processor {
 public:
     explicit Processor(MemoryManager& memory, ProcessorObserver* observer = nullptr, ProcessorIo* io = nullptr);
@@ -37,20 +93,49 @@ public:
      * Цикл продолжает выполняться до изменения состояния `is_running_` на `false`, что может быть выполнено
      * посредством вызова других методов, таких как Stop() или до установки регистра IP на адрес, по которому нет инструкций.
      *
+     * Инструкции исполняются в режиме, заданном SetExecutionMode(). В режиме snm::ExecutionMode::THREADED
+     * для запуска с наблюдателем и без него используются отдельные экземпляры цикла исполнения.
      */
     void Run();
+    /**
+     * @brief Выполняет не более заданного количества инструкций без блокировки в ожидании ввода.
+     *
+     * Исполнение продолжается с текущего IP в режиме, заданном SetExecutionMode(), и прекращается при
+     * останове программы, исчерпании бюджета, запросе ввода, на который значение ещё не поступило, или на точке
+     * останова. Бюджет считается по GetInstructionCount(). Значение, введённое через обработчик ввода-вывода
+     * после возврата snm::StopReason::INPUT_NEEDED, применяется следующим вызовом RunFor() или Resume().
+     *
+     * Ошибка исполнения не выбрасывается: процессор останавливается, а сообщение доступно через GetLastError().
+     *
+     * @param instruction_budget Максимальное количество инструкций.
+     * @return Причина возврата управления.
+     */
+    snm::StopReason RunFor(uint64_t instruction_budget);
+    /**
+     * @brief Продолжает исполнение без ограничения количества инструкций и без блокировки в ожидании ввода.
+     * @return Причина возврата управления, как у RunFor().
+     */
+    snm::StopReason Resume();
+    /**
+     * @brief Возвращает сообщение о последней ошибке исполнения в RunFor() или Resume().
+     */
+    [[nodiscard]] const std::string& GetLastError() const;
     /**
      * @brief Выполняет одну инструкцию процессора.
      *
      * Метод выполняет одну инструкцию, определенную текущим значением регистра указателя инструкций (IP).
-     * На время выполнения инструкции статус устанавливается в активный.
+     * На время выполнения инструкции статус устанавливается в активный. Шаг всегда выполняется
+     * эталонным интерпретатором.
      */
     void Step();
     /**
      * @brief Останавливает выполнение инструкций процессора.
      *
-     * Устанавливает внутреннее состояние процессора `is_running_` в значение `false`.
-     * Это состояние используется для завершения активного цикла выполнения инструкций.
+     * Только выставляет запрос остановки и прерывает ожидание ввода, поэтому может вызываться из любого потока.
+     * Цикл исполнения принимает запрос после текущей инструкции и сам устанавливает состояние
+     * snm::ProcessorState::STOPPED, так что наблюдатель уведомляется в потоке исполнения. Если цикл ещё не запущен,
+     * например поток исполнения не успел вызвать Run(), запрос остановки завершает следующий запуск до первой
+     * инструкции. Запрос снимается при выходе цикла по остановке, в Step() и в Reset().
      */
     void Stop();
     /**
@@ -88,6 +173,112 @@ public:
      * @param io Указатель на объект ProcessorIo, который будет использоваться для операций ввода-вывода.
      */
     void SetIo(ProcessorIo* io);
+    /**
+     * @brief Устанавливает профилировщик.
+     *
+     * Профилировщик учитывает каждую исполненную инструкцию и исходы условных пропусков в обоих режимах
+     * исполнения. В режиме snm::ExecutionMode::THREADED для запуска с профилировщиком используются отдельные
+     * экземпляры обработчиков, поэтому без профилировщика исполнение не замедляется.
+     *
+     * @param profiler Профилировщик или nullptr, чтобы отключить профилирование.
+     */
+    void SetProfiler(Profiler* profiler);
+    /**
+     * @brief Устанавливает журнал исполнения для обратного исполнения.
+     *
+     * Журнал заполняется перед каждой инструкцией во всех режимах исполнения. В режимах snm::ExecutionMode::THREADED
+     * и snm::ExecutionMode::FUSED для запуска с журналом используются отдельные экземпляры обработчиков, поэтому без
+     * журнала исполнение не замедляется; режим snm::ExecutionMode::JIT с журналом исполняется как FUSED. Журнал
+     * очищается в Reset() и Restore(). Изменения регистров и памяти вне исполнения инструкций не записываются.
+     *
+     * @param history Журнал или nullptr, чтобы отключить запись.
+     */
+    void SetHistory(ExecutionHistory* history);
+    /**
+     * @brief Отменяет последнюю исполненную инструкцию по журналу исполнения.
+     *
+     * Регистры, записанная инструкцией ячейка и счётчик инструкций возвращаются к значениям перед её
+     * исполнением, процессор переходит в состояние snm::ProcessorState::PAUSED. Отмена инструкции ввода
+     * отбрасывает ожидание значения: ввод будет запрошен повторно.
+     *
+     * @return false, если журнал не установлен или пуст.
+     */
+    bool StepBack();
+    /**
+     * @brief Возвращает исполнение назад до последнего достижения точки останова.
+     *
+     * Процессор останавливается в состоянии snm::ProcessorState::BREAKPOINT перед последней записанной
+     * инструкцией по адресу точки останова, поэтому Run() повторяет исполнение с неё. Если точки останова
+     * отключены или в журнале не достигались, процессор возвращается к самому раннему состоянию журнала
+     * в состоянии snm::ProcessorState::PAUSED.
+     *
+     * @return true, если достигнута точка останова.
+     */
+    bool ReverseContinue();
+    /**
+     * @brief Возвращает исполнение к состоянию с заданным счётчиком инструкций.
+     *
+     * Восстанавливается ближайший снимок журнала, сделанный не раньше заданного счётчика, после чего
+     * отменяются оставшиеся записи, поэтому стоимость не превышает интервала снимков. Записи и снимки после
+     * заданного счётчика удаляются.
+     *
+     * @param instruction_count Счётчик инструкций от ExecutionHistory::GetFirstInstructionCount()
+     *                          до GetInstructionCount().
+     * @return false, если журнал не установлен или не содержит заданного счётчика.
+     */
+    bool RewindTo(uint64_t instruction_count);
+    /**
+     * @brief Устанавливает режим исполнения инструкций для Run().
+     *
+     * Режим snm::ExecutionMode::REFERENCE сохраняет исходный интерпретатор и служит эталоном,
+     * режим snm::ExecutionMode::THREADED исполняет предварительно декодированную программу,
+     * режим snm::ExecutionMode::FUSED дополнительно исполняет типовые последовательности инструкций
+     * одной слитой операцией, режим snm::ExecutionMode::JIT транслирует участки программы в машинный код.
+     * Результаты исполнения, включая счётчик инструкций, уведомления наблюдателя и профиль, во всех режимах
+     * совпадают.
+     *
+     * @param mode Новый режим исполнения.
+     */
+    void SetExecutionMode(snm::ExecutionMode mode);
+    /**
+     * @brief Возвращает текущий режим исполнения инструкций.
+     * @return Режим исполнения, используемый Run().
+     */
+    [[nodiscard]] snm::ExecutionMode GetExecutionMode() const;
+    /**
+     * @brief Устанавливает точку останова по адресу.
+     *
+     * Если точки останова включены, Run() завершается в состоянии snm::ProcessorState::BREAKPOINT, как только
+     * регистр IP после выполнения очередной инструкции указывает на этот адрес. Инструкция, с которой начат
+     * запуск, выполняется без проверки, поэтому повторный Run() продолжает выполнение с точки останова.
+     *
+     * @param address Адрес инструкции.
+     */
+    void SetBreakpoint(snm::Address address);
+    /**
+     * @brief Удаляет точку останова по адресу.
+     * @param address Адрес инструкции.
+     */
+    void RemoveBreakpoint(snm::Address address);
+    /**
+     * @brief Удаляет все точки останова.
+     */
+    void ClearBreakpoints();
+    /**
+     * @brief Проверяет, установлена ли точка останова по адресу.
+     * @param address Адрес инструкции.
+     * @return true, если точка останова установлена.
+     */
+    [[nodiscard]] bool HasBreakpoint(snm::Address address) const;
+    /**
+     * @brief Включает или отключает проверку точек останова в Run().
+     *
+     * При отключённых точках останова цикл исполнения не проверяет их вовсе. Установленные точки сохраняются.
+     * По умолчанию проверка отключена.
+     *
+     * @param enabled Признак проверки точек останова.
+     */
+    void SetBreakpointsEnabled(bool enabled);
     /**
      * @brief Возвращает текущее значение аккумулятора процессора.
      *
@@ -128,9 +319,58 @@ public:
     /**
      * @brief Возвращает текущий статус процессора.
      *
-     * @return Константная ссылка на текущее состояние процессора типа ProcessorState.
+     * Может вызываться из любого потока.
+     *
+     * @return Текущее состояние процессора типа ProcessorState.
+     */
+    [[nodiscard]] snm::ProcessorState GetState() const;
+    /**
+     * @brief Возвращает количество инструкций, выполненных с момента последнего сброса.
+     *
+     * Счётчик увеличивается при каждом исполнении инструкции в любом режиме и обнуляется в Reset().
+     *
+     * @return Количество выполненных инструкций.
+     */
+    [[nodiscard]] uint64_t GetInstructionCount() const;
+    /**
+     * @brief Возвращает последний опубликованный снимок и запрашивает публикацию нового.
+     *
+     * Может вызываться из любого потока и не останавливает исполнение: цикл исполнения публикует новый
+     * снимок на границе следующей инструкции, поэтому при вызове, например, раз в кадр интерфейса возвращается
+     * снимок, опубликованный после предыдущего вызова. Вне цикла исполнения новый снимок публикуется
+     * при следующем запуске или вызовом PublishSnapshot().
+     *
+     * @return Снимок, не изменяющийся после публикации.
+     */
+    [[nodiscard]] std::shared_ptr<const ProcessorSnapshot> GetSnapshot();
+    /**
+     * @brief Публикует снимок текущих регистров, состояния и памяти.
+     *
+     * Вызывается только потоком, которому принадлежит процессор, например наблюдателем во время исполнения.
+     */
+    void PublishSnapshot();
+    /**
+     * @brief Создаёт снимок текущих регистров, состояния и памяти, не публикуя его.
+     *
+     * Вызывается только потоком, которому принадлежит процессор, вне цикла исполнения или из наблюдателя.
+     * Память не копируется целиком: снимок разделяет с MemoryManager неизменённые страницы (см.
+     * MemoryManager::TakeSnapshot()).
      */
-    [[nodiscard]] const snm::ProcessorState& GetState() const;
+    [[nodiscard]] std::shared_ptr<const ProcessorSnapshot> CaptureSnapshot() const;
+    /**
+     * @brief Восстанавливает регистры, счётчик инструкций, состояние и память из снимка.
+     *
+     * Снимок может быть создан другим процессором, в том числе с другой загруженной программой: память
+     * процессора ссылается на страницы снимка и копирует их при первой записи, поэтому несколько процессоров,
+     * восстановленных из одного снимка, продолжают исполнение независимо. Снимок, созданный в состоянии
+     * snm::ProcessorState::PAUSED_BY_IO, восстанавливается приостановленным на инструкции ввода, которая
+     * повторно запрашивает значение при следующем запуске; состояние snm::ProcessorState::RUNNING
+     * восстанавливается как snm::ProcessorState::PAUSED. Значение, введённое до восстановления и не принятое
+     * циклом исполнения, отбрасывается. Наблюдатель уведомляется об изменении регистров, состояния и ячеек.
+     *
+     * @param snapshot Снимок, например созданный CaptureSnapshot() или SnapshotFile::Deserialize().
+     */
+    void Restore(std::shared_ptr<const ProcessorSnapshot> snapshot);
 
     /**
      * @brief Устанавливает значение регистра аккумулятор.
@@ -170,23 +410,234 @@ public:
      * @brief Проверяет, работает ли процессор.
      *
      * Метод определяет, находится ли процессор в состоянии, отличном от остановленного.
+     * Остановка на точке останова также считается остановкой.
      *
      * @return true, если процессор работает; false, если он остановлен.
      */
     [[nodiscard]] bool IsRunning() const {
-        return state_ != snm::ProcessorState::STOPPED;
+        return state_ != snm::ProcessorState::STOPPED && state_ != snm::ProcessorState::BREAKPOINT;
     }
 
 private:
+    /**
+     * @brief Обработчик инструкции предварительно декодированной программы.
+     *
+     * Каждый обработчик специализирован под полный байт кода операции (команда, тип и модификатор аргумента),
+     * поэтому во время исполнения не требуется ни декодирование, ни поиск в таблице.
+     */
+    using ThreadedHandler = void (*)(Processor&);
+
+    /**
+     * @brief Последовательность инструкций, исполняемая одной слитой операцией в режиме snm::ExecutionMode::FUSED.
+     */
+    struct FusedSequence {
+        std::array<snm::Byte, 3> codes; ///< Полные байты кодов операций последовательности
+        size_t length; ///< Количество инструкций последовательности
+        ThreadedHandler handler; ///< Обработчик слитой операции
+    };
+
+    static constexpr size_t FUSED_SEQUENCE_COUNT = 84; ///< Количество слитых последовательностей
+
+    using FusedSequences = std::array<FusedSequence, FUSED_SEQUENCE_COUNT>;
+
     MemoryManager& memory_; ///< Менеджер памяти
     ProcessorObserver* observer_; ///< Текущий наблюдатель состояния
     ProcessorIo* io_; ///< Обработчик ввода-вывода
+    Profiler* profiler_ = nullptr; ///< Профилировщик. Если nullptr, профилирование отключено.
+    ExecutionHistory* history_ = nullptr; ///< Журнал исполнения. Если nullptr, запись отключена.
     Registers registers_; ///< Регистры процессора
-    snm::ProcessorState state_; ///< Состояние процессора в данный момент
+    std::atomic<snm::ProcessorState> state_; ///< Состояние процессора. Во время исполнения изменяется только его потоком.
+    snm::ExecutionMode execution_mode_; ///< Режим исполнения инструкций в Run()
+    uint64_t instruction_count_ = 0; ///< Количество выполненных инструкций
+    std::bitset<snm::CODE_MEMORY_SIZE> breakpoints_; ///< Точки останова. Бит соответствует адресу инструкции.
+    bool breakpoints_enabled_ = false; ///< Признак проверки точек останова в Run()
 
     std::array<std::function<void()>, std::numeric_limits<snm::Byte>::max() + 1> instructions_handlers_;
     std::array<snm::ArgModifier, 4> argument_modifiers_{};
 
+    template <class Policy>
+    static const std::array<ThreadedHandler, std::numeric_limits<snm::Byte>::max() + 1> THREADED_HANDLERS;
+    ///< Обработчики для каждого возможного байта кода операции при заданной политике наблюдения
+    template <class Policy>
+    static const FusedSequences FUSED_SEQUENCES;
+    ///< Слитые последовательности при заданной политике наблюдения
+    std::vector<ThreadedHandler> threaded_code_; ///< Декодированная программа. Индекс соответствует адресу.
+    size_t threaded_code_revision_ = 0; ///< Ревизия кодов операций, по которой построена threaded_code_
+    const ThreadedHandler* threaded_code_handlers_ = nullptr; ///< Таблица обработчиков, по которой построена threaded_code_
+    bool threaded_code_fused_ = false; ///< Признак слитых последовательностей в threaded_code_
+    uint64_t instruction_limit_ = 0; ///< Значение счётчика инструкций, на котором цикл исполнения приостанавливается
+    std::unique_ptr<JitCompiler> jit_compiler_; ///< Транслятор режима snm::ExecutionMode::JIT. Создаётся при первом запуске в этом режиме.
+
+    std::mutex input_mutex_; ///< Защищает передачу введённого значения циклу исполнения
+    std::condition_variable input_ready_; ///< Оповещает цикл исполнения о вводе значения или остановке
+    std::optional<snm::Bytes> pending_input_; ///< Введённое значение, ещё не принятое циклом исполнения
+    bool run_loop_active_ = false; ///< Признак исполнения Run() или RunFor(). Введённые значения передаются циклу исполнения.
+    std::string last_error_; ///< Сообщение о последней ошибке исполнения в RunFor()
+
+    std::atomic<bool> stop_requested_ = false; ///< Запрос остановки, ещё не принятый циклом исполнения
+    std::atomic<bool> snapshot_requested_ = false; ///< Запрос публикации снимка циклом исполнения
+    std::mutex snapshot_mutex_; ///< Защищает замену опубликованного снимка
+    std::shared_ptr<const ProcessorSnapshot> snapshot_; ///< Последний опубликованный снимок
+
+    /**
+     * @brief Политика исполнения без наблюдателя. Уведомления не формируются.
+     */
+    struct Unobserved;
+    /**
+     * @brief Политика исполнения с наблюдателем. Уведомления совпадают с эталонным интерпретатором.
+     */
+    struct Observed;
+    /**
+     * @brief Политика исполнения с профилировщиком поверх политики наблюдения Policy.
+     */
+    template <class Policy>
+    struct Profiled;
+    /**
+     * @brief Политика исполнения с журналом исполнения поверх политики Policy.
+     */
+    template <class Policy>
+    struct Recorded;
+
+    /**
+     * @brief Исполняет инструкции выбранным циклом исполнения.
+     * @param instruction_budget Максимальное количество инструкций.
+     * @param wait_for_input Признак ожидания ввода. Без ожидания запрос ввода без значения завершает исполнение.
+     * @return Причина возврата управления.
+     */
+    snm::StopReason Execute(uint64_t instruction_budget, bool wait_for_input);
+    /**
+     * @brief Цикл исполнения эталонного интерпретатора.
+     * @param limit Значение счётчика инструкций, по достижении которого исполнение приостанавливается.
+     * @param wait_for_input Признак ожидания ввода.
+     */
+    snm::StopReason RunReference(uint64_t limit, bool wait_for_input);
+    /**
+     * @brief Выбирает экземпляр цикла исполнения предварительно декодированной программы по наличию
+     * профилировщика и журнала исполнения.
+     * @tparam Policy Политика наблюдения.
+     */
+    template <class Policy>
+    snm::StopReason RunInstrumented(uint64_t limit, bool wait_for_input);
+    /**
+     * @brief Выбирает экземпляр цикла исполнения предварительно декодированной программы по признаку проверки
+     * точек останова.
+     * @tparam Policy Политика исполнения.
+     */
+    template <class Policy>
+    snm::StopReason RunThreaded(uint64_t limit, bool wait_for_input);
+    /**
+     * @brief Цикл исполнения предварительно декодированной программы.
+     *
+     * Перед запуском при необходимости декодирует программу заново, после чего на каждом шаге
+     * вызывает обработчик, записанный для адреса из регистра IP. В режиме snm::ExecutionMode::FUSED обработчик
+     * слитой операции за один шаг исполняет несколько инструкций. Наличие уведомлений наблюдателя
+     * определяется политикой на этапе компиляции, поэтому в цикле без наблюдателя нет проверок observer_.
+     * Точки останова проверяются только в экземпляре цикла с Breakpoints = true.
+     *
+     * @tparam Policy Политика исполнения: Unobserved, Observed или они же под Profiled и Recorded.
+     * @tparam Breakpoints Признак проверки точек останова после каждой инструкции.
+     * @param limit Значение счётчика инструкций, по достижении которого исполнение приостанавливается.
+     * @param wait_for_input Признак ожидания ввода.
+     */
+    template <class Policy, bool Breakpoints>
+    snm::StopReason RunThreadedLoop(uint64_t limit, bool wait_for_input);
+    /**
+     * @brief Цикл исполнения режима snm::ExecutionMode::JIT.
+     *
+     * На каждом шаге исполняет участок машинного кода, начинающийся с IP, если он умещается в оставшийся бюджет.
+     * Инструкции, с которых участок начинаться не может, исполняются обработчиками декодированной программы
+     * без наблюдателя. Используется только без наблюдателя, профилировщика, журнала исполнения и точек останова.
+     *
+     * @param limit Значение счётчика инструкций, по достижении которого исполнение приостанавливается.
+     * @param wait_for_input Признак ожидания ввода.
+     */
+    snm::StopReason RunJit(uint64_t limit, bool wait_for_input);
+    /**
+     * @brief Останавливает процессор в состоянии snm::ProcessorState::BREAKPOINT, если на текущем IP есть точка останова.
+     */
+    void CheckBreakpoint();
+    /**
+     * @brief Декодирует коды операций из памяти в таблицу обработчиков threaded_code_.
+     *
+     * Таблица заполняется на все адресное пространство: ячейкам с кодом snm::END_OF_CODE соответствует
+     * обработчик ThreadedEnd, останавливающий процессор, поэтому при исполнении проверка границ не нужна.
+     *
+     * Если переданы слитые последовательности, обработчик первой инструкции каждого их вхождения в программу
+     * заменяется обработчиком слитой операции. Остальные инструкции вхождения сохраняют свои обработчики,
+     * поэтому переход внутрь последовательности исполняет её по одной инструкции.
+     *
+     * @param handlers Обработчики для каждого байта кода операции.
+     * @param fused_sequences Слитые последовательности или пустой диапазон.
+     */
+    void DecodeThreadedCode(const std::array<ThreadedHandler, std::numeric_limits<snm::Byte>::max() + 1>& handlers,
+                            std::span<const FusedSequence> fused_sequences);
+    /**
+     * @brief Обработчик инструкции с кодом операции Code для декодированной программы.
+     *
+     * Повторяет семантику эталонного интерпретатора для данного кода операции, включая чтение
+     * аргумента по модификатору. Регистры изменяются напрямую, уведомления формирует политика.
+     *
+     * @tparam Code Полный байт кода операции.
+     * @tparam Policy Политика наблюдения.
+     * @param processor Процессор, исполняющий инструкцию.
+     */
+    template <snm::Byte Code, class Policy>
+    static void ThreadedInstruction(Processor& processor);
+    /**
+     * @brief Обработчик слитой операции: исполняет последовательность инструкций с кодами Codes за один шаг цикла.
+     *
+     * Инструкции исполняются обработчиками ThreadedInstruction, поэтому аргументы читаются из памяти во время
+     * исполнения, а счётчик инструкций, уведомления и профиль совпадают с исполнением по одной инструкции.
+     * Очередная инструкция исполняется, только если предыдущая передала управление на неё: например, сработавший
+     * пропуск проверки цикла завершает операцию до перехода. Если последовательность пересекает бюджет
+     * исполнения или точку останова, исполняется только первая инструкция.
+     *
+     * @tparam Policy Политика наблюдения.
+     * @tparam Kind Вид слитой операции.
+     * @tparam Codes Полные байты кодов операций последовательности.
+     * @param processor Процессор, исполняющий последовательность.
+     */
+    template <class Policy, snm::Fusion Kind, snm::Byte... Codes>
+    static void ThreadedFused(Processor& processor);
+    /**
+     * @brief Строит таблицу слитых последовательностей (см. snm::Fusion) для всех сочетаний модификаторов.
+     */
+    template <class Policy>
+    static constexpr FusedSequences MakeFusedSequences();
+    /**
+     * @brief Проверяет, установлена ли точка останова на инструкциях последовательности после первой.
+     * @param address Адрес первой инструкции.
+     * @param length Количество инструкций последовательности.
+     */
+    [[nodiscard]] bool HasBreakpointInside(snm::Address address, size_t length) const;
+    /**
+     * @brief Обработчик кода операции snm::END_OF_CODE. Останавливает процессор.
+     * @param processor Процессор, исполняющий инструкцию.
+     */
+    static void ThreadedEnd(Processor& processor);
+    /**
+     * @brief Строит таблицу обработчиков для всех возможных байтов кода операции.
+     */
+    template <class Policy, size_t... Codes>
+    static constexpr std::array<ThreadedHandler, sizeof...(Codes)> MakeThreadedHandlers(std::index_sequence<Codes...>);
+    /**
+     * @brief Загружает во вспомогательный регистр операнд текущей инструкции согласно модификатору аргумента.
+     * @tparam Modifier Модификатор аргумента инструкции.
+     * @tparam Policy Политика наблюдения.
+     */
+    template <snm::ArgModifier Modifier, class Policy>
+    void FetchOperand();
+    /**
+     * @brief Устанавливает регистр IP без проверки выхода за пределы программы.
+     *
+     * Выход за пределы обрабатывается обработчиком ThreadedEnd при следующей диспетчеризации.
+     *
+     * @tparam Policy Политика наблюдения.
+     * @param address Новое значение регистра IP.
+     */
+    template <class Policy>
+    void JumpTo(snm::Address address);
+
     /**
      * @brief Выполняет текущую инструкцию процессора.
      *
@@ -210,6 +661,66 @@ private:
      * @param state Новое состояние процессора типа ProcessorState.
      */
     void SetState(snm::ProcessorState state);
+    /**
+     * @brief Принимает запрос остановки в потоке исполнения: снимает запрос и устанавливает состояние STOPPED.
+     * @return snm::StopReason::HALTED.
+     */
+    snm::StopReason AcceptStop();
+    /**
+     * @brief Завершает цикл исполнения по исчерпании бюджета инструкций.
+     * @return snm::StopReason::HALTED, если следующая инструкция находится за концом кода, иначе
+     *         snm::StopReason::BUDGET_EXHAUSTED.
+     */
+    snm::StopReason ExhaustBudget();
+    /**
+     * @brief Устанавливает состояние, в том числе выводя процессор из ожидания ввода, и уведомляет наблюдателя.
+     */
+    void ReplaceState(snm::ProcessorState state);
+    /**
+     * @brief Восстанавливает регистры, счётчик инструкций и память из снимка, не меняя состояние.
+     */
+    void RestoreRegistersAndMemory(const std::shared_ptr<const ProcessorSnapshot>& snapshot);
+    /**
+     * @brief Добавляет в журнал исполнения запись об инструкции, которая исполняется следующей.
+     */
+    void RecordInstruction();
+    /**
+     * @brief Отменяет последнюю запись журнала исполнения.
+     */
+    void UndoInstruction();
+    /**
+     * @brief Переводит процессор в ожидание ввода и запрашивает значение у обработчика ввода-вывода.
+     *
+     * Значение может быть передано как синхронно, до возврата из ProcessorIo::InputRequest(), так и позже
+     * из другого потока.
+     *
+     * @param type Тип вводимого значения.
+     */
+    void RequestInput(snm::Type type);
+    /**
+     * @brief Принимает введённое значение от обработчика ввода-вывода.
+     *
+     * Во время Run() значение передаётся циклу исполнения, который применяет его в своём потоке.
+     * Вне Run(), например при пошаговом исполнении, значение записывается в аккумулятор сразу
+     * и IP переходит к следующей инструкции. Значение игнорируется, если процессор не ожидает ввода.
+     *
+     * @param bytes Введённое значение.
+     */
+    void ProvideInput(snm::Bytes bytes);
+    /**
+     * @brief Блокирует цикл исполнения до ввода значения или выхода из ожидания ввода.
+     * @return Введённое значение или std::nullopt, если ожидание прервано, например вызовом Stop().
+     */
+    std::optional<snm::Bytes> AwaitInput();
+    /**
+     * @brief Забирает введённое значение без ожидания.
+     * @return Введённое значение или std::nullopt, если значение ещё не поступило.
+     */
+    std::optional<snm::Bytes> TakeInput();
+    /**
+     * @brief Отмечает начало или завершение цикла исполнения для передачи введённых значений циклу.
+     */
+    void SetRunLoopActive(bool active);
 
     /**
      * @brief Определяет тип данных в зависимости от переданного шаблонного параметра.
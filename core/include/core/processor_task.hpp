@@ -0,0 +1,116 @@
+#ifndef PROCESSOR_TASK_HPP
+#define PROCESSOR_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "core/processor.hpp"
+
+/**
+ * @class ProcessorTask
+ * @brief Сопрограмма, исполняющая программу порциями через Processor::RunFor().
+ *
+ * Каждый вызов Next() возобновляет сопрограмму, которая выполняет одну порцию инструкций и возвращает управление
+ * с причиной остановки. После snm::StopReason::HALTED или snm::StopReason::EXECUTION_ERROR сопрограмма
+ * завершается, и Next() возвращает false. Между вызовами Next() вызывающий код может передать ввод,
+ * изменить точки останова или прочитать регистры.
+ */
+class ProcessorTask {
+public:
+    struct promise_type {
+        snm::StopReason reason = snm::StopReason::HALTED; ///< Причина последней остановки
+        std::exception_ptr exception; ///< Исключение, выброшенное в сопрограмме
+
+        ProcessorTask get_return_object() {
+            return ProcessorTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always yield_value(const snm::StopReason value) noexcept {
+            reason = value;
+            return {};
+        }
+
+        void return_void() noexcept {
+        }
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+    };
+
+    ProcessorTask(const ProcessorTask&) = delete;
+    ProcessorTask& operator=(const ProcessorTask&) = delete;
+
+    ProcessorTask(ProcessorTask&& other) noexcept :
+        handle_(std::exchange(other.handle_, nullptr)) {
+    }
+
+    ProcessorTask& operator=(ProcessorTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~ProcessorTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief Исполняет следующую порцию инструкций.
+     * @return true, если порция исполнена и доступна причина остановки, false, если исполнение завершено.
+     */
+    bool Next() {
+        if (!handle_ || handle_.done()) {
+            return false;
+        }
+
+        handle_.resume();
+        if (handle_.promise().exception) {
+            std::rethrow_exception(std::exchange(handle_.promise().exception, nullptr));
+        }
+        return !handle_.done();
+    }
+
+    /**
+     * @brief Возвращает причину остановки после последней порции.
+     */
+    [[nodiscard]] snm::StopReason GetReason() const {
+        return handle_.promise().reason;
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit ProcessorTask(const std::coroutine_handle<promise_type> handle) :
+        handle_(handle) {
+    }
+};
+
+/**
+ * @brief Создаёт сопрограмму, исполняющую программу процессора порциями.
+ *
+ * Исполнение начинается при первом вызове ProcessorTask::Next(). Процессор должен существовать, пока
+ * существует сопрограмма.
+ *
+ * @param processor Процессор с загруженной программой.
+ * @param slice Количество инструкций в одной порции.
+ * @return Сопрограмма исполнения.
+ */
+ProcessorTask RunSliced(Processor& processor, uint64_t slice);
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * @struct BranchCounts
+ * @brief Количество срабатываний и несрабатываний условного пропуска (SKIPLO, SKIPGT, SKIPEQ).
+ */
+struct BranchCounts {
+    uint64_t taken = 0; ///< Условие выполнено, следующая инструкция пропущена
+    uint64_t not_taken = 0; ///< Условие не выполнено
+};
+
+/**
+ * @struct FusionCounts
+ * @brief Счётчики слитой операции (snm::Fusion) в режиме snm::ExecutionMode::FUSED.
+ */
+struct FusionCounts {
+    uint64_t hits = 0; ///< Исполнения слитой операции
+    uint64_t fallbacks = 0; ///< Исполнения по одной инструкции, так как последовательность пересекает бюджет или точку останова
+    uint64_t instructions = 0; ///< Инструкции, исполненные в составе слитой операции
+};
+
+/**
+ * @class Profiler
+ * @brief Профиль исполнения программы: количество исполнений каждой инструкции и исходы ветвлений.
+ *
+ * Заполняется процессором, которому профилировщик передан через Processor::SetProfiler(). Счётчики по командам
+ * и модификаторам типа вычисляются из счётчиков по адресам, поэтому на каждую инструкцию приходится одно
+ * обновление. Результаты сопоставляются строкам исходного кода через snm::SourceToBytecodeMap
+ * и выгружаются в CSV, JSON и свёрнутые стеки для построения flame graph.
+ *
+ * В режиме snm::ExecutionMode::FUSED инструкции слитых операций учитываются так же, как при исполнении по одной,
+ * а исполнения самих слитых операций учитываются отдельно по видам.
+ */
+class Profiler {
+public:
+    Profiler();
+
+    /**
+     * @brief Учитывает исполнение инструкции.
+     * @param address Адрес инструкции.
+     * @param code Байт кода операции.
+     */
+    void OnInstruction(const snm::Address address, const snm::Byte code) {
+        AddressProfile& profile = addresses_[address];
+        ++profile.count;
+        profile.code = code;
+    }
+
+    /**
+     * @brief Учитывает исход условного пропуска.
+     * @param address Адрес инструкции пропуска.
+     * @param taken Признак выполнения условия.
+     */
+    void OnBranch(const snm::Address address, const bool taken) {
+        AddressProfile& profile = addresses_[address];
+        ++(taken ? profile.branches.taken : profile.branches.not_taken);
+    }
+
+    /**
+     * @brief Учитывает исполнение слитой операции.
+     * @param fusion Вид слитой операции.
+     * @param instructions Количество исполненных инструкций последовательности.
+     */
+    void OnFusion(const snm::Fusion fusion, const uint64_t instructions) {
+        FusionCounts& counts = fusions_[static_cast<size_t>(fusion)];
+        ++counts.hits;
+        counts.instructions += instructions;
+    }
+
+    /**
+     * @brief Учитывает исполнение последовательности по одной инструкции вместо слитой операции.
+     * @param fusion Вид слитой операции.
+     */
+    void OnFusionFallback(const snm::Fusion fusion) {
+        ++fusions_[static_cast<size_t>(fusion)].fallbacks;
+    }
+
+    /**
+     * @brief Обнуляет все счётчики.
+     */
+    void Reset();
+
+    /**
+     * @brief Возвращает общее количество учтённых инструкций.
+     */
+    [[nodiscard]] uint64_t GetInstructionCount() const;
+    /**
+     * @brief Возвращает количество исполнений инструкции по адресу.
+     * @param address Адрес инструкции.
+     */
+    [[nodiscard]] uint64_t GetAddressCount(snm::Address address) const;
+    /**
+     * @brief Возвращает исходы условного пропуска по адресу.
+     * @param address Адрес инструкции.
+     */
+    [[nodiscard]] BranchCounts GetBranchCounts(snm::Address address) const;
+    /**
+     * @brief Возвращает количество исполнений команды с любыми модификаторами.
+     * @param opcode Команда.
+     */
+    [[nodiscard]] uint64_t GetOpCodeCount(snm::OpCode opcode) const;
+    /**
+     * @brief Возвращает количество исполнений инструкций с модификатором типа. HALT не учитывается.
+     * @param type_modifier Модификатор типа.
+     */
+    [[nodiscard]] uint64_t GetTypeModifierCount(snm::TypeModifier type_modifier) const;
+    /**
+     * @brief Возвращает суммарные исходы условного пропуска для команды.
+     * @param opcode Команда SKIPLO, SKIPGT или SKIPEQ.
+     */
+    [[nodiscard]] BranchCounts GetBranchCounts(snm::OpCode opcode) const;
+    /**
+     * @brief Возвращает счётчики слитой операции.
+     * @param fusion Вид слитой операции.
+     */
+    [[nodiscard]] FusionCounts GetFusionCounts(snm::Fusion fusion) const;
+    /**
+     * @brief Возвращает количество исполнений инструкций по строкам исходного кода.
+     * @param source_map Карта соответствий строк исходного кода адресам байт-кода.
+     * @return Количество исполнений по номерам строк. Строки без исполнений не включаются.
+     */
+    [[nodiscard]] std::map<unsigned int, uint64_t> GetLineCounts(const snm::SourceToBytecodeMap& source_map) const;
+
+    /**
+     * @brief Выгружает профиль в CSV: строка на каждый исполнявшийся адрес.
+     *
+     * Столбцы: address, line, opcode, type, count, taken, not_taken. Для адресов без строки исходного кода
+     * столбец line пуст, столбцы taken и not_taken заполнены только для условных пропусков.
+     *
+     * @param stream Поток вывода.
+     * @param source_map Карта соответствий строк исходного кода адресам байт-кода.
+     */
+    void WriteCsv(std::ostream& stream, const snm::SourceToBytecodeMap& source_map = {}) const;
+    /**
+     * @brief Выгружает профиль в JSON.
+     *
+     * Объект содержит общее количество инструкций, счётчики по командам и модификаторам типа,
+     * исходы условных пропусков по командам, счётчики слитых операций с долей покрытых ими инструкций,
+     * а также массивы счётчиков по адресам и строкам.
+     *
+     * @param stream Поток вывода.
+     * @param source_map Карта соответствий строк исходного кода адресам байт-кода.
+     */
+    void WriteJson(std::ostream& stream, const snm::SourceToBytecodeMap& source_map = {}) const;
+    /**
+     * @brief Выгружает профиль в формате свёрнутых стеков (collapsed stacks) для flame graph.
+     *
+     * Стек каждой инструкции состоит из ближайшей метки, расположенной не дальше адреса инструкции,
+     * и строки исходного кода (или адреса, если строка неизвестна), например `LOOP;line 12 4000`.
+     * Стек вызовов JnS не отслеживается.
+     *
+     * @param stream Поток вывода.
+     * @param source_map Карта соответствий строк исходного кода адресам байт-кода.
+     * @param labels Адреса меток.
+     */
+    void WriteCollapsedStacks(std::ostream& stream, const snm::SourceToBytecodeMap& source_map = {},
+                              const snm::LabelMap& labels = {}) const;
+
+private:
+    /**
+     * @brief Счётчики одного адреса.
+     */
+    struct AddressProfile {
+        uint64_t count = 0; ///< Количество исполнений
+        BranchCounts branches; ///< Исходы условного пропуска
+        snm::Byte code = snm::END_OF_CODE; ///< Байт кода последней исполненной по адресу инструкции
+    };
+
+    std::vector<AddressProfile> addresses_; ///< Счётчики по адресам. Индекс соответствует адресу.
+    std::array<FusionCounts, 4> fusions_{}; ///< Счётчики слитых операций. Индекс соответствует snm::Fusion.
+
+    /**
+     * @brief Вызывает функцию для каждого исполнявшегося адреса в порядке возрастания.
+     */
+    template <class F>
+    void ForEachExecuted(F&& function) const;
+};
+
+#endif
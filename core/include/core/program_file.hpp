@@ -0,0 +1,114 @@
+#ifndef PROGRAM_FILE_HPP
+#define PROGRAM_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "core/assembler.hpp"
+#include "core/common_definitions.hpp"
+
+/**
+ * @class ProgramFile
+ * @brief Файл с оттранслированной программой (.snmb), отображённый в память.
+ *
+ * Файл содержит байт-код, таблицу меток и карту соответствий строк исходного кода адресам байт-кода,
+ * поэтому программу достаточно оттранслировать один раз. Все числа записываются в порядке little-endian:
+ *
+ * | Смещение | Размер | Содержимое                                                      |
+ * |----------|--------|-----------------------------------------------------------------|
+ * | 0        | 4      | Сигнатура "SNMB"                                                |
+ * | 4        | 2      | Версия формата                                                  |
+ * | 6        | 2      | Зарезервировано, 0                                              |
+ * | 8        | 4      | Количество инструкций N                                         |
+ * | 12       | 4      | Количество меток L                                              |
+ * | 16       | 4      | Количество записей карты исходного кода M                       |
+ * | 20       | 5 * N  | Байт-код в формате MemoryManager::Load                          |
+ * |          |        | L записей: адрес (2), длина имени (2), имя метки                |
+ * |          |        | M записей: номер строки (4), адрес (2)                          |
+ *
+ * Байт-код не копируется при открытии файла: GetByteCode() возвращает область отображённого файла,
+ * которую можно сразу передать в MemoryManager::Load. Таблица меток и карта исходного кода
+ * декодируются только по запросу.
+ */
+class ProgramFile {
+public:
+    static constexpr std::string_view EXTENSION = ".snmb"; ///< Расширение файлов программ
+    static constexpr uint16_t VERSION = 1; ///< Версия формата, записываемая в файл
+
+    /**
+     * @brief Открывает файл программы и проверяет его структуру.
+     * @param path Путь к файлу.
+     * @throws std::runtime_error Если файл не удалось открыть.
+     * @throws std::invalid_argument Если файл не является файлом программы, имеет неподдерживаемую версию
+     *                               или повреждён.
+     */
+    explicit ProgramFile(const std::string& path);
+
+    ~ProgramFile();
+
+    ProgramFile(const ProgramFile&) = delete;
+    ProgramFile& operator=(const ProgramFile&) = delete;
+
+    ProgramFile(ProgramFile&&) noexcept;
+    ProgramFile& operator=(ProgramFile&&) noexcept;
+
+    /**
+     * @brief Возвращает байт-код программы.
+     * @return Область отображённого файла. Действительна, пока существует объект.
+     */
+    [[nodiscard]] std::span<const snm::Byte> GetByteCode() const;
+    /**
+     * @brief Декодирует таблицу меток.
+     * @return Адреса меток по именам в верхнем регистре.
+     */
+    [[nodiscard]] snm::LabelMap GetLabels() const;
+    /**
+     * @brief Декодирует карту соответствий строк исходного кода адресам байт-кода.
+     */
+    [[nodiscard]] snm::SourceToBytecodeMap GetSourceMap() const;
+
+    /**
+     * @brief Формирует содержимое файла программы.
+     *
+     * Метки и записи карты исходного кода упорядочиваются, поэтому одна и та же программа
+     * всегда даёт одинаковый файл.
+     *
+     * @param program Оттранслированная программа.
+     * @return Содержимое файла.
+     * @throws std::invalid_argument Если байт-код некорректен или имя метки слишком длинное.
+     */
+    static snm::ByteCode Serialize(const Program& program);
+    /**
+     * @brief Записывает программу в файл.
+     * @param path Путь к файлу.
+     * @param program Оттранслированная программа.
+     * @throws std::runtime_error Если файл не удалось записать.
+     * @throws std::invalid_argument Если байт-код некорректен или имя метки слишком длинное.
+     */
+    static void Write(const std::string& path, const Program& program);
+
+private:
+    /**
+     * @brief Отображение файла в память.
+     */
+    class Mapping;
+
+    std::unique_ptr<Mapping> mapping_; ///< Отображённый файл
+    std::span<const snm::Byte> byte_code_; ///< Байт-код в отображённом файле
+    std::span<const snm::Byte> labels_; ///< Записи таблицы меток в отображённом файле
+    std::span<const snm::Byte> source_map_; ///< Записи карты исходного кода в отображённом файле
+    uint32_t label_count_ = 0; ///< Количество меток
+    uint32_t source_map_size_ = 0; ///< Количество записей карты исходного кода
+
+    /**
+     * @brief Проверяет заголовок и размеры разделов и находит их в содержимом файла.
+     * @param data Содержимое файла.
+     * @throws std::invalid_argument Если структура файла некорректна.
+     */
+    void Parse(std::span<const snm::Byte> data);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef PROGRAM_IMAGE_HPP
+#define PROGRAM_IMAGE_HPP
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * @struct MemoryCell
+ * @brief Ячейка памяти: код операции и аргумент, хранящиеся рядом.
+ */
+struct MemoryCell {
+    snm::Byte opcode = snm::END_OF_CODE; ///< Код операции. За пределами программы равен snm::END_OF_CODE.
+    snm::Bytes argument{}; ///< Аргумент операции
+};
+
+/**
+ * @class ProgramImage
+ * @brief Образ загруженной программы: коды операций и исходные аргументы ячеек.
+ *
+ * Ячейки хранятся страницами по PAGE_SIZE. Хранятся только страницы, занятые программой, остальные страницы
+ * общие для всех образов и содержат snm::END_OF_CODE с нулевыми аргументами. Образ создаётся через
+ * std::make_shared и после загрузки не изменяется, поэтому один образ разделяется между экземплярами
+ * MemoryManager, в том числе из разных потоков.
+ */
+class ProgramImage {
+public:
+    static constexpr size_t PAGE_SIZE = 256; ///< Количество ячеек в странице
+    static constexpr size_t PAGE_COUNT = snm::CODE_MEMORY_SIZE / PAGE_SIZE; ///< Количество страниц адресного пространства
+
+    using Page = std::array<MemoryCell, PAGE_SIZE>;
+
+    ProgramImage() = default;
+
+    /**
+     * @brief Строит образ из байт-кода.
+     * @param byte_code Байт-код в формате MemoryManager::Load().
+     * @throws std::invalid_argument Если размер байт-кода превышает максимально допустимый размер памяти или формат байт-кода некорректен.
+     */
+    explicit ProgramImage(std::span<const snm::Byte> byte_code);
+
+    /**
+     * @brief Возвращает страницу образа.
+     * @param page Номер страницы.
+     * @return Страница программы или общая пустая страница, если номер за пределами программы.
+     */
+    [[nodiscard]] const Page& GetPage(size_t page) const {
+        return page < pages_.size() ? pages_[page] : EmptyPage();
+    }
+
+    /**
+     * @brief Возвращает ячейку образа по адресу.
+     */
+    [[nodiscard]] const MemoryCell& GetCell(const snm::Address address) const {
+        return GetPage(address / PAGE_SIZE)[address % PAGE_SIZE];
+    }
+
+    /**
+     * @brief Возвращает количество ячеек, занятых программой.
+     */
+    [[nodiscard]] size_t Size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Записывает инструкцию по адресу.
+     *
+     * Ячейки между концом программы и адресом становятся пустыми инструкциями с нулевым аргументом.
+     * Используется при построении образа. Образ, доступный нескольким владельцам, не изменяется:
+     * MemoryManager предварительно копирует его.
+     *
+     * @param code Код инструкции.
+     * @param argument Аргумент инструкции.
+     * @param address Адрес инструкции.
+     */
+    void WriteInstruction(snm::Byte code, snm::Bytes argument, snm::Address address);
+
+private:
+    size_t size_ = 0; ///< Количество ячеек, занятых программой
+    std::vector<Page> pages_; ///< Страницы, занятые программой
+
+    /**
+     * @brief Возвращает страницу, заполненную snm::END_OF_CODE с нулевыми аргументами.
+     */
+    static const Page& EmptyPage();
+};
+
+#endif
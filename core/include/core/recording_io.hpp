@@ -0,0 +1,62 @@
+#ifndef RECORDING_IO_HPP
+#define RECORDING_IO_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "core/io_log_file.hpp"
+#include "core/processor_io.hpp"
+
+/**
+ * @class RecordingIo
+ * @brief Ввод-вывод процессора, записывающий каждый обмен с вложенным обработчиком.
+ *
+ * Запросы передаются вложенному обработчику без изменений. Выведенное значение записывается при запросе
+ * вывода, введённое — когда вложенный обработчик передаёт его процессору, в том числе асинхронно, как
+ * консоль GUI. Счётчик инструкций события берётся в момент запроса, поэтому он не зависит от того, сколько
+ * ждал ответа пользователь. Запись сохраняется через IoLogFile и воспроизводится ReplayIo.
+ *
+ * События читаются через GetEvents(), пока процессор не исполняется: при асинхронном вводе событие
+ * добавляется до передачи значения процессору, который продолжает исполнение только после этого.
+ */
+class RecordingIo final : public ProcessorIo {
+public:
+    /**
+     * @brief Источник счётчика инструкций, например VirtualMachine::GetInstructionCount().
+     *
+     * Вызывается в потоке исполнения процессора из InputRequest() и OutputRequest().
+     */
+    using InstructionCounter = std::function<uint64_t()>;
+
+    /**
+     * @brief Конструктор класса RecordingIo.
+     * @param io Обработчик, которому передаются запросы.
+     * @param instruction_counter Источник счётчика инструкций. Если не задан, счётчики событий равны нулю.
+     */
+    explicit RecordingIo(ProcessorIo& io, InstructionCounter instruction_counter = nullptr);
+
+    void InputRequest(snm::Type type, InputCallback callback) override;
+    void OutputRequest(snm::Bytes bytes, snm::Type type) override;
+
+    /**
+     * @brief Возвращает записанные события в порядке обмена.
+     */
+    [[nodiscard]] const std::vector<IoEvent>& GetEvents() const;
+    /**
+     * @brief Удаляет записанные события.
+     */
+    void Clear();
+
+private:
+    ProcessorIo& io_; ///< Обработчик, которому передаются запросы
+    InstructionCounter instruction_counter_; ///< Источник счётчика инструкций
+    std::vector<IoEvent> events_; ///< Записанные события
+
+    /**
+     * @brief Возвращает текущий счётчик инструкций.
+     */
+    [[nodiscard]] uint64_t GetInstructionCount() const;
+};
+
+#endif
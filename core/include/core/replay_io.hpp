@@ -0,0 +1,70 @@
+#ifndef REPLAY_IO_HPP
+#define REPLAY_IO_HPP
+
+#include <vector>
+
+#include "core/recording_io.hpp"
+
+/**
+ * @class ReplayIo
+ * @brief Ввод-вывод процессора, воспроизводящий запись RecordingIo и проверяющий, что исполнение совпадает с ней.
+ *
+ * Запросы ввода обслуживаются записанными значениями синхронно, поэтому процессор не переходит в состояние
+ * snm::ProcessorState::PAUSED_BY_IO и воспроизведение идёт без пауз. Каждый запрос сверяется с очередным
+ * событием записи: направление, тип, значение вывода и, если задан источник счётчика, счётчик инструкций.
+ * Первое расхождение прерывает исполнение исключением с описанием ожидаемого и фактического обмена.
+ * Совпавший вывод передаётся вложенному обработчику, например для отображения в консоли.
+ */
+class ReplayIo final : public ProcessorIo {
+public:
+    using InstructionCounter = RecordingIo::InstructionCounter;
+
+    /**
+     * @brief Конструктор класса ReplayIo.
+     * @param events Записанные события в порядке обмена.
+     * @param io Обработчик совпавшего вывода.
+     * @param instruction_counter Источник счётчика инструкций. Если не задан, счётчики не сверяются.
+     */
+    ReplayIo(std::vector<IoEvent> events, ProcessorIo& io, InstructionCounter instruction_counter = nullptr);
+
+    /**
+     * @brief Передаёт процессору записанное входное значение.
+     * @throws std::runtime_error Если очередное событие записи не является вводом того же типа на том же
+     *                            счётчике инструкций или запись исчерпана.
+     */
+    void InputRequest(snm::Type type, InputCallback callback) override;
+    /**
+     * @brief Сверяет вывод с записью и передаёт его вложенному обработчику.
+     * @throws std::runtime_error Если очередное событие записи не является выводом того же значения того же
+     *                            типа на том же счётчике инструкций или запись исчерпана.
+     */
+    void OutputRequest(snm::Bytes bytes, snm::Type type) override;
+
+    /**
+     * @brief Возвращает воспроизведение к первому событию.
+     */
+    void Rewind();
+    /**
+     * @brief Возвращает количество ещё не воспроизведённых событий.
+     */
+    [[nodiscard]] size_t GetRemaining() const;
+    /**
+     * @brief Проверяет после останова программы, что воспроизведены все события записи.
+     * @throws std::runtime_error Если программа завершилась раньше, чем при записи.
+     */
+    void Finish() const;
+
+private:
+    std::vector<IoEvent> events_; ///< Записанные события
+    size_t next_ = 0; ///< Индекс следующего ожидаемого события
+    ProcessorIo& io_; ///< Обработчик совпавшего вывода
+    InstructionCounter instruction_counter_; ///< Источник счётчика инструкций
+
+    /**
+     * @brief Сверяет фактический обмен с очередным событием и переходит к следующему.
+     * @return Совпавшее событие.
+     */
+    const IoEvent& Expect(const IoEvent& actual);
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SNAPSHOT_FILE_HPP
+#define SNAPSHOT_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "core/common_definitions.hpp"
+#include "core/processor.hpp"
+
+/**
+ * @class SnapshotFile
+ * @brief Двоичный формат снимка виртуальной машины (.snms).
+ *
+ * Снимок хранит регистры, состояние, счётчик инструкций, коды операций и исходные аргументы образа программы
+ * и только те ячейки, аргументы которых отличаются от образа, поэтому размер файла пропорционален размеру
+ * программы и количеству изменённых ячеек, а не адресному пространству. Все числа записываются в порядке
+ * little-endian:
+ *
+ * | Смещение | Размер | Содержимое                                                      |
+ * |----------|--------|-----------------------------------------------------------------|
+ * | 0        | 4      | Сигнатура "SNMS"                                                |
+ * | 4        | 2      | Версия формата                                                  |
+ * | 6        | 1      | Состояние процессора snm::ProcessorState                        |
+ * | 7        | 1      | Зарезервировано, 0                                              |
+ * | 8        | 8      | Количество выполненных инструкций                               |
+ * | 16       | 4      | Аккумулятор                                                     |
+ * | 20       | 4      | Вспомогательный регистр                                         |
+ * | 24       | 2      | Указатель инструкций                                            |
+ * | 26       | 2      | Зарезервировано, 0                                              |
+ * | 28       | 4      | Количество инструкций образа N                                  |
+ * | 32       | 4      | Количество изменённых ячеек M                                   |
+ * | 36       | 5 * N  | Образ в формате байт-кода MemoryManager::Load                   |
+ * |          |        | M записей: адрес (2), аргумент (4), по возрастанию адресов      |
+ *
+ * Регистры и аргументы записываются в порядке байтов snm::Bytes, как аргументы байт-кода.
+ */
+class SnapshotFile {
+public:
+    static constexpr std::string_view EXTENSION = ".snms"; ///< Расширение файлов снимков
+    static constexpr uint16_t VERSION = 1; ///< Версия формата, записываемая в файл
+
+    /**
+     * @brief Формирует содержимое файла снимка.
+     *
+     * Изменённые ячейки находятся через MemorySnapshot::GetWrittenCells(), поэтому просматриваются только
+     * страницы, скопированные из образа.
+     *
+     * @param snapshot Снимок процессора.
+     * @return Содержимое файла.
+     */
+    static snm::ByteCode Serialize(const ProcessorSnapshot& snapshot);
+    /**
+     * @brief Восстанавливает снимок из содержимого файла.
+     *
+     * Образ программы создаётся заново, поэтому снимок не разделяет страницы с образом, из которого был
+     * сохранён.
+     *
+     * @param data Содержимое файла.
+     * @return Снимок, который можно передать в Processor::Restore() или VirtualMachine::Restore().
+     * @throws std::invalid_argument Если данные не являются снимком, имеют неподдерживаемую версию или повреждены.
+     */
+    static std::shared_ptr<const ProcessorSnapshot> Deserialize(std::span<const snm::Byte> data);
+    /**
+     * @brief Записывает снимок в файл.
+     * @param path Путь к файлу.
+     * @param snapshot Снимок процессора.
+     * @throws std::runtime_error Если файл не удалось записать.
+     */
+    static void Write(const std::string& path, const ProcessorSnapshot& snapshot);
+    /**
+     * @brief Читает снимок из файла.
+     * @param path Путь к файлу.
+     * @throws std::runtime_error Если файл не удалось открыть.
+     * @throws std::invalid_argument Если файл не является файлом снимка, имеет неподдерживаемую версию
+     *                               или повреждён.
+     */
+    static std::shared_ptr<const ProcessorSnapshot> Read(const std::string& path);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef STREAM_IO_HPP
+#define STREAM_IO_HPP
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "core/processor_io.hpp"
+
+/**
+ * @class StreamIo
+ * @brief Ввод-вывод процессора через стандартные потоки с буферизацией вывода.
+ *
+ * Значения вводятся из входного потока как токены, разделённые пробельными символами,
+ * и разбираются так же, как при вводе из консоли графического интерфейса. Выводимые значения
+ * без разделителей накапливаются во внутреннем буфере и записываются в выходной поток
+ * при его заполнении, перед каждым запросом ввода, при вызове Flush() и при разрушении объекта.
+ */
+class StreamIo final : public ProcessorIo {
+public:
+    /**
+     * @brief Конструктор класса StreamIo.
+     * @param input Поток, из которого читаются вводимые значения.
+     * @param output Поток, в который записываются выводимые значения.
+     * @param buffer_size Размер буфера вывода в байтах.
+     */
+    StreamIo(std::istream& input, std::ostream& output, size_t buffer_size = 64 * 1024);
+
+    ~StreamIo() override;
+
+    StreamIo(const StreamIo&) = delete;
+    StreamIo& operator=(const StreamIo&) = delete;
+
+    /**
+     * @brief Читает из входного потока очередное значение и передаёт его процессору.
+     *
+     * Ответ передаётся синхронно, до возврата из метода.
+     *
+     * @throws std::runtime_error Если входной поток исчерпан или значение не удалось разобрать.
+     */
+    void InputRequest(snm::Type type, InputCallback callback) override;
+    void OutputRequest(snm::Bytes bytes, snm::Type type) override;
+
+    /**
+     * @brief Записывает накопленный вывод в выходной поток.
+     */
+    void Flush();
+
+private:
+    std::istream& input_; ///< Поток ввода
+    std::ostream& output_; ///< Поток вывода
+    std::string buffer_; ///< Накопленный, но ещё не записанный вывод
+    size_t buffer_size_; ///< Размер буфера, при достижении которого вывод записывается в поток
+};
+
+#endif
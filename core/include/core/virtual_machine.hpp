@@ -29,17 +29,43 @@ public:
     VirtualMachine& operator=(VirtualMachine&&) = default;
 
     virtual void Load(const snm::ByteCode& byte_code);
+    virtual void Load(std::span<const snm::Byte> byte_code);
     [[nodiscard]] virtual snm::Bytes ReadMemory(const snm::Address& address);
     virtual void WriteMemory(const snm::Address& address, const snm::Bytes& data);
 
     virtual void Run();
+    virtual snm::StopReason RunFor(uint64_t instruction_budget);
+    virtual snm::StopReason Resume();
     virtual void Stop();
     virtual void Step();
     virtual void Reset();
+    /**
+     * @brief Отменяет последнюю инструкцию по журналу, заданному SetHistory() (см. Processor::StepBack()).
+     */
+    virtual bool StepBack();
+    /**
+     * @brief Возвращает исполнение к предыдущей точке останова (см. Processor::ReverseContinue()).
+     */
+    virtual bool ReverseContinue();
 
     [[nodiscard]] virtual bool IsRunning();
-    [[nodiscard]] virtual const snm::ProcessorState& GetState();
+    [[nodiscard]] virtual snm::ProcessorState GetState();
     [[nodiscard]] virtual Registers GetRegisters();
+    [[nodiscard]] virtual uint64_t GetInstructionCount();
+    [[nodiscard]] virtual std::shared_ptr<const ProcessorSnapshot> GetSnapshot();
+    /**
+     * @brief Создаёт снимок регистров, состояния и памяти машины вне цикла исполнения.
+     *
+     * Снимок можно восстановить в этой или другой машине через Restore() или сохранить через SnapshotFile.
+     */
+    [[nodiscard]] virtual std::shared_ptr<const ProcessorSnapshot> Snapshot();
+    /**
+     * @brief Восстанавливает машину из снимка (см. Processor::Restore()).
+     *
+     * Машины, восстановленные из одного снимка, разделяют его страницы памяти до первой записи в них,
+     * поэтому ответвление исполнения от снимка не копирует память программы.
+     */
+    virtual void Restore(std::shared_ptr<const ProcessorSnapshot> snapshot);
 
     virtual void SetInstructionPointer(snm::Address value);
     virtual void SetAccumulator(snm::Byte value);
@@ -53,6 +79,13 @@ public:
 
     void SetProcessorObserver(ProcessorObserver* observer) const;
     void SetProcessorIo(ProcessorIo* processor_io) const;
+    void SetProfiler(Profiler* profiler) const;
+    void SetHistory(ExecutionHistory* history) const;
+    void SetExecutionMode(snm::ExecutionMode mode) const;
+    void SetBreakpoint(snm::Address address) const;
+    void RemoveBreakpoint(snm::Address address) const;
+    void ClearBreakpoints() const;
+    void SetBreakpointsEnabled(bool enabled) const;
 
     void OutputRequest(snm::Bytes bytes, snm::Type type) override;
     void InputRequest(snm::Type type, InputCallback callback) override;
@@ -0,0 +1,183 @@
+#include "core/aot_runtime.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "core/input_feed_io.hpp"
+#include "core/stream_io.hpp"
+
+namespace {
+    /**
+     * @brief Коды завершения исполняемого файла, совпадающие с sandm-run.
+     */
+    enum ExitCode {
+        SUCCESS = 0,
+        RUNTIME_ERROR = 1,
+        LOAD_ERROR = 2
+    };
+
+    void PrintUsage(std::ostream& stream, const char* name) {
+        stream << "Usage: " << name << " [options]\n"
+            "\n"
+            "Runs a SANDM program translated to C++ by sandm-aot. Program input is read from stdin, output\n"
+            "is written to stdout, the execution report is written to stderr.\n"
+            "\n"
+            "Options:\n"
+            "  -i, --input <file>\n"
+            "                   read program input from <file>, parsed before the run; stdin is used\n"
+            "                   once the file is exhausted\n"
+            "  -q, --quiet      do not print the execution report\n"
+            "  -h, --help       show this help\n";
+    }
+}
+
+AotRuntime::AotRuntime(const AotProgram& program, ProcessorIo& io) :
+    io_(io),
+    program_(program) {
+    memory_.Load(program.byte_code);
+
+    for (size_t address = 0; address < memory_.Size(); ++address) {
+        const auto [code, argument] = memory_.ReadInstruction(static_cast<snm::Address>(address));
+        code_cells_.set(address, static_cast<snm::OpCode>(code >> 4) != snm::OpCode::NOPE);
+    }
+}
+
+void AotRuntime::Run() {
+    program_.run(*this);
+}
+
+void AotRuntime::Reset() {
+    memory_.ResetData();
+    registers_ = {};
+    instruction_count_ = 0;
+    interpreted_ = false;
+}
+
+const Registers& AotRuntime::GetRegisters() const {
+    return registers_;
+}
+
+uint64_t AotRuntime::GetInstructionCount() const {
+    return instruction_count_;
+}
+
+const MemoryManager& AotRuntime::GetMemory() const {
+    return memory_;
+}
+
+bool AotRuntime::IsInterpreted() const {
+    return interpreted_;
+}
+
+snm::Bytes AotRuntime::Input(const snm::Type type) {
+    io_.InputRequest(type, [this](const snm::Bytes bytes) {
+        std::lock_guard lock(input_mutex_);
+        input_ = bytes;
+        input_ready_.notify_one();
+    });
+
+    std::unique_lock lock(input_mutex_);
+    input_ready_.wait(lock, [this] {
+        return input_.has_value();
+    });
+    return *std::exchange(input_, std::nullopt);
+}
+
+void AotRuntime::Finish(const Registers& registers, const uint64_t instruction_count) {
+    registers_ = registers;
+    instruction_count_ = instruction_count;
+}
+
+void AotRuntime::Interpret(const Registers& registers, const uint64_t instruction_count) {
+    Finish(registers, instruction_count);
+    interpreted_ = true;
+
+    Processor processor(memory_, nullptr, &io_);
+    processor.SetAccumulator(registers.accumulator);
+    processor.SetAuxiliary(registers.auxiliary);
+    processor.SetInstructionPointer(registers.instruction_pointer);
+
+    try {
+        processor.Run();
+    } catch (...) {
+        Finish(processor.GetRegisters(), instruction_count + processor.GetInstructionCount());
+        throw;
+    }
+
+    Finish(processor.GetRegisters(), instruction_count + processor.GetInstructionCount());
+}
+
+void AotRuntime::ThrowAddressOutOfRange(const snm::Word address, const snm::Address instruction_pointer) {
+    throw std::out_of_range(std::format("IP {}: Address {} exceeds available memory.",
+                                        std::to_string(instruction_pointer), std::to_string(address)));
+}
+
+int AotRuntime::Main(const int argc, char* argv[], const AotProgram& program) {
+    std::string input_path;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+
+        if ((argument == "-i" || argument == "--input") && i + 1 < argc) {
+            input_path = argv[++i];
+        } else if (argument == "-q" || argument == "--quiet") {
+            quiet = true;
+        } else if (argument == "-h" || argument == "--help") {
+            PrintUsage(std::cout, argv[0]);
+            return SUCCESS;
+        } else {
+            PrintUsage(std::cerr, argv[0]);
+            return LOAD_ERROR;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    StreamIo io(std::cin, std::cout);
+
+    std::optional<InputFeedIo> input_feed;
+    if (!input_path.empty()) {
+        std::ifstream file(input_path, std::ios::binary);
+        if (!file) {
+            std::cerr << std::format("Cannot open file {}", input_path) << std::endl;
+            return LOAD_ERROR;
+        }
+
+        try {
+            const std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            std::istringstream input(content);
+            input_feed.emplace(InputFeedIo::Parse(input), io);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return LOAD_ERROR;
+        }
+    }
+
+    AotRuntime runtime(program, input_feed ? static_cast<ProcessorIo&>(*input_feed) : io);
+
+    int exit_code = SUCCESS;
+    std::string status = "halted";
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        runtime.Run();
+    } catch (const std::exception& e) {
+        exit_code = RUNTIME_ERROR;
+        status = std::format("error ({})", e.what());
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    io.Flush();
+
+    if (!quiet) {
+        std::cerr << std::format("\nstatus: {}\ninstructions: {}\ntime: {:.3f} ms\n",
+                                 status, runtime.GetInstructionCount(), elapsed.count());
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,283 @@
+#include "core/aot_translator.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "core/program_image.hpp"
+
+namespace {
+    constexpr std::array<const char*, 4> VALUE_TYPES = {"snm::Byte", "snm::Word", "snm::SignedWord", "snm::Real"};
+    constexpr std::array<const char*, 4> IO_TYPES = {
+        "snm::Type::BYTE", "snm::Type::WORD", "snm::Type::SIGNED_WORD", "snm::Type::REAL"
+    };
+    constexpr std::array<const char*, 4> TYPE_MODIFIERS = {"C", "W", "SW", "R"};
+    constexpr std::array<const char*, 4> ARG_MODIFIERS = {"", "& ", "&& ", ""};
+
+    bool IsIdentifier(const std::string& name) {
+        const auto is_word = [](const char c) {
+            return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        };
+        return !name.empty() && !(name[0] >= '0' && name[0] <= '9') && std::ranges::all_of(name, is_word);
+    }
+
+    /**
+     * @brief Генератор тела функции программы.
+     */
+    class FunctionWriter {
+    public:
+        FunctionWriter(const ProgramImage& image, std::string& out) :
+            image_(image),
+            out_(out) {
+        }
+
+        void Write(const std::multimap<snm::Address, std::string>& labels) {
+            Line(4, "void Run(AotRuntime& runtime) {");
+            Line(8, "snm::Bytes acc = runtime.GetRegisters().accumulator;");
+            Line(8, "snm::Bytes aux = runtime.GetRegisters().auxiliary;");
+            Line(8, "snm::Address ip = runtime.GetRegisters().instruction_pointer;");
+            Line(8, "uint64_t count = runtime.GetInstructionCount();");
+            Line(0, "");
+            Line(8, "try {");
+            Line(12, "goto dispatch;");
+
+            for (size_t address = 0; address < image_.Size(); ++address) {
+                Line(0, "");
+                const auto [first, last] = labels.equal_range(static_cast<snm::Address>(address));
+                for (auto label = first; label != last; ++label) {
+                    Line(8, std::format("// {}:", label->second));
+                }
+                WriteInstruction(static_cast<snm::Address>(address));
+            }
+
+            Line(0, "");
+            Line(8, "halt:");
+            Line(12, "runtime.Finish({acc, aux, ip}, count);");
+            Line(12, "return;");
+            Line(8, "interpret:");
+            Line(12, "runtime.Interpret({acc, aux, ip}, count);");
+            Line(12, "return;");
+            Line(8, "dispatch:");
+            Line(12, "switch (ip) {");
+            for (size_t address = 0; address < image_.Size(); ++address) {
+                Line(12, std::format("case {0}: goto L{0};", address));
+            }
+            Line(12, "default: goto halt;");
+            Line(12, "}");
+            Line(8, "} catch (...) {");
+            Line(12, "runtime.Finish({acc, aux, ip}, count);");
+            Line(12, "throw;");
+            Line(8, "}");
+            Line(4, "}");
+        }
+
+    private:
+        const ProgramImage& image_;
+        std::string& out_;
+
+        void Line(const size_t indent, const std::string_view text) {
+            if (!text.empty()) {
+                out_.append(indent, ' ');
+                out_ += text;
+            }
+            out_ += '\n';
+        }
+
+        /**
+         * @brief Переход на адрес. Адрес за пределами программы останавливает её, как SetInstructionPointer().
+         */
+        [[nodiscard]] std::string Goto(const snm::Address target) const {
+            if (target < image_.Size()) {
+                return std::format("goto L{};", target);
+            }
+            return std::format("{{ ip = {}; goto halt; }}", target);
+        }
+
+        void WriteInstruction(const snm::Address address) {
+            const auto [code, argument_bytes] = image_.GetCell(address);
+            const auto argument = static_cast<snm::Word>(argument_bytes);
+            const auto opcode = static_cast<snm::OpCode>(code >> 4);
+            const size_t type = code >> 2 & 0b11;
+            // Модификатор 0b11 не определён, и Processor исполняет его как snm::ArgModifier::NONE
+            const auto arg_modifier = (code & 0b11) == 0b11 ? snm::ArgModifier::NONE
+                                                            : static_cast<snm::ArgModifier>(code & 0b11);
+            const auto next = static_cast<snm::Address>(address + 1);
+
+            if (code == std::numeric_limits<snm::Byte>::max()) {
+                Line(8, std::format("L{}: // HALT", address));
+            } else if (code == snm::END_OF_CODE || !snm::OPCODE_PROPERTIES.contains(opcode)) {
+                Line(8, std::format("L{}:", address));
+            } else {
+                Line(8, std::format("L{}: // {} {} {}0x{:x}", address, snm::OPCODE_PROPERTIES.at(opcode).name,
+                                    TYPE_MODIFIERS[type], ARG_MODIFIERS[code & 0b11], argument));
+            }
+
+            // Ячейка с кодом snm::END_OF_CODE останавливает программу и не считается инструкцией
+            if (code == snm::END_OF_CODE) {
+                Line(12, std::format("ip = {};", address));
+                Line(12, "goto halt;");
+                return;
+            }
+
+            Line(12, "++count;");
+
+            if (code == std::numeric_limits<snm::Byte>::max()) {
+                Line(12, std::format("ip = {};", address));
+                Line(12, "goto halt;");
+                return;
+            }
+
+            // Аргумент NOPE читается из памяти: такие ячейки изменяются без перехода к интерпретатору
+            if (opcode == snm::OpCode::NOPE && arg_modifier == snm::ArgModifier::NONE) {
+                Line(12, std::format("aux = runtime.Read({});", address));
+            } else if (opcode == snm::OpCode::NOPE && arg_modifier == snm::ArgModifier::REF) {
+                Line(12, std::format("aux = runtime.Read(static_cast<snm::Address>(static_cast<snm::Word>("
+                                     "runtime.Read({}))));", address));
+            } else if (opcode == snm::OpCode::NOPE && arg_modifier == snm::ArgModifier::REF_REF) {
+                Line(12, std::format("aux = runtime.Read(static_cast<snm::Address>(static_cast<snm::Word>("
+                                     "runtime.Read(static_cast<snm::Address>(static_cast<snm::Word>("
+                                     "runtime.Read({})))))));", address));
+            } else if (arg_modifier == snm::ArgModifier::REF) {
+                Line(12, std::format("aux = runtime.Read({});", static_cast<snm::Address>(argument)));
+            } else if (arg_modifier == snm::ArgModifier::REF_REF) {
+                Line(12, std::format("aux = runtime.Read(static_cast<snm::Address>(static_cast<snm::Word>("
+                                     "runtime.Read({}))));", static_cast<snm::Address>(argument)));
+            } else {
+                Line(12, std::format("aux = snm::Bytes(0x{:x}u);", argument));
+            }
+
+            if (!snm::IsInstructionDefined(opcode, static_cast<snm::TypeModifier>(type))) {
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("throw std::runtime_error(\"Error while executing: instruction {} at {} undefined\");",
+                                     std::bitset<8>(code & 0b11111100).to_string(), address));
+                return;
+            }
+
+            const char* value_type = VALUE_TYPES[type];
+            const bool static_argument = arg_modifier == snm::ArgModifier::NONE;
+
+            switch (opcode) {
+            case snm::OpCode::NOPE:
+                break;
+            case snm::OpCode::ADD:
+                Line(12, std::format("acc = snm::aot::Add<{}>(acc, aux);", value_type));
+                break;
+            case snm::OpCode::SUB:
+                Line(12, std::format("acc = snm::aot::Sub<{}>(acc, aux);", value_type));
+                break;
+            case snm::OpCode::MUL:
+                Line(12, std::format("acc = snm::aot::Mul<{}>(acc, aux);", value_type));
+                break;
+            case snm::OpCode::DIV:
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("acc = snm::aot::Div<{}>(acc, aux);", value_type));
+                break;
+            case snm::OpCode::MOD:
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("acc = snm::aot::Mod<{}>(acc, aux);", value_type));
+                break;
+            case snm::OpCode::LOAD:
+                Line(12, std::format("acc = snm::aot::Load<{}>(aux);", value_type));
+                break;
+            case snm::OpCode::STORE:
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("if (runtime.Store(acc, aux, {})) [[unlikely]] {{ ip = {}; goto interpret; }}",
+                                     address, next));
+                break;
+            case snm::OpCode::INPUT:
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("acc = runtime.Input({});", IO_TYPES[type]));
+                break;
+            case snm::OpCode::OUTPUT:
+                Line(12, std::format("ip = {};", address));
+                Line(12, std::format("runtime.Output(acc, {});", IO_TYPES[type]));
+                break;
+            case snm::OpCode::JUMP:
+                if (static_argument) {
+                    Line(12, Goto(static_cast<snm::Address>(argument)));
+                } else {
+                    Line(12, "ip = static_cast<snm::Address>(static_cast<snm::Word>(aux));");
+                    Line(12, "goto dispatch;");
+                }
+                return;
+            case snm::OpCode::JUMPNSTORE:
+                Line(12, "ip = static_cast<snm::Address>(static_cast<snm::Word>(aux) + 1);");
+                Line(12, std::format("if (runtime.Write(snm::Bytes({}), static_cast<snm::Address>("
+                                     "static_cast<snm::Word>(aux)))) [[unlikely]] {{", address + 1));
+                Line(16, "goto interpret;");
+                Line(12, "}");
+                if (static_argument) {
+                    Line(12, Goto(static_cast<snm::Address>(argument + 1)));
+                } else {
+                    Line(12, "goto dispatch;");
+                }
+                return;
+            case snm::OpCode::SKIP_LOWER:
+            case snm::OpCode::SKIP_GREATER:
+            case snm::OpCode::SKIP_EQUAL: {
+                const char* compare = opcode == snm::OpCode::SKIP_LOWER     ? "Lower"
+                                      : opcode == snm::OpCode::SKIP_GREATER ? "Greater"
+                                                                            : "Equal";
+                Line(12, std::format("if (snm::aot::{}<{}>(acc, aux)) {}", compare, value_type,
+                                     Goto(static_cast<snm::Address>(address + 2))));
+                break;
+            }
+            case snm::OpCode::HALT:
+                break;
+            }
+
+            // Следующая ячейка идёт в тексте сразу за текущей, кроме перехода с последнего адреса на нулевой
+            if (next != address + 1 || next >= image_.Size()) {
+                Line(12, Goto(next));
+            }
+        }
+    };
+}
+
+std::string AotTranslator::Translate(const std::span<const snm::Byte> byte_code, const std::string& name,
+                                     const snm::LabelMap& labels) {
+    if (!name.empty() && !IsIdentifier(name)) {
+        throw std::invalid_argument(std::format("Invalid program name {}", name));
+    }
+
+    const ProgramImage image(byte_code);
+
+    std::multimap<snm::Address, std::string> labels_by_address;
+    for (const auto& [label, address] : labels) {
+        labels_by_address.emplace(address, label);
+    }
+
+    std::string out = "// SANDM program translated by sandm-aot. Do not edit.\n"
+        "#include <array>\n"
+        "\n"
+        "#include \"core/aot_runtime.hpp\"\n"
+        "\n"
+        "namespace {\n";
+
+    std::format_to(std::back_inserter(out), "    constexpr std::array<snm::Byte, {}> BYTE_CODE = {{", byte_code.size());
+    for (size_t i = 0; i < byte_code.size(); ++i) {
+        out += i % 5 == 0 ? "\n        " : " ";
+        std::format_to(std::back_inserter(out), "0x{:02x},", byte_code[i]);
+    }
+    out += "\n    };\n\n";
+
+    FunctionWriter(image, out).Write(labels_by_address);
+
+    out += "}\n\n";
+
+    if (name.empty()) {
+        out += "int main(int argc, char* argv[]) {\n"
+            "    return AotRuntime::Main(argc, argv, {BYTE_CODE, Run});\n"
+            "}\n";
+    } else {
+        std::format_to(std::back_inserter(out), "extern const AotProgram {0};\nconst AotProgram {0}{{BYTE_CODE, Run}};\n",
+                       name);
+    }
+
+    return out;
+}
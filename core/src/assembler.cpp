@@ -1,33 +1,176 @@
 #include "../include/core/assembler.hpp"
 
-Assembler::Assembler() :
-    line_number_(0) {
-    for (const auto& [opcode, properties] : snm::OPCODE_PROPERTIES) {
-        opcode_map_.insert({properties.name, opcode});
-    }
-
-    type_modifier_map_ = {
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+namespace {
+    /**
+     * @brief Модификаторы типа и их обозначения в исходном коде в верхнем регистре.
+     */
+    constexpr std::array<std::pair<std::string_view, snm::TypeModifier>, 4> TYPE_MODIFIERS = {{
         {"C", snm::TypeModifier::C},
         {"W", snm::TypeModifier::W},
         {"SW", snm::TypeModifier::SW},
         {"R", snm::TypeModifier::R}
-    };
+    }};
 
-    arg_modifier_map_ = {
+    /**
+     * @brief Модификаторы аргумента и их обозначения в исходном коде.
+     */
+    constexpr std::array<std::pair<std::string_view, snm::ArgModifier>, 2> ARG_MODIFIERS = {{
         {"&", snm::ArgModifier::REF},
         {"&&", snm::ArgModifier::REF_REF}
-    };
+    }};
+
+    bool IsDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    int HexDigit(const char c) {
+        if (IsDigit(c)) {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Проверяет, что строка непуста и состоит только из десятичных цифр.
+     */
+    bool IsDigits(const std::string_view str) {
+        return !str.empty() && std::ranges::all_of(str, IsDigit);
+    }
+
+    /**
+     * @brief Записывает 32-битное значение в аргумент побайтово, начиная с младшего байта.
+     */
+    snm::Bytes WordToBytes(const uint32_t num) {
+        snm::Bytes result;
+
+        for (size_t i = 0; i < snm::ARGUMENT_SIZE; ++i) {
+            result[i] = static_cast<uint8_t>(num >> (8 * i) & 0xFF);
+        }
+
+        return result;
+    }
+}
+
+/**
+ * @brief Последовательно читает токены строки, разделённые пробельными символами.
+ *
+ * Токены возвращаются как части исходной строки без копирования. Позицию чтения можно
+ * запомнить и восстановить, чтобы вернуть прочитанный токен.
+ */
+class Assembler::Tokenizer {
+public:
+    explicit Tokenizer(const std::string_view line) :
+        line_(line) {
+    }
+
+    /**
+     * @brief Читает следующий токен.
+     * @param token Прочитанный токен.
+     * @return false, если токенов больше нет.
+     */
+    bool Next(std::string_view& token) {
+        if (exhausted_) {
+            return false;
+        }
+
+        while (position_ < line_.size() && IsSpace(line_[position_])) {
+            ++position_;
+        }
+
+        if (position_ == line_.size()) {
+            return false;
+        }
+
+        const size_t begin = position_;
+        while (position_ < line_.size() && !IsSpace(line_[position_])) {
+            ++position_;
+        }
+
+        token = line_.substr(begin, position_ - begin);
+        return true;
+    }
+
+    /**
+     * @brief Читает следующий символ без пропуска пробелов.
+     *
+     * Последовательность пробелов и табуляций читается как один пробел.
+     *
+     * Попытка прочитать символ за концом строки завершает чтение: последующие вызовы Next
+     * возвращают false, а Restore не действует.
+     *
+     * @param c Прочитанный символ.
+     * @return false, если строка закончилась.
+     */
+    bool NextChar(char& c) {
+        if (exhausted_ || position_ == line_.size()) {
+            exhausted_ = true;
+            return false;
+        }
+
+        c = line_[position_++];
+
+        if (c == ' ' || c == '\t') {
+            c = ' ';
+            while (position_ < line_.size() && (line_[position_] == ' ' || line_[position_] == '\t')) {
+                ++position_;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] size_t Position() const {
+        return position_;
+    }
+
+    void Restore(const size_t position) {
+        if (!exhausted_) {
+            position_ = position;
+        }
+    }
+
+private:
+    std::string_view line_; ///< Разбираемая строка
+    size_t position_ = 0; ///< Позиция первого непрочитанного символа
+    bool exhausted_ = false; ///< Была попытка чтения символа за концом строки
+
+    static bool IsSpace(const char c) {
+        return std::isspace(static_cast<unsigned char>(c));
+    }
+};
+
+Assembler::Assembler() :
+    line_number_(0) {
+    for (const auto& [opcode, properties] : snm::OPCODE_PROPERTIES) {
+        opcodes_.emplace_back(properties.name, opcode);
+    }
 }
 
 snm::ByteCode Assembler::Compile(const std::string& source) {
-    return CompileInternal(source).first;
+    return CompileInternal(source).byte_code;
 }
 
 std::pair<snm::ByteCode, snm::SourceToBytecodeMap> Assembler::CompileWithDebugInfo(const std::string& source) {
+    auto [byte_code, _, source_map] = CompileInternal(source);
+    return {std::move(byte_code), std::move(source_map)};
+}
+
+Program Assembler::CompileProgram(const std::string& source) {
     return CompileInternal(source);
 }
 
-std::pair<snm::ByteCode, snm::SourceToBytecodeMap> Assembler::CompileInternal(const std::string& source) {
+Program Assembler::CompileInternal(const std::string& source) {
     auto [instructions, labels, errors] = ParseSource(source);
     if (!errors.empty()) {
         throw std::runtime_error(std::accumulate(errors.begin(), errors.end(), std::string(),
@@ -40,14 +183,16 @@ std::pair<snm::ByteCode, snm::SourceToBytecodeMap> Assembler::CompileInternal(co
     snm::SourceToBytecodeMap map;
     snm::Address current_addr = 0;
 
+    byte_code.reserve(instructions.size() * (snm::ARGUMENT_SIZE + 1));
+
     for (auto& instr : instructions) {
         if (instr.using_label_name) {
-            auto label = ToUpper(*instr.using_label_name);
-            if (!labels.contains(label)) {
-                throw Exception<std::runtime_error>(std::format("Label {} does not exist", *instr.using_label_name),
-                                                    instr.line_number);
+            const std::string label = ToUpper(*instr.using_label_name);
+            const auto it = labels.find(label);
+            if (it == labels.end()) {
+                throw Exception<std::runtime_error>(std::format("Label {} does not exist", label), instr.line_number);
             }
-            instr.argument = labels[label];
+            instr.argument = it->second;
         }
 
         byte_code.push_back(snm::InstructionByte(instr.opcode, instr.type_modifier, instr.argument_modifier));
@@ -56,7 +201,7 @@ std::pair<snm::ByteCode, snm::SourceToBytecodeMap> Assembler::CompileInternal(co
         map[instr.line_number] = current_addr++;
     }
 
-    return {byte_code, map};
+    return {std::move(byte_code), std::move(labels), std::move(map)};
 }
 
 std::vector<std::string> Assembler::TestSource(const std::string& source) {
@@ -64,16 +209,16 @@ std::vector<std::string> Assembler::TestSource(const std::string& source) {
     return errors;
 }
 
-std::tuple<std::vector<Instruction>, std::unordered_map<std::string, snm::Address>, std::vector<std::string>>
+std::tuple<std::vector<Instruction>, snm::LabelMap, std::vector<std::string>>
 Assembler::ParseSource(const std::string& source) {
     std::vector<Instruction> instructions;
-    std::unordered_map<std::string, snm::Address> labels;
+    snm::LabelMap labels;
     std::vector<std::string> errors;
     line_number_ = 0;
     snm::Address address = 0;
 
-    std::istringstream stream(source);
-    for (std::string line; !(line = GetLine(stream)).empty();) {
+    std::string_view rest = source;
+    for (std::string_view line; !(line = GetLine(rest)).empty();) {
         if (address == std::numeric_limits<snm::Address>::max()) {
             errors.emplace_back("Too many instructions: address overflow");
             break;
@@ -82,12 +227,11 @@ Assembler::ParseSource(const std::string& source) {
         try {
             Instruction instr = GetInstruction(line);
             if (instr.label_name) {
-                auto name = ToUpper(*instr.label_name);
-                if (labels.contains(name)) {
+                if (labels.contains(*instr.label_name)) {
                     errors.push_back(std::format("Line {}: Label {} already exists", instr.line_number,
                                                  *instr.label_name));
                 } else {
-                    labels[name] = address;
+                    labels.emplace(*instr.label_name, address);
                 }
             }
             instructions.push_back(std::move(instr));
@@ -101,14 +245,20 @@ Assembler::ParseSource(const std::string& source) {
     return {instructions, labels, errors};
 }
 
-std::string Assembler::GetLine(std::istringstream& stream) {
-    std::string line;
-    while (std::getline(stream, line)) {
+std::string_view Assembler::GetLine(std::string_view& source) {
+    while (!source.empty()) {
+        const size_t end = source.find('\n');
+        std::string_view line = source.substr(0, end);
+        source.remove_prefix(end == std::string_view::npos ? source.size() : end + 1);
+
         ++line_number_;
         line = Trim(RemoveComment(line));
-        if (!line.empty()) break;
+        if (!line.empty()) {
+            return line;
+        }
     }
-    return line;
+
+    return {};
 }
 
 template <typename T>
@@ -121,198 +271,191 @@ T Assembler::Exception(const std::string& message, unsigned int line_number) {
     return T(std::format("Line {}: {}", line_number, message));
 }
 
-Instruction Assembler::GetInstruction(const std::string& line) {
+Instruction Assembler::GetInstruction(const std::string_view line) {
     Instruction instr;
     instr.line_number = line_number_;
 
-    std::istringstream stream(line);
-    std::string token;
+    Tokenizer tokens(line);
+    std::string_view token;
 
     // Разбор метки
-    if (stream >> token && token.ends_with(':')) {
-        instr.label_name = token.substr(0, token.size() - 1);
-        if (!IsValidLabelName(*instr.label_name)) {
-            throw Exception<std::invalid_argument>(std::format("Invalid label name: {}", *instr.label_name));
+    size_t position = tokens.Position();
+    if (tokens.Next(token) && token.ends_with(':')) {
+        const std::string_view name = token.substr(0, token.size() - 1);
+        if (!IsValidLabelName(name)) {
+            throw Exception<std::invalid_argument>(std::format("Invalid label name: {}", name));
         }
+        instr.label_name = ToUpper(name);
     } else {
-        stream.seekg(-static_cast<int>(token.size()), std::ios_base::cur);
+        tokens.Restore(position);
     }
 
     // Опкод
-    if (stream >> token && opcode_map_.contains(ToUpper(token))) {
-        instr.opcode = opcode_map_[ToUpper(token)];
-    } else {
-        stream.seekg(-static_cast<int>(token.size()), std::ios_base::cur);
+    position = tokens.Position();
+    if (tokens.Next(token)) {
+        if (const auto opcode = FindOpCode(token)) {
+            instr.opcode = *opcode;
+        } else {
+            tokens.Restore(position);
+        }
     }
 
     // Модификаторы типа и аргумента
-    ParseModifiers(stream, instr);
+    ParseModifiers(tokens, instr);
 
     // Аргумент
-    ParseArgument(stream, instr);
+    ParseArgument(tokens, instr);
 
     // Ошибка при наличии лишних токенов
-    if (stream >> token) {
-        throw Exception<std::runtime_error>(std::format("Invalid instruction: {}", line));
+    if (tokens.Next(token)) {
+        throw Exception<std::runtime_error>(std::format("Invalid instruction: {}", NormalizeLine(line)));
     }
 
     if (snm::OPCODE_PROPERTIES.at(instr.opcode).is_argument_required
         && !instr.argument
         && !instr.using_label_name) {
-        throw Exception<std::runtime_error>(std::format("Argument is required for instruction: {}", line));
+        throw Exception<std::runtime_error>(std::format("Argument is required for instruction: {}",
+                                                        NormalizeLine(line)));
     }
 
     return instr;
 }
 
-void Assembler::ParseModifiers(std::istringstream& stream, Instruction& instr) {
-    std::string token;
+void Assembler::ParseModifiers(Tokenizer& tokens, Instruction& instr) {
+    const auto& props = snm::OPCODE_PROPERTIES.at(instr.opcode);
+    std::string_view token;
 
-    if (stream >> token) {
-        const auto upper = ToUpper(token);
-        if (type_modifier_map_.contains(upper)) {
-            const auto mod = type_modifier_map_[upper];
-            if (!snm::OPCODE_PROPERTIES.at(instr.opcode).allowed_type_modifiers.contains(mod)) {
-                throw Exception<std::domain_error>(std::format("Modifier {} cannot be used", token));
+    size_t position = tokens.Position();
+    if (tokens.Next(token)) {
+        if (const auto mod = FindTypeModifier(token)) {
+            if (!props.allowed_type_modifiers.contains(*mod)) {
+                throw Exception<std::domain_error>(std::format("Modifier {} cannot be used", ToUpper(token)));
             }
-            instr.type_modifier = mod;
+            instr.type_modifier = *mod;
         } else {
             // Используем тип по умолчанию
-            const auto& props = snm::OPCODE_PROPERTIES.at(instr.opcode);
             instr.type_modifier = props.allowed_type_modifiers.contains(snm::TypeModifier::SW)
                 ? snm::TypeModifier::SW
                 : snm::TypeModifier::W;
-            stream.seekg(-static_cast<int>(token.size()), std::ios_base::cur);
+            tokens.Restore(position);
         }
     }
 
-    if (stream >> token) {
-        const auto upper = ToUpper(token);
-        if (arg_modifier_map_.contains(upper)) {
-            const auto mod = arg_modifier_map_[upper];
-            if (!snm::OPCODE_PROPERTIES.at(instr.opcode).allowed_arg_modifiers.contains(mod)) {
+    position = tokens.Position();
+    if (tokens.Next(token)) {
+        if (const auto mod = FindArgModifier(token)) {
+            if (!props.allowed_arg_modifiers.contains(*mod)) {
                 throw Exception<std::domain_error>(std::format("Modifier {} cannot be used", token));
             }
-            instr.argument_modifier = mod;
+            instr.argument_modifier = *mod;
         } else {
-            stream.seekg(-static_cast<int>(token.size()), std::ios_base::cur);
+            tokens.Restore(position);
         }
     }
 }
 
-void Assembler::ParseArgument(std::istringstream& stream, Instruction& instr) {
+void Assembler::ParseArgument(Tokenizer& tokens, Instruction& instr) {
     if (!snm::OPCODE_PROPERTIES.at(instr.opcode).is_argument_available) return;
 
-    std::string token;
-    if (!(stream >> token)) return;
-
-    // Обработка символа
-    if (token == "'" && stream.peek() != EOF) {
-        char next;
-        token.clear();
-        token += "'";
-        stream.get(next);
-        token += next;
-        if (stream.get(next)) token += next;
+    const size_t position = tokens.Position();
+    std::string_view token;
+    if (!tokens.Next(token)) return;
+
+    // Обработка символа, отделённого пробелом от кавычки, например ' '
+    std::array<char, 3> literal{};
+    if (char next; token == "'" && tokens.NextChar(next)) {
+        size_t size = 0;
+        literal[size++] = '\'';
+        literal[size++] = next;
+        if (tokens.NextChar(next)) literal[size++] = next;
+        token = std::string_view(literal.data(), size);
     }
 
     if (IsValidLabelName(token)) {
-        instr.using_label_name = token;
+        instr.using_label_name = std::string(token);
     } else if (IsValidChar(token)) {
         instr.argument = static_cast<int>(token[1]);
+    } else if (const auto number = ParseNumber(token, instr.type_modifier)) {
+        instr.argument = *number;
     } else {
-        try {
-            instr.argument = ParseNumber(token, instr.type_modifier);
-        } catch (...) {
-            stream.seekg(-static_cast<int>(token.size()), std::ios_base::cur);
-        }
+        tokens.Restore(position);
     }
 }
 
-bool Assembler::IsArgumentModifier(std::string& token) const {
-    return arg_modifier_map_.contains(ToUpper(token));
-}
+std::optional<snm::OpCode> Assembler::FindOpCode(const std::string_view token) const {
+    for (const auto& [name, opcode] : opcodes_) {
+        if (EqualsIgnoreCase(token, name)) {
+            return opcode;
+        }
+    }
 
-bool Assembler::IsTypeModifier(std::string& token) const {
-    return type_modifier_map_.contains(ToUpper(token));
+    return std::nullopt;
 }
 
-void Assembler::ValidateStringNumber(const std::string& str) {
-    if (str.size() >= 2 && str.substr(0, 2) == "0b") {
-        if (const std::regex binary_regex("^0b[01]+$"); !std::regex_match(str, binary_regex)) {
-            throw Exception<std::invalid_argument>(
-                std::format("Invalid binary string {}: only '0' and '1' are allowed after '0b'", str));
-        }
-    }
-    // Проверка на шестнадцатеричную строку (начинается с "0x")
-    else if (str.size() >= 2 && str.substr(0, 2) == "0x") {
-        if (const std::regex hex_regex("^0x[0-9A-Fa-f]+$"); !std::regex_match(str, hex_regex)) {
-            throw Exception<std::invalid_argument>(
-                std::format("Invalid hex string {}: only digits (0-9, A-F) are allowed after '0x'", str));
-        }
-    }
-    // Проверка на число с плавающей точкой (содержит ".")
-    else if (str.find('.') != std::string::npos) {
-        if (const std::regex float_regex("^-?[0-9]+\\.[0-9]+$"); !std::regex_match(str, float_regex)) {
-            throw Exception<std::invalid_argument>(
-                std::format("Invalid float string {}: only digits (0-9), one '.', and optional '-' "
-                    "at the start are allowed", str));
+std::optional<snm::TypeModifier> Assembler::FindTypeModifier(const std::string_view token) {
+    for (const auto& [name, modifier] : TYPE_MODIFIERS) {
+        if (EqualsIgnoreCase(token, name)) {
+            return modifier;
         }
     }
-    // Проверка на целое число (без ".")
-    else {
-        if (const std::regex int_regex("^-?[0-9]+$"); !std::regex_match(str, int_regex)) {
-            throw Exception<std::invalid_argument>(
-                std::format("Invalid integer string {}: only digits (0-9) and optional '-' at the "
-                "start are allowed", str));
+
+    return std::nullopt;
+}
+
+std::optional<snm::ArgModifier> Assembler::FindArgModifier(const std::string_view token) {
+    for (const auto& [name, modifier] : ARG_MODIFIERS) {
+        if (token == name) {
+            return modifier;
         }
     }
-}
 
-std::string Assembler::Trim(const std::string& str) {
+    return std::nullopt;
+}
 
+std::string_view Assembler::Trim(const std::string_view str) {
     const auto left = str.find_first_not_of(" \t");
     const auto right = str.find_last_not_of(" \t");
 
-    if (left == std::string::npos) {
-        return "";
+    if (left == std::string_view::npos) {
+        return {};
     }
 
-    std::string result = str.substr(left, right - left + 1);
+    return str.substr(left, right - left + 1);
+}
+
+std::string Assembler::NormalizeLine(const std::string_view line) {
+    std::string result;
+    result.reserve(line.size());
 
-    const std::string whitespace = " \t";
     bool in_whitespace = false;
 
-    for (size_t i = 0; i < result.length(); ) {
-        if (whitespace.find(result[i]) != std::string::npos) {
-            if (in_whitespace) {
-                result.erase(i, 1);
-            } else {
-                result[i] = ' ';
+    for (const char c : line) {
+        if (c == ' ' || c == '\t') {
+            if (!in_whitespace) {
+                result += ' ';
                 in_whitespace = true;
-                ++i;
             }
         } else {
+            result += c;
             in_whitespace = false;
-            ++i;
         }
     }
 
     return result;
 }
 
-bool Assembler::IsValidLabelName(const std::string& name) {
+bool Assembler::IsValidLabelName(const std::string_view name) {
     if (name.empty()) {
         return false;
     }
 
-    if (name[0] != '_' && !std::isalpha(name[0])) {
+    if (name[0] != '_' && !std::isalpha(static_cast<unsigned char>(name[0]))) {
         return false;
     }
 
     if (std::ranges::any_of(
         name, [](const char c) {
-            return c != '_' && !std::isalnum(c);
+            return c != '_' && !std::isalnum(static_cast<unsigned char>(c));
         })) {
         return false;
     }
@@ -320,7 +463,7 @@ bool Assembler::IsValidLabelName(const std::string& name) {
     return true;
 }
 
-bool Assembler::IsValidChar(const std::string& token) {
+bool Assembler::IsValidChar(const std::string_view token) {
     if (token.size() != 3
         || token[0] != '\'' || token[2] != '\'') {
 
@@ -330,95 +473,105 @@ bool Assembler::IsValidChar(const std::string& token) {
     return true;
 }
 
-bool Assembler::IsNumberValidForType(const snm::Bytes bytes, const snm::TypeModifier type_modifier) {
-    switch (type_modifier) {
-    case snm::TypeModifier::C:
-    {
-        const auto value = static_cast<uint64_t>(bytes);
-        return value >= std::numeric_limits<snm::Byte>::min() && value <= std::numeric_limits<snm::Byte>::max();
-    }
-    case snm::TypeModifier::W:
-    {
-        const auto value = static_cast<uint64_t>(bytes);
-        return value >= std::numeric_limits<snm::Word>::min() && value <= std::numeric_limits<snm::Word>::max();
-    }
-    case snm::TypeModifier::SW:
-    {
-        const auto value = static_cast<int64_t>(bytes);
-        return value >= std::numeric_limits<snm::SignedWord>::min() && value <= std::numeric_limits<
-            snm::SignedWord>::max();
-    }
-    case snm::TypeModifier::R: {
-        const auto value = static_cast<double>(bytes);
-        return value >= std::numeric_limits<snm::Real>::min() && value <= std::numeric_limits<snm::Real>::max();
-    }
-    default:
-        return false;
-    }
-}
+std::optional<snm::Bytes> Assembler::ParseNumber(const std::string_view str, const snm::TypeModifier type_modifier) {
+    if (str.starts_with("0b")) {
+        const std::string_view digits = str.substr(2);
+        if (digits.empty() || digits.size() > snm::ARGUMENT_SIZE * 8
+            || !std::ranges::all_of(digits, [](const char c) { return c == '0' || c == '1'; })) {
+            return std::nullopt;
+        }
+
+        uint32_t num = 0;
+        for (const char c : digits) {
+            num = num << 1 | static_cast<uint32_t>(c - '0');
+        }
 
-snm::Bytes Assembler::ParseNumber(const std::string& str, const snm::TypeModifier& type_modifier) {
-    ValidateStringNumber(str);
+        return WordToBytes(num);
+    }
 
-    snm::Bytes result;
+    if (str.starts_with("0x")) {
+        const std::string_view digits = str.substr(2);
+        if (digits.empty() || digits.size() > snm::ARGUMENT_SIZE * 2
+            || !std::ranges::all_of(digits, [](const char c) { return HexDigit(c) >= 0; })) {
+            return std::nullopt;
+        }
 
-    if (str.starts_with("0b")) {
-        std::string binary_string = str.substr(2); // Убираем "0b"
-        if (binary_string.size() > snm::ARGUMENT_SIZE * 8) {
-            throw Exception<std::out_of_range>(
-                std::format("Binary string {} is too long (max {} bits)", str, std::to_string(snm::ARGUMENT_SIZE * 8)));
+        uint32_t num = 0;
+        for (const char c : digits) {
+            num = num << 4 | static_cast<uint32_t>(HexDigit(c));
         }
 
-        // Дополняем строку нулями слева
-        binary_string.insert(binary_string.begin(), snm::ARGUMENT_SIZE * 8 - binary_string.size(), '0');
-        const std::bitset<snm::ARGUMENT_SIZE * 8> bits(binary_string);
-        const uint32_t num = bits.to_ulong();
+        return WordToBytes(num);
+    }
 
-        for (size_t i = 0; i < snm::ARGUMENT_SIZE; ++i) {
-            result[i] = static_cast<uint8_t>(num >> (8 * i) & 0xFF);
+    // Десятичное число: -?[0-9]+ или -?[0-9]+.[0-9]+
+    const bool negative = str.starts_with('-');
+    const std::string_view unsigned_part = negative ? str.substr(1) : str;
+    const size_t dot = unsigned_part.find('.');
+    const std::string_view integer_part = unsigned_part.substr(0, dot);
+
+    if (!IsDigits(integer_part)
+        || (dot != std::string_view::npos && !IsDigits(unsigned_part.substr(dot + 1)))) {
+        return std::nullopt;
+    }
+
+    if (type_modifier == snm::TypeModifier::R) {
+        // strtof требует завершающий ноль, длинные литералы встречаются редко
+        std::array<char, 64> buffer{};
+        std::string long_literal;
+        const char* literal = buffer.data();
+
+        if (str.size() < buffer.size()) {
+            std::ranges::copy(str, buffer.begin());
+        } else {
+            long_literal = std::string(str);
+            literal = long_literal.c_str();
         }
-    } else if (str.starts_with("0x")) {
-        // Обработка шестнадцатеричной строки
-        std::string hex_string = str.substr(2); // Убираем "0x"
-        if (hex_string.size() > snm::ARGUMENT_SIZE * 2) {
-            throw Exception<std::out_of_range>(
-                std::format("Hex string {} is too long (max {} nibbles)", str, std::to_string(snm::ARGUMENT_SIZE * 2)));
+
+        errno = 0;
+        const float value = std::strtof(literal, nullptr);
+        if (errno == ERANGE) {
+            return std::nullopt;
         }
 
-        // Дополняем строку нулями слева
-        hex_string.insert(hex_string.begin(), snm::ARGUMENT_SIZE * 2 - hex_string.size(),
-                          '0');
+        return snm::Bytes(value);
+    }
 
-        // Преобразуем шестнадцатеричную строку в число
-        uint32_t num;
-        std::stringstream ss;
-        ss << std::hex << hex_string;
-        ss >> num;
+    // Целое число. В данном случае не имеет значения, какой тип аргумента.
+    // Дробная часть отбрасывается, а знак применяется с переполнением, как в std::stoul.
+    constexpr auto max = std::numeric_limits<unsigned long>::max();
+    unsigned long value = 0;
 
-        for (size_t i = 0; i < snm::ARGUMENT_SIZE; ++i) {
-            result[i] = static_cast<uint8_t>(num >> (8 * i) & 0xFF);
+    for (const char c : integer_part) {
+        const auto digit = static_cast<unsigned long>(c - '0');
+        if (value > (max - digit) / 10) {
+            return std::nullopt;
         }
-    } else if (type_modifier == snm::TypeModifier::R) {
-        // Число с плавающей запятой
-        result = std::stof(str);
-    } else {
-        // Целое число. В данном случае не имеет значения, какой тип аргумента.
-        result = std::stoul(str);
+        value = value * 10 + digit;
     }
 
-    return result;
+    return snm::Bytes(negative ? 0UL - value : value);
 }
 
-std::string Assembler::RemoveComment(const std::string& line) {
-    if (const size_t pos = line.find("//"); pos != std::string::npos) {
+std::string_view Assembler::RemoveComment(const std::string_view line) {
+    if (const size_t pos = line.find("//"); pos != std::string_view::npos) {
         return line.substr(0, pos);
     }
 
     return line;
 }
 
-std::string Assembler::ToUpper(std::string& str) {
-    std::ranges::transform(str, str.begin(), toupper);
-    return str;
+std::string Assembler::ToUpper(const std::string_view str) {
+    std::string result(str);
+    std::ranges::transform(result, result.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::toupper(c));
+    });
+    return result;
 }
 
+bool Assembler::EqualsIgnoreCase(const std::string_view str, const std::string_view keyword) {
+    return str.size() == keyword.size()
+        && std::ranges::equal(str, keyword, [](const char a, const char b) {
+            return std::toupper(static_cast<unsigned char>(a)) == b;
+        });
+}
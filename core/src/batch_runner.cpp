@@ -0,0 +1,153 @@
+#include "core/batch_runner.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include "core/stream_io.hpp"
+
+namespace {
+    /**
+     * @brief Размер буфера вывода StreamIo одного задания.
+     */
+    constexpr size_t OUTPUT_BUFFER_SIZE = 4096;
+
+    /**
+     * @brief Очередь заданий потока. Владелец берёт задания с начала, остальные потоки забирают с конца.
+     */
+    class JobQueue {
+    public:
+        void Push(const size_t job) {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(job);
+        }
+
+        std::optional<size_t> Pop() {
+            std::lock_guard lock(mutex_);
+            if (jobs_.empty()) {
+                return std::nullopt;
+            }
+            const size_t job = jobs_.front();
+            jobs_.pop_front();
+            return job;
+        }
+
+        std::optional<size_t> Steal() {
+            std::lock_guard lock(mutex_);
+            if (jobs_.empty()) {
+                return std::nullopt;
+            }
+            const size_t job = jobs_.back();
+            jobs_.pop_back();
+            return job;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::deque<size_t> jobs_;
+    };
+
+    /**
+     * @brief Исполнитель заданий: собственные память, процессор и очередь.
+     */
+    struct Worker {
+        MemoryManager memory;
+        Processor processor{memory};
+        JobQueue queue;
+    };
+
+    void RunJob(MemoryManager& memory, Processor& processor, const std::string& input, BatchResult& result) {
+        std::istringstream input_stream(input);
+        std::ostringstream output_stream;
+
+        memory.ResetData();
+        processor.Reset();
+
+        {
+            StreamIo io(input_stream, output_stream, OUTPUT_BUFFER_SIZE);
+            processor.SetIo(&io);
+
+            try {
+                processor.Run();
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+
+            processor.SetIo(nullptr);
+        }
+
+        result.output = std::move(output_stream).str();
+        result.registers = processor.GetRegisters();
+        result.instruction_count = processor.GetInstructionCount();
+    }
+}
+
+BatchRunner::BatchRunner(const size_t thread_count) :
+    thread_count_(thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+void BatchRunner::SetExecutionMode(const snm::ExecutionMode mode) {
+    execution_mode_ = mode;
+}
+
+size_t BatchRunner::GetThreadCount() const {
+    return thread_count_;
+}
+
+std::vector<BatchResult> BatchRunner::Run(const std::span<const snm::Byte> byte_code,
+                                          const std::vector<std::string>& inputs) const {
+    std::vector<BatchResult> results(inputs.size());
+    if (inputs.empty()) {
+        return results;
+    }
+
+    // Образ строится в вызывающем потоке, чтобы ошибки байт-кода передавались вызывающему
+    const auto image = std::make_shared<const ProgramImage>(byte_code);
+
+    const size_t worker_count = std::min(thread_count_, inputs.size());
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto& worker = workers.emplace_back(std::make_unique<Worker>());
+        worker->memory.Load(image);
+        worker->processor.SetExecutionMode(execution_mode_);
+    }
+
+    // Непрерывные диапазоны заданий сохраняют локальность результатов
+    for (size_t job = 0; job < inputs.size(); ++job) {
+        workers[job * worker_count / inputs.size()]->queue.Push(job);
+    }
+
+    auto work = [&](const size_t index) {
+        Worker& worker = *workers[index];
+
+        while (true) {
+            std::optional<size_t> job = worker.queue.Pop();
+            for (size_t offset = 1; !job && offset < worker_count; ++offset) {
+                job = workers[(index + offset) % worker_count]->queue.Steal();
+            }
+
+            // Новые задания не появляются, поэтому пустые очереди означают завершение
+            if (!job) {
+                break;
+            }
+
+            RunJob(worker.memory, worker.processor, inputs[*job], results[*job]);
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i) {
+            threads.emplace_back(work, i);
+        }
+        work(0);
+    }
+
+    return results;
+}
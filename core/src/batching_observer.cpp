@@ -0,0 +1,88 @@
+#include "core/batching_observer.hpp"
+
+#include <algorithm>
+
+BatchingObserver::BatchingObserver(ProcessorChangesObserver& target, const Clock::duration interval,
+                                   const uint64_t instruction_limit) :
+    target_(target),
+    interval_(interval),
+    instruction_limit_(instruction_limit),
+    last_flush_(Clock::now()) {
+}
+
+void BatchingObserver::SetInterval(const Clock::duration interval) {
+    interval_ = interval;
+}
+
+void BatchingObserver::SetInstructionLimit(const uint64_t instruction_limit) {
+    instruction_limit_ = instruction_limit;
+}
+
+void BatchingObserver::Flush() {
+    last_flush_ = Clock::now();
+
+    if (changes_.Empty()) {
+        return;
+    }
+
+    std::ranges::sort(changes_.memory);
+    target_.OnChanges(changes_);
+    Discard();
+}
+
+void BatchingObserver::Discard() {
+    for (const snm::Address address : changes_.memory) {
+        dirty_memory_.reset(address);
+    }
+
+    changes_.accumulator = false;
+    changes_.auxiliary = false;
+    changes_.instruction_pointer = false;
+    changes_.state.reset();
+    changes_.memory.clear();
+    changes_.instructions = 0;
+}
+
+void BatchingObserver::FlushIfDue() {
+    if (instruction_limit_ != 0 && changes_.instructions >= instruction_limit_) {
+        Flush();
+    } else if (interval_ == Clock::duration::zero()) {
+        if (instruction_limit_ == 0) {
+            Flush();
+        }
+    } else if (changes_.instructions % CLOCK_CHECK_PERIOD == 0 && Clock::now() - last_flush_ >= interval_) {
+        Flush();
+    }
+}
+
+void BatchingObserver::OnRegisterIpChanged(const snm::Address& instruction_pointer) {
+    changes_.instruction_pointer = true;
+    changes_.registers.instruction_pointer = instruction_pointer;
+    ++changes_.instructions;
+
+    target_.OnInstructionPointerChanged(instruction_pointer);
+
+    FlushIfDue();
+}
+
+void BatchingObserver::OnRegisterAccChanged(const snm::Bytes& accumulator) {
+    changes_.accumulator = true;
+    changes_.registers.accumulator = accumulator;
+}
+
+void BatchingObserver::OnRegisterAuxChanged(const snm::Bytes& auxiliary) {
+    changes_.auxiliary = true;
+    changes_.registers.auxiliary = auxiliary;
+}
+
+void BatchingObserver::OnMemoryChanged(const snm::Address& address) {
+    if (!dirty_memory_.test(address)) {
+        dirty_memory_.set(address);
+        changes_.memory.push_back(address);
+    }
+}
+
+void BatchingObserver::OnStateChanged(const snm::ProcessorState& state) {
+    changes_.state = state;
+    Flush();
+}
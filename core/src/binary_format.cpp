@@ -0,0 +1,23 @@
+#include "binary_format.hpp"
+
+#include <fstream>
+#include <iterator>
+
+void snm::binary::WriteFile(const std::string& path, const std::span<const Byte> data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.close();
+
+    if (!file) {
+        throw std::runtime_error(std::format("Cannot write file {}", path));
+    }
+}
+
+snm::ByteCode snm::binary::ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error(std::format("Cannot open file {}", path));
+    }
+
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
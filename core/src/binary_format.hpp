@@ -0,0 +1,68 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "core/common_definitions.hpp"
+
+/**
+ * @brief Общие операции двоичных форматов файлов: программы (ProgramFile), снимка (SnapshotFile)
+ * и записи ввода-вывода (IoLogFile). Числа записываются в порядке little-endian.
+ */
+namespace snm::binary {
+    template <typename T>
+    T ReadLittleEndian(const std::span<const Byte> data, const size_t offset) {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<T>(data[offset + i]) << (8 * i));
+        }
+        return value;
+    }
+
+    template <typename T>
+    void AppendLittleEndian(ByteCode& data, const T value) {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            data.push_back(static_cast<Byte>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    inline Bytes ReadBytes(const std::span<const Byte> data, const size_t offset) {
+        Bytes bytes{};
+        for (size_t i = 0; i < ARGUMENT_SIZE; ++i) {
+            bytes[i] = data[offset + i];
+        }
+        return bytes;
+    }
+
+    inline void AppendBytes(ByteCode& data, const Bytes bytes) {
+        for (size_t i = 0; i < ARGUMENT_SIZE; ++i) {
+            data.push_back(bytes[i]);
+        }
+    }
+
+    /**
+     * @brief Формирует исключение о повреждённом файле.
+     * @param kind Вид файла в сообщении, например "program".
+     * @param reason Причина.
+     */
+    inline std::invalid_argument InvalidFile(const std::string_view kind, const std::string_view reason) {
+        return std::invalid_argument(std::format("Invalid {} file: {}", kind, reason));
+    }
+
+    /**
+     * @brief Записывает данные в файл, заменяя его содержимое.
+     * @throws std::runtime_error Если файл не удалось записать.
+     */
+    void WriteFile(const std::string& path, std::span<const Byte> data);
+    /**
+     * @brief Читает файл целиком.
+     * @throws std::runtime_error Если файл не удалось открыть.
+     */
+    ByteCode ReadFile(const std::string& path);
+}
+
+#endif // BINARY_FORMAT_HPP
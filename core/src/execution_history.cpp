@@ -0,0 +1,163 @@
+#include "core/execution_history.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+ExecutionHistory::ExecutionHistory(const size_t capacity, const uint64_t checkpoint_interval) :
+    capacity_(capacity),
+    checkpoint_interval_(checkpoint_interval) {
+    if (capacity == 0) {
+        throw std::invalid_argument("History capacity must be positive.");
+    }
+    if (checkpoint_interval == 0) {
+        throw std::invalid_argument("Checkpoint interval must be positive.");
+    }
+}
+
+void ExecutionHistory::SetCapacity(const size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("History capacity must be positive.");
+    }
+
+    // Оставшиеся записи переносятся в начало буфера по порядку
+    const size_t size = std::min(size_, capacity);
+    std::vector<UndoRecord> records;
+    records.reserve(size);
+    for (size_t i = size_ - size; i < size_; ++i) {
+        records.push_back(At(i));
+    }
+
+    records_ = std::move(records);
+    capacity_ = capacity;
+    first_ = 0;
+    size_ = size;
+    DropCheckpoints();
+}
+
+size_t ExecutionHistory::GetCapacity() const {
+    return capacity_;
+}
+
+uint64_t ExecutionHistory::GetCheckpointInterval() const {
+    return checkpoint_interval_;
+}
+
+size_t ExecutionHistory::Size() const {
+    return size_;
+}
+
+size_t ExecutionHistory::GetCheckpointCount() const {
+    return checkpoints_.size();
+}
+
+uint64_t ExecutionHistory::GetFirstInstructionCount() const {
+    return end_instruction_count_ - size_;
+}
+
+uint64_t ExecutionHistory::GetEndInstructionCount() const {
+    return end_instruction_count_;
+}
+
+void ExecutionHistory::Clear() {
+    first_ = 0;
+    size_ = 0;
+    checkpoints_.clear();
+    end_instruction_count_ = 0;
+    started_ = false;
+}
+
+bool ExecutionHistory::Continues(const uint64_t instruction_count, const size_t code_revision) const {
+    return started_ && end_instruction_count_ == instruction_count && code_revision_ == code_revision;
+}
+
+void ExecutionHistory::Start(const uint64_t instruction_count, const size_t code_revision) {
+    Clear();
+    end_instruction_count_ = instruction_count;
+    code_revision_ = code_revision;
+    started_ = true;
+}
+
+bool ExecutionHistory::NeedsCheckpoint() const {
+    return checkpoints_.empty()
+           || end_instruction_count_ - checkpoints_.back()->instruction_count >= checkpoint_interval_;
+}
+
+void ExecutionHistory::AddCheckpoint(std::shared_ptr<const ProcessorSnapshot> checkpoint) {
+    checkpoints_.push_back(std::move(checkpoint));
+}
+
+void ExecutionHistory::Record(const Registers& registers) {
+    if (size_ == capacity_) {
+        first_ = (first_ + 1) % capacity_;
+        --size_;
+    }
+
+    // Пока буфер не заполнен, самая старая запись находится в начале и индекс не переходит через конец
+    const size_t index = (first_ + size_) % capacity_;
+    if (index == records_.size()) {
+        records_.emplace_back();
+    }
+    records_[index] = UndoRecord{.registers = registers};
+
+    ++size_;
+    ++end_instruction_count_;
+    DropCheckpoints();
+}
+
+void ExecutionHistory::RecordMemoryWrite(const snm::Address address, const snm::Bytes previous) {
+    UndoRecord& record = records_[(first_ + size_ - 1) % capacity_];
+    record.argument = previous;
+    record.address = address;
+    record.memory_written = true;
+}
+
+UndoRecord ExecutionHistory::PopBack() {
+    const UndoRecord record = At(size_ - 1);
+    --size_;
+    --end_instruction_count_;
+    DropCheckpoints();
+    return record;
+}
+
+std::shared_ptr<const ProcessorSnapshot> ExecutionHistory::RewindToCheckpoint(const uint64_t instruction_count) {
+    const auto checkpoint = std::ranges::lower_bound(checkpoints_, instruction_count, {},
+                                                     [](const auto& snapshot) {
+                                                         return snapshot->instruction_count;
+                                                     });
+    if (checkpoint == checkpoints_.end() || (*checkpoint)->instruction_count >= end_instruction_count_) {
+        return nullptr;
+    }
+
+    std::shared_ptr<const ProcessorSnapshot> result = *checkpoint;
+    size_ -= end_instruction_count_ - result->instruction_count;
+    end_instruction_count_ = result->instruction_count;
+    checkpoints_.erase(std::next(checkpoint), checkpoints_.end());
+    return result;
+}
+
+void ExecutionHistory::UpdateCodeRevision(const size_t code_revision) {
+    code_revision_ = code_revision;
+}
+
+std::optional<uint64_t> ExecutionHistory::FindLast(const std::bitset<snm::CODE_MEMORY_SIZE>& addresses) const {
+    for (size_t i = size_; i > 0; --i) {
+        if (addresses.test(At(i - 1).registers.instruction_pointer)) {
+            return GetFirstInstructionCount() + i - 1;
+        }
+    }
+
+    return std::nullopt;
+}
+
+const UndoRecord& ExecutionHistory::At(const size_t index) const {
+    return records_[(first_ + index) % capacity_];
+}
+
+void ExecutionHistory::DropCheckpoints() {
+    while (!checkpoints_.empty() && checkpoints_.front()->instruction_count < GetFirstInstructionCount()) {
+        checkpoints_.pop_front();
+    }
+    while (!checkpoints_.empty() && checkpoints_.back()->instruction_count > end_instruction_count_) {
+        checkpoints_.pop_back();
+    }
+}
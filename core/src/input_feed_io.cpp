@@ -0,0 +1,96 @@
+#include "core/input_feed_io.hpp"
+
+#include <charconv>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/virtual_machine.hpp"
+
+InputFeedIo::InputFeedIo(std::vector<Value> input, ProcessorIo& io) :
+    input_(std::move(input)),
+    io_(io) {
+}
+
+std::vector<InputFeedIo::Value> InputFeedIo::Parse(std::istream& input) {
+    std::vector<Value> values;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        std::string_view text(line);
+        text = text.substr(0, text.find('#'));
+
+        while (true) {
+            const size_t begin = text.find_first_not_of(" \t\r\v\f");
+            if (begin == std::string_view::npos) {
+                break;
+            }
+            text.remove_prefix(begin);
+
+            const std::string_view token = text.substr(0, text.find_first_of(" \t\r\v\f"));
+            text.remove_prefix(token.size());
+
+            const char* first = token.data();
+            const char* last = token.data() + token.size();
+            std::from_chars_result result{};
+            Value value{};
+
+            if (token.find_first_of(".eE") != std::string_view::npos) {
+                snm::Real real{};
+                result = std::from_chars(first, last, real);
+                value = {snm::Type::REAL, snm::Bytes(real), std::string(token)};
+            } else if (token.starts_with('-')) {
+                snm::SignedWord signed_word{};
+                result = std::from_chars(first, last, signed_word);
+                value = {snm::Type::SIGNED_WORD, snm::Bytes(signed_word), std::string(token)};
+            } else {
+                snm::Word word{};
+                result = std::from_chars(first, last, word);
+                value = {snm::Type::WORD, snm::Bytes(word), std::string(token)};
+            }
+
+            if (result.ec != std::errc() || result.ptr != last) {
+                throw std::runtime_error(std::format("Error: Invalid input value {}", token));
+            }
+
+            values.push_back(std::move(value));
+        }
+    }
+
+    return values;
+}
+
+void InputFeedIo::InputRequest(const snm::Type type, const InputCallback callback) {
+    if (next_ == input_.size()) {
+        io_.InputRequest(type, callback);
+        return;
+    }
+
+    callback(Convert(input_[next_++], type));
+}
+
+void InputFeedIo::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
+    io_.OutputRequest(bytes, type);
+}
+
+void InputFeedIo::Rewind() {
+    next_ = 0;
+}
+
+size_t InputFeedIo::GetRemaining() const {
+    return input_.size() - next_;
+}
+
+snm::Bytes InputFeedIo::Convert(const Value& value, const snm::Type type) {
+    if (value.type == type) {
+        return value.bytes;
+    }
+
+    // Как в StreamIo: запись разбирается заново, чтобы результат совпадал с вводом с консоли
+    try {
+        return VirtualMachine::BytesFromString(value.text, type);
+    } catch ([[maybe_unused]] const std::logic_error& e) {
+        throw std::runtime_error(std::format("Error: Invalid input value {}", value.text));
+    }
+}
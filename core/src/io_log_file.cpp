@@ -0,0 +1,122 @@
+#include "core/io_log_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+
+#include "binary_format.hpp"
+
+namespace {
+    using snm::binary::AppendBytes;
+    using snm::binary::AppendLittleEndian;
+    using snm::binary::InvalidFile;
+    using snm::binary::ReadBytes;
+    using snm::binary::ReadLittleEndian;
+
+    constexpr std::array<snm::Byte, 4> MAGIC = {'S', 'N', 'M', 'R'};
+    constexpr size_t HEADER_SIZE = 12;
+    constexpr snm::Byte OUTPUT_FLAG = 0x80;
+    constexpr snm::Byte TYPE_MASK = 0x03;
+    constexpr size_t MAX_VARINT_SIZE = 10;
+    constexpr std::string_view FILE_KIND = "I/O recording";
+
+    void AppendVarint(snm::ByteCode& data, uint64_t value) {
+        while (value >= 0x80) {
+            data.push_back(static_cast<snm::Byte>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<snm::Byte>(value));
+    }
+
+    uint64_t ReadVarint(const std::span<const snm::Byte> data, size_t& offset) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < MAX_VARINT_SIZE && offset < data.size(); ++i) {
+            const snm::Byte byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw InvalidFile(FILE_KIND, "truncated instruction count");
+    }
+}
+
+snm::ByteCode IoLogFile::Serialize(const std::span<const IoEvent> events) {
+    snm::ByteCode data(MAGIC.begin(), MAGIC.end());
+    data.reserve(HEADER_SIZE + events.size() * (1 + snm::ARGUMENT_SIZE + 2));
+
+    AppendLittleEndian<uint16_t>(data, VERSION);
+    AppendLittleEndian<uint16_t>(data, 0);
+    AppendLittleEndian(data, static_cast<uint32_t>(events.size()));
+
+    uint64_t instruction_count = 0;
+    for (const IoEvent& event : events) {
+        if (event.instruction_count < instruction_count) {
+            throw std::invalid_argument("I/O events must be ordered by instruction count.");
+        }
+
+        const auto kind = event.kind == IoEvent::Kind::OUTPUT ? OUTPUT_FLAG : snm::Byte{0};
+        data.push_back(static_cast<snm::Byte>(kind | (event.type & TYPE_MASK)));
+        AppendBytes(data, event.bytes);
+        AppendVarint(data, event.instruction_count - instruction_count);
+        instruction_count = event.instruction_count;
+    }
+
+    return data;
+}
+
+std::vector<IoEvent> IoLogFile::Deserialize(const std::span<const snm::Byte> data) {
+    if (data.size() < HEADER_SIZE || !std::ranges::equal(data.first(MAGIC.size()), MAGIC)) {
+        throw InvalidFile(FILE_KIND, "signature not found");
+    }
+
+    if (const auto version = ReadLittleEndian<uint16_t>(data, 4); version != VERSION) {
+        throw InvalidFile(FILE_KIND, std::format("unsupported version {}", version));
+    }
+
+    // Событие занимает не меньше 6 байт, что ограничивает резервируемую память для повреждённого заголовка
+    const auto count = ReadLittleEndian<uint32_t>(data, 8);
+    if (count > (data.size() - HEADER_SIZE) / (1 + snm::ARGUMENT_SIZE + 1)) {
+        throw InvalidFile(FILE_KIND, "event count does not match file size");
+    }
+
+    std::vector<IoEvent> events;
+    events.reserve(count);
+
+    size_t offset = HEADER_SIZE;
+    uint64_t instruction_count = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (data.size() - offset < 1 + snm::ARGUMENT_SIZE) {
+            throw InvalidFile(FILE_KIND, "truncated event");
+        }
+
+        const snm::Byte header = data[offset++];
+        if ((header & ~(OUTPUT_FLAG | TYPE_MASK)) != 0) {
+            throw InvalidFile(FILE_KIND, std::format("unknown event header {:#04x}", header));
+        }
+
+        const snm::Bytes bytes = ReadBytes(data, offset);
+        offset += snm::ARGUMENT_SIZE;
+        instruction_count += ReadVarint(data, offset);
+
+        events.push_back({
+            (header & OUTPUT_FLAG) != 0 ? IoEvent::Kind::OUTPUT : IoEvent::Kind::INPUT,
+            static_cast<snm::Type>(header & TYPE_MASK), bytes, instruction_count
+        });
+    }
+
+    if (offset != data.size()) {
+        throw InvalidFile(FILE_KIND, "unexpected data after the last event");
+    }
+
+    return events;
+}
+
+void IoLogFile::Write(const std::string& path, const std::span<const IoEvent> events) {
+    snm::binary::WriteFile(path, Serialize(events));
+}
+
+std::vector<IoEvent> IoLogFile::Read(const std::string& path) {
+    return Deserialize(snm::binary::ReadFile(path));
+}
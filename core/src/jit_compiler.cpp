@@ -0,0 +1,817 @@
+#include "core/jit_compiler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <map>
+
+#include "core/processor.hpp"
+
+#if defined(__linux__) && defined(__x86_64__)
+#define SNM_JIT_X86_64
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Состояние участка. Машинный код читает и записывает поля по смещениям, поэтому регистры
+ * передаются числами, а не в представлении snm::Bytes.
+ */
+struct JitCompiler::Frame {
+    uint32_t accumulator; ///< Аккумулятор
+    uint32_t auxiliary; ///< Вспомогательный регистр
+    uint32_t instruction_pointer; ///< IP после выхода из участка
+    uint64_t executed; ///< Количество выполненных инструкций
+    uint64_t back_edge_limit; ///< Количество инструкций, после которого переход назад завершает участок
+    const MemoryCell* const* pages; ///< Таблица страниц памяти
+    JitCompiler* compiler; ///< Транслятор для записи аргументов
+    const std::atomic<bool>* stop_requested; ///< Флаг запроса остановки
+    const std::atomic<bool>* snapshot_requested; ///< Флаг запроса снимка
+};
+
+namespace {
+    /**
+     * @brief Размер исполняемой памяти. При исчерпании все участки снимаются и транслируются заново.
+     */
+    constexpr size_t CODE_BUFFER_SIZE = 16 << 20;
+
+    static_assert(ProgramImage::PAGE_SIZE == 256, "Page index is computed with a shift by 8");
+    static_assert(sizeof(snm::Bytes) == sizeof(uint32_t), "Arguments are accessed as 32-bit values");
+
+    /**
+     * @brief Проверяет, может ли инструкция с кодом операции входить в участок.
+     *
+     * Неопределённые комбинации команды и типа, как и инструкции, способные выбросить исключение или
+     * обратиться к обработчику ввода-вывода, исполняет цикл процессора.
+     */
+    constexpr bool IsTranslatable(const snm::Byte code) {
+        switch (static_cast<snm::OpCode>(code >> 4)) {
+        case snm::OpCode::NOPE:
+        case snm::OpCode::ADD:
+        case snm::OpCode::SUB:
+        case snm::OpCode::MUL:
+        case snm::OpCode::LOAD:
+        case snm::OpCode::SKIP_LOWER:
+        case snm::OpCode::SKIP_GREATER:
+        case snm::OpCode::SKIP_EQUAL:
+            return true;
+        case snm::OpCode::STORE:
+        case snm::OpCode::JUMP:
+        case snm::OpCode::JUMPNSTORE:
+            return static_cast<snm::TypeModifier>(code >> 2 & 0b11) == snm::TypeModifier::W;
+        default:
+            return false;
+        }
+    }
+
+    enum Register : uint8_t {
+        RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15
+    };
+
+    enum Condition : uint8_t {
+        BELOW = 0x2,
+        EQUAL = 0x4,
+        NOT_EQUAL = 0x5,
+        ABOVE = 0x7,
+        PARITY = 0xA,
+        LESS = 0xC,
+        GREATER = 0xF
+    };
+
+    /**
+     * @class X86Assembler
+     * @brief Кодировщик используемого транслятором подмножества инструкций x86-64.
+     *
+     * Операнды в памяти адресуются как [base + disp32] или [base + index * 2^scale + disp32]. Все переходы
+     * кодируются со смещением rel32 и разрешаются ResolveLabels() после привязки меток.
+     */
+    class X86Assembler {
+    public:
+        using Label = size_t;
+
+        [[nodiscard]] const std::vector<uint8_t>& GetCode() const {
+            return code_;
+        }
+
+        Label NewLabel() {
+            labels_.push_back(0);
+            return labels_.size() - 1;
+        }
+
+        void Bind(const Label label) {
+            labels_[label] = code_.size();
+        }
+
+        void ResolveLabels() {
+            for (const auto& [position, label] : fixups_) {
+                const auto offset = static_cast<int32_t>(labels_[label] - (position + sizeof(int32_t)));
+                std::memcpy(&code_[position], &offset, sizeof(offset));
+            }
+            fixups_.clear();
+        }
+
+        void Push(const Register reg) {
+            Rex(false, 0, 0, reg);
+            Emit(0x50 + (reg & 7));
+        }
+
+        void Pop(const Register reg) {
+            Rex(false, 0, 0, reg);
+            Emit(0x58 + (reg & 7));
+        }
+
+        void Ret() {
+            Emit(0xC3);
+        }
+
+        void Call(const Register reg) {
+            Rex(false, 0, 0, reg);
+            Emit(0xFF);
+            ModRm(2, reg);
+        }
+
+        void Jump(const Label label) {
+            Emit(0xE9);
+            Fixup(label);
+        }
+
+        void Jump(const Condition condition, const Label label) {
+            Emit(0x0F);
+            Emit(0x80 + condition);
+            Fixup(label);
+        }
+
+        void Mov32(const Register dst, const Register src) {
+            Binary(false, 0x89, dst, src);
+        }
+
+        void Mov64(const Register dst, const Register src) {
+            Binary(true, 0x89, dst, src);
+        }
+
+        void MovImm32(const Register dst, const uint32_t value) {
+            Rex(false, 0, 0, dst);
+            Emit(0xB8 + (dst & 7));
+            Immediate(value);
+        }
+
+        void MovImm64(const Register dst, const uint64_t value) {
+            Rex(true, 0, 0, dst);
+            Emit(0xB8 + (dst & 7));
+            Immediate(value);
+        }
+
+        void MovzxByte(const Register dst, const Register src) {
+            Rex(false, dst, 0, src, true);
+            Emit(0x0F);
+            Emit(0xB6);
+            ModRm(dst, src);
+        }
+
+        void MovzxWord(const Register dst, const Register src) {
+            Rex(false, dst, 0, src);
+            Emit(0x0F);
+            Emit(0xB7);
+            ModRm(dst, src);
+        }
+
+        void Add32(const Register dst, const Register src) {
+            Binary(false, 0x01, dst, src);
+        }
+
+        void Sub32(const Register dst, const Register src) {
+            Binary(false, 0x29, dst, src);
+        }
+
+        void Xor32(const Register dst, const Register src) {
+            Binary(false, 0x31, dst, src);
+        }
+
+        void Cmp32(const Register dst, const Register src) {
+            Binary(false, 0x39, dst, src);
+        }
+
+        void Test32(const Register dst, const Register src) {
+            Binary(false, 0x85, dst, src);
+        }
+
+        void Imul32(const Register dst, const Register src) {
+            Rex(false, dst, 0, src);
+            Emit(0x0F);
+            Emit(0xAF);
+            ModRm(dst, src);
+        }
+
+        void ImulImm32(const Register dst, const Register src, const uint32_t value) {
+            Rex(false, dst, 0, src);
+            Emit(0x69);
+            ModRm(dst, src);
+            Immediate(value);
+        }
+
+        void AddImm32(const Register dst, const uint32_t value) {
+            Group1(0, dst, value);
+        }
+
+        void AndImm32(const Register dst, const uint32_t value) {
+            Group1(4, dst, value);
+        }
+
+        void CmpImm32(const Register dst, const uint32_t value) {
+            Group1(7, dst, value);
+        }
+
+        void ShrImm32(const Register dst, const uint8_t count) {
+            Rex(false, 0, 0, dst);
+            Emit(0xC1);
+            ModRm(5, dst);
+            Emit(count);
+        }
+
+        void Inc64(const Register reg) {
+            Rex(true, 0, 0, reg);
+            Emit(0xFF);
+            ModRm(0, reg);
+        }
+
+        void Load32(const Register dst, const Register base, const int32_t displacement) {
+            Rex(false, dst, 0, base);
+            Emit(0x8B);
+            Memory(dst, base, displacement);
+        }
+
+        void Load64(const Register dst, const Register base, const int32_t displacement) {
+            Rex(true, dst, 0, base);
+            Emit(0x8B);
+            Memory(dst, base, displacement);
+        }
+
+        void Load32Indexed(const Register dst, const Register base, const Register index, const int32_t displacement) {
+            Rex(false, dst, index, base);
+            Emit(0x8B);
+            Memory(dst, base, index, 0, displacement);
+        }
+
+        void Load64Indexed(const Register dst, const Register base, const Register index) {
+            Rex(true, dst, index, base);
+            Emit(0x8B);
+            Memory(dst, base, index, 3, 0);
+        }
+
+        void Store32(const Register base, const int32_t displacement, const Register src) {
+            Rex(false, src, 0, base);
+            Emit(0x89);
+            Memory(src, base, displacement);
+        }
+
+        void Store64(const Register base, const int32_t displacement, const Register src) {
+            Rex(true, src, 0, base);
+            Emit(0x89);
+            Memory(src, base, displacement);
+        }
+
+        void Cmp64(const Register reg, const Register base, const int32_t displacement) {
+            Rex(true, reg, 0, base);
+            Emit(0x3B);
+            Memory(reg, base, displacement);
+        }
+
+        void CmpByteZero(const Register base) {
+            Rex(false, 0, 0, base);
+            Emit(0x80);
+            Memory(7, base, 0);
+            Emit(0);
+        }
+
+        void MovdToXmm(const uint8_t xmm, const Register src) {
+            Emit(0x66);
+            Rex(false, xmm, 0, src);
+            Emit(0x0F);
+            Emit(0x6E);
+            ModRm(xmm, src);
+        }
+
+        void MovdFromXmm(const Register dst, const uint8_t xmm) {
+            Emit(0x66);
+            Rex(false, xmm, 0, dst);
+            Emit(0x0F);
+            Emit(0x7E);
+            ModRm(xmm, dst);
+        }
+
+        /**
+         * @brief Скалярная операция над числами одинарной точности: 0x58 — ADDSS, 0x5C — SUBSS, 0x59 — MULSS.
+         */
+        void ScalarSingle(const uint8_t opcode, const uint8_t dst, const uint8_t src) {
+            Emit(0xF3);
+            Rex(false, dst, 0, src);
+            Emit(0x0F);
+            Emit(opcode);
+            ModRm(dst, src);
+        }
+
+        void Ucomiss(const uint8_t lhs, const uint8_t rhs) {
+            Rex(false, lhs, 0, rhs);
+            Emit(0x0F);
+            Emit(0x2E);
+            ModRm(lhs, rhs);
+        }
+
+    private:
+        std::vector<uint8_t> code_;
+        std::vector<size_t> labels_;
+        std::vector<std::pair<size_t, Label>> fixups_;
+
+        void Emit(const unsigned byte) {
+            code_.push_back(static_cast<uint8_t>(byte));
+        }
+
+        template <typename T>
+        void Immediate(const T value) {
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                Emit(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void Fixup(const Label label) {
+            fixups_.emplace_back(code_.size(), label);
+            Immediate<int32_t>(0);
+        }
+
+        /**
+         * @brief Префикс REX. Для однобайтовых регистров префикс нужен всегда, иначе коды 4-7 означают AH-BH.
+         */
+        void Rex(const bool wide, const unsigned reg, const unsigned index, const unsigned base,
+                 const bool byte_registers = false) {
+            const unsigned rex = 0x40 | wide << 3 | (reg >> 3 & 1) << 2 | (index >> 3 & 1) << 1 | (base >> 3 & 1);
+            if (rex != 0x40 || byte_registers) {
+                Emit(rex);
+            }
+        }
+
+        void ModRm(const unsigned reg, const unsigned rm) {
+            Emit(0xC0 | (reg & 7) << 3 | (rm & 7));
+        }
+
+        void Memory(const unsigned reg, const unsigned base, const int32_t displacement) {
+            Emit(0x80 | (reg & 7) << 3 | (base & 7));
+            // Базовые регистры RSP и R12 кодируются только через байт SIB
+            if ((base & 7) == RSP) {
+                Emit(0x24);
+            }
+            Immediate(displacement);
+        }
+
+        void Memory(const unsigned reg, const unsigned base, const unsigned index, const unsigned scale,
+                    const int32_t displacement) {
+            Emit(0x84 | (reg & 7) << 3);
+            Emit(scale << 6 | (index & 7) << 3 | (base & 7));
+            Immediate(displacement);
+        }
+
+        void Binary(const bool wide, const uint8_t opcode, const Register dst, const Register src) {
+            Rex(wide, src, 0, dst);
+            Emit(opcode);
+            ModRm(src, dst);
+        }
+
+        void Group1(const unsigned operation, const Register dst, const uint32_t value) {
+            Rex(false, 0, 0, dst);
+            Emit(0x81);
+            ModRm(operation, dst);
+            Immediate(value);
+        }
+    };
+}
+
+JitCompiler::JitCompiler(MemoryManager& memory, const std::atomic<bool>& stop_requested,
+                         const std::atomic<bool>& snapshot_requested) :
+    memory_(memory),
+    stop_requested_(stop_requested),
+    snapshot_requested_(snapshot_requested),
+    blocks_(snm::CODE_MEMORY_SIZE),
+    code_revision_(memory.CodeRevision()) {
+#ifdef SNM_JIT_X86_64
+    if (void* code = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        code != MAP_FAILED) {
+        code_ = static_cast<uint8_t*>(code);
+    }
+#endif
+    memory_.ClearWatches();
+}
+
+JitCompiler::~JitCompiler() {
+    memory_.ClearWatches();
+#ifdef SNM_JIT_X86_64
+    if (code_) {
+        munmap(code_, CODE_BUFFER_SIZE);
+    }
+#endif
+}
+
+bool JitCompiler::IsSupported() {
+#ifdef SNM_JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+const JitCompiler::Block* JitCompiler::GetBlock(const snm::Address address) {
+    if (code_revision_ != memory_.CodeRevision()) [[unlikely]] {
+        Flush();
+        written_.reset();
+        code_revision_ = memory_.CodeRevision();
+    }
+    if (memory_.HasWatchedWrites()) [[unlikely]] {
+        Invalidate(memory_.TakeWatchedWrites());
+    }
+
+    const Block& block = blocks_[address];
+    if (!block.entry && !block.rejected) [[unlikely]] {
+        Translate(address);
+    }
+    return block.entry ? &block : nullptr;
+}
+
+uint64_t JitCompiler::Execute(const Block& block, Registers& registers, const uint64_t budget) {
+    Frame frame{
+        static_cast<snm::Word>(registers.accumulator),
+        static_cast<snm::Word>(registers.auxiliary),
+        registers.instruction_pointer,
+        0,
+        budget - block.length,
+        memory_.GetPageTable(),
+        this,
+        &stop_requested_,
+        &snapshot_requested_
+    };
+
+    block.entry(&frame);
+
+    registers.accumulator = frame.accumulator;
+    registers.auxiliary = frame.auxiliary;
+    registers.instruction_pointer = static_cast<snm::Address>(frame.instruction_pointer);
+    return frame.executed;
+}
+
+size_t JitCompiler::GetTranslationCount() const {
+    return translation_count_;
+}
+
+size_t JitCompiler::GetInvalidationCount() const {
+    return invalidation_count_;
+}
+
+void JitCompiler::Flush() {
+    std::ranges::fill(blocks_, Block{});
+    code_used_ = 0;
+    memory_.ClearWatches();
+}
+
+void JitCompiler::Invalidate(const std::vector<snm::Address>& addresses) {
+    for (const snm::Address address : addresses) {
+        written_.set(address);
+
+        // Ячейку содержат только участки, начинающиеся не дальше MAX_BLOCK_LENGTH - 1 ячеек перед ней
+        const size_t first = address >= MAX_BLOCK_LENGTH ? address - MAX_BLOCK_LENGTH + 1 : 0;
+        for (size_t start = first; start <= address; ++start) {
+            Block& block = blocks_[start];
+            if (block.entry && start + block.length > address) {
+                block = {};
+                ++invalidation_count_;
+            }
+        }
+    }
+}
+
+void JitCompiler::Translate(const snm::Address address) {
+    Block& block = blocks_[address];
+
+#ifdef SNM_JIT_X86_64
+    uint32_t length = 0;
+    while (code_ && length < MAX_BLOCK_LENGTH && address + length < snm::CODE_MEMORY_SIZE
+           && IsTranslatable(memory_.ReadInstruction(static_cast<snm::Address>(address + length)).first)) {
+        ++length;
+    }
+
+    if (length == 0) {
+        block.rejected = true;
+        return;
+    }
+
+    using Label = X86Assembler::Label;
+    using enum snm::OpCode;
+    using enum snm::TypeModifier;
+    using enum snm::ArgModifier;
+
+    X86Assembler assembler;
+    const std::shared_ptr<const ProgramImage> image = memory_.GetImage();
+    std::vector<snm::Address> embedded_cells;
+
+    std::vector<Label> labels(length);
+    for (Label& label : labels) {
+        label = assembler.NewLabel();
+    }
+    const Label exit = assembler.NewLabel();
+    std::map<snm::Address, Label> exit_labels;
+
+    // Выход с известным значением IP. Код выходов размещается после тела участка.
+    const auto exit_to = [&](const uint32_t target) {
+        const auto [it, inserted] = exit_labels.try_emplace(static_cast<snm::Address>(target));
+        if (inserted) {
+            it->second = assembler.NewLabel();
+        }
+        return it->second;
+    };
+
+    const auto is_inside = [&](const uint32_t target) {
+        return target >= address && target < address + length;
+    };
+
+    // Аргумент ячейки по известному адресу. Страница читается из таблицы при исполнении, так как запись
+    // аргумента заменяет страницу образа её копией.
+    const auto read_cell = [&](const Register dst, const snm::Address cell) {
+        assembler.Load64(RAX, R13, static_cast<int32_t>(cell / ProgramImage::PAGE_SIZE * sizeof(MemoryCell*)));
+        assembler.Load32(dst, RAX, static_cast<int32_t>(cell % ProgramImage::PAGE_SIZE * sizeof(MemoryCell)
+                                                        + offsetof(MemoryCell, argument)));
+    };
+
+    // Аргумент ячейки по адресу из RCX, усечённому до snm::Address
+    const auto read_cell_at = [&](const Register dst) {
+        assembler.MovzxWord(RCX, RCX);
+        assembler.Mov32(RDX, RCX);
+        assembler.ShrImm32(RDX, 8);
+        assembler.Load64Indexed(RDX, R13, RDX);
+        assembler.AndImm32(RCX, ProgramImage::PAGE_SIZE - 1);
+        assembler.ImulImm32(RCX, RCX, sizeof(MemoryCell));
+        assembler.Load32Indexed(dst, RDX, RCX, offsetof(MemoryCell, argument));
+    };
+
+    // Вызов WriteArgument(): значение в ESI, адрес в R14D. Регистры R12-R15 и RBX сохраняются вызываемой функцией.
+    const auto write_argument = [&] {
+        assembler.Load64(RDI, RBX, offsetof(Frame, compiler));
+        assembler.Mov32(RDX, R14);
+        assembler.MovImm64(RAX, reinterpret_cast<uint64_t>(&JitCompiler::WriteArgument));
+        assembler.Call(RAX);
+    };
+
+    // Переход назад: участок завершается при приближении к бюджету или при запросе остановки либо снимка
+    const auto jump_back = [&](const snm::Address target) {
+        assembler.Cmp64(R15, RBX, offsetof(Frame, back_edge_limit));
+        assembler.Jump(ABOVE, exit_to(target));
+        assembler.Load64(RAX, RBX, offsetof(Frame, stop_requested));
+        assembler.CmpByteZero(RAX);
+        assembler.Jump(NOT_EQUAL, exit_to(target));
+        assembler.Load64(RAX, RBX, offsetof(Frame, snapshot_requested));
+        assembler.CmpByteZero(RAX);
+        assembler.Jump(NOT_EQUAL, exit_to(target));
+        assembler.Jump(labels[target - address]);
+    };
+
+    // RBX — состояние участка, R12D — аккумулятор, R13 — таблица страниц, R14D — вспомогательный регистр,
+    // R15 — количество выполненных инструкций. После пяти сохранений стек выровнен для вызовов.
+    for (const Register reg : {RBX, R12, R13, R14, R15}) {
+        assembler.Push(reg);
+    }
+    assembler.Mov64(RBX, RDI);
+    assembler.Load32(R12, RBX, offsetof(Frame, accumulator));
+    assembler.Load32(R14, RBX, offsetof(Frame, auxiliary));
+    assembler.Load64(R13, RBX, offsetof(Frame, pages));
+    assembler.Xor32(R15, R15);
+
+    for (uint32_t i = 0; i < length; ++i) {
+        const auto cell = static_cast<snm::Address>(address + i);
+        const auto [code, argument] = memory_.ReadInstruction(cell);
+        const auto opcode = static_cast<snm::OpCode>(code >> 4);
+        const auto type = static_cast<snm::TypeModifier>(code >> 2 & 0b11);
+        // Модификатор 0b11 не используется и, как в обработчиках процессора, трактуется как значение
+        const auto modifier = (code & 0b11) == 0b11 ? NONE : static_cast<snm::ArgModifier>(code & 0b11);
+        const auto value = static_cast<snm::Word>(argument);
+        const uint32_t next = address + i + 1;
+
+        // Встраиваются только аргументы, совпадающие с образом и ещё не перезаписанные при исполнении
+        const bool embedded = !written_.test(cell) && value == static_cast<snm::Word>(image->GetCell(cell).argument);
+
+        assembler.Bind(labels[i]);
+
+        // Операнд NOPE перезаписывается следующей инструкцией участка, поэтому читается только в последней
+        if (opcode != NOPE || i + 1 == length) {
+            if (embedded) {
+                embedded_cells.push_back(cell);
+            }
+
+            if (modifier == NONE) {
+                if (embedded) {
+                    assembler.MovImm32(R14, value);
+                } else {
+                    read_cell(R14, cell);
+                }
+            } else {
+                if (embedded) {
+                    read_cell(modifier == REF ? R14 : RCX, static_cast<snm::Address>(value));
+                } else {
+                    read_cell(RCX, cell);
+                    read_cell_at(modifier == REF ? R14 : RCX);
+                }
+                if (modifier == REF_REF) {
+                    read_cell_at(R14);
+                }
+            }
+        }
+
+        switch (opcode) {
+        case NOPE:
+            assembler.Inc64(R15);
+            break;
+        case LOAD:
+            if (type == C) {
+                assembler.MovzxByte(R12, R14);
+            } else {
+                assembler.Mov32(R12, R14);
+            }
+            assembler.Inc64(R15);
+            break;
+        case ADD:
+        case SUB:
+        case MUL:
+            if (type == R) {
+                assembler.MovdToXmm(0, R12);
+                assembler.MovdToXmm(1, R14);
+                assembler.ScalarSingle(opcode == ADD ? 0x58 : opcode == SUB ? 0x5C : 0x59, 0, 1);
+                assembler.MovdFromXmm(R12, 0);
+            } else {
+                if (opcode == ADD) {
+                    assembler.Add32(R12, R14);
+                } else if (opcode == SUB) {
+                    assembler.Sub32(R12, R14);
+                } else {
+                    assembler.Imul32(R12, R14);
+                }
+                if (type == C) {
+                    assembler.MovzxByte(R12, R12);
+                }
+            }
+            assembler.Inc64(R15);
+            break;
+        case STORE:
+            // Адрес за пределами памяти: инструкцию повторяет цикл процессора, который выбрасывает исключение
+            assembler.CmpImm32(R14, snm::CODE_MEMORY_SIZE - 1);
+            assembler.Jump(ABOVE, exit_to(cell));
+            assembler.Inc64(R15);
+            assembler.Mov32(RSI, R12);
+            write_argument();
+            assembler.Test32(RAX, RAX);
+            assembler.Jump(NOT_EQUAL, exit_to(next));
+            break;
+        case JUMPNSTORE:
+            assembler.Inc64(R15);
+            assembler.MovImm32(RSI, next);
+            write_argument();
+            assembler.Mov32(RAX, R14);
+            assembler.AddImm32(RAX, 1);
+            assembler.MovzxWord(RAX, RAX);
+            assembler.Jump(exit);
+            break;
+        case JUMP:
+            assembler.Inc64(R15);
+            if (modifier == NONE && embedded) {
+                const auto target = static_cast<snm::Address>(value);
+                if (!is_inside(target)) {
+                    assembler.Jump(exit_to(target));
+                } else if (target <= cell) {
+                    jump_back(target);
+                } else {
+                    assembler.Jump(labels[target - address]);
+                }
+            } else {
+                assembler.MovzxWord(RAX, R14);
+                assembler.Jump(exit);
+            }
+            break;
+        case SKIP_LOWER:
+        case SKIP_GREATER:
+        case SKIP_EQUAL: {
+            assembler.Inc64(R15);
+
+            // Сработавший пропуск ведёт вперёд, поэтому проверка бюджета не нужна
+            const Label taken = is_inside(next + 1) ? labels[next + 1 - address] : exit_to(next + 1);
+
+            if (type == R) {
+                // Сравнение с NaN ложно: при неупорядоченном результате ucomiss устанавливает CF, ZF и PF
+                assembler.MovdToXmm(0, R12);
+                assembler.MovdToXmm(1, R14);
+                if (opcode == SKIP_LOWER) {
+                    assembler.Ucomiss(1, 0);
+                    assembler.Jump(ABOVE, taken);
+                } else if (opcode == SKIP_GREATER) {
+                    assembler.Ucomiss(0, 1);
+                    assembler.Jump(ABOVE, taken);
+                } else {
+                    const Label unordered = assembler.NewLabel();
+                    assembler.Ucomiss(0, 1);
+                    assembler.Jump(PARITY, unordered);
+                    assembler.Jump(EQUAL, taken);
+                    assembler.Bind(unordered);
+                }
+                break;
+            }
+
+            if (type == C) {
+                assembler.MovzxByte(RAX, R12);
+                assembler.MovzxByte(RCX, R14);
+                assembler.Cmp32(RAX, RCX);
+            } else {
+                assembler.Cmp32(R12, R14);
+            }
+
+            if (opcode == SKIP_EQUAL) {
+                assembler.Jump(EQUAL, taken);
+            } else if (type == SW) {
+                assembler.Jump(opcode == SKIP_LOWER ? LESS : GREATER, taken);
+            } else {
+                assembler.Jump(opcode == SKIP_LOWER ? BELOW : ABOVE, taken);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    assembler.Jump(exit_to(address + length));
+
+    for (const auto& [target, label] : exit_labels) {
+        assembler.Bind(label);
+        assembler.MovImm32(RAX, target);
+        assembler.Jump(exit);
+    }
+
+    assembler.Bind(exit);
+    assembler.Store32(RBX, offsetof(Frame, instruction_pointer), RAX);
+    assembler.Store32(RBX, offsetof(Frame, accumulator), R12);
+    assembler.Store32(RBX, offsetof(Frame, auxiliary), R14);
+    assembler.Store64(RBX, offsetof(Frame, executed), R15);
+    for (const Register reg : {R15, R14, R13, R12, RBX}) {
+        assembler.Pop(reg);
+    }
+    assembler.Ret();
+    assembler.ResolveLabels();
+
+    uint8_t* entry = Install(assembler.GetCode());
+    if (!entry && code_) {
+        // Исполняемая память исчерпана: участки транслируются заново по мере обращения
+        Flush();
+        entry = Install(assembler.GetCode());
+    }
+    if (!entry) {
+        block.rejected = true;
+        return;
+    }
+
+    block = {reinterpret_cast<Block::Entry>(entry), length, false};
+    for (const snm::Address cell : embedded_cells) {
+        memory_.WatchArgument(cell);
+    }
+    ++translation_count_;
+#else
+    block.rejected = true;
+#endif
+}
+
+uint8_t* JitCompiler::Install(const std::vector<uint8_t>& code) {
+#ifdef SNM_JIT_X86_64
+    if (!code_ || code.size() > CODE_BUFFER_SIZE - code_used_) {
+        return nullptr;
+    }
+
+    // Страницы доступны либо для записи, либо для исполнения
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t first = code_used_ / page_size * page_size;
+    const size_t last = std::min(CODE_BUFFER_SIZE, (code_used_ + code.size() + page_size - 1) / page_size * page_size);
+
+    if (mprotect(code_ + first, last - first, PROT_READ | PROT_WRITE) != 0) {
+        return nullptr;
+    }
+    std::memcpy(code_ + code_used_, code.data(), code.size());
+    if (mprotect(code_ + first, last - first, PROT_READ | PROT_EXEC) != 0) {
+        // Система запрещает исполнение сгенерированного кода: трансляция отключается
+        munmap(code_, CODE_BUFFER_SIZE);
+        code_ = nullptr;
+        std::ranges::fill(blocks_, Block{});
+        return nullptr;
+    }
+
+    uint8_t* entry = code_ + code_used_;
+    code_used_ = std::min(CODE_BUFFER_SIZE, (code_used_ + code.size() + 15) / 16 * 16);
+    return entry;
+#else
+    static_cast<void>(code);
+    return nullptr;
+#endif
+}
+
+uint32_t JitCompiler::WriteArgument(JitCompiler* compiler, const uint32_t value, const uint32_t address) noexcept {
+    compiler->memory_.WriteArgument(snm::Bytes(value), static_cast<snm::Address>(address));
+    return compiler->memory_.HasWatchedWrites();
+}
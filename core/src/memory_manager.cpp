@@ -1,94 +1,225 @@
-
 #include "core/memory_manager.hpp"
 
-void MemoryManager::Load(const snm::ByteCode& byte_code) {
-    opcodes_.clear();
-    arguments_.clear();
-    arguments_original_.clear();
+#include <algorithm>
 
-    opcodes_.reserve(byte_code.size() / 5);
-    arguments_.reserve(byte_code.size() / 5);
+std::vector<snm::Address> MemorySnapshot::GetWrittenCells() const {
+    std::vector<snm::Address> cells;
 
-    if (byte_code.size() > std::numeric_limits<snm::Address>::max()) {
-        throw std::invalid_argument("Command size exceeds available memory. Cannot load instructions.");
-    }
+    for (size_t page = 0; page < ProgramImage::PAGE_COUNT; ++page) {
+        const MemoryCell* image_page = image_->GetPage(page).data();
+        if (pages_[page] == image_page) {
+            continue;
+        }
 
-    if (byte_code.size() % 5 != 0) {
-        throw std::invalid_argument("Invalid bytecode format. Unable to parse.");
+        for (size_t i = 0; i < ProgramImage::PAGE_SIZE; ++i) {
+            if (static_cast<snm::Word>(pages_[page][i].argument) != static_cast<snm::Word>(image_page[i].argument)) {
+                cells.push_back(static_cast<snm::Address>(page * ProgramImage::PAGE_SIZE + i));
+            }
+        }
     }
 
-    snm::Address address = 0;
+    return cells;
+}
 
-    for (size_t i = 0; i < byte_code.size(); i += 5) {
-        const snm::Byte code = byte_code[i];
-        snm::Bytes argument;
+std::vector<snm::Address> MemorySnapshot::Diff(const MemorySnapshot& other) const {
+    std::vector<snm::Address> cells;
 
-        for (size_t j = 0; j < 4; ++j) {
-            argument[j] = byte_code[i + 1 + j];
+    for (size_t page = 0; page < ProgramImage::PAGE_COUNT; ++page) {
+        if (pages_[page] == other.pages_[page]) {
+            continue;
         }
 
-        WriteInstruction(code, argument);
-        arguments_original_.push_back(argument);
-        address++;
+        for (size_t i = 0; i < ProgramImage::PAGE_SIZE; ++i) {
+            const MemoryCell& lhs = pages_[page][i];
+            const MemoryCell& rhs = other.pages_[page][i];
+            if (lhs.opcode != rhs.opcode
+                || static_cast<snm::Word>(lhs.argument) != static_cast<snm::Word>(rhs.argument)) {
+                cells.push_back(static_cast<snm::Address>(page * ProgramImage::PAGE_SIZE + i));
+            }
+        }
     }
 
-    opcodes_.shrink_to_fit();
-    arguments_.shrink_to_fit();
-    arguments_original_.shrink_to_fit();
-    arguments_original_ = arguments_;
+    return cells;
 }
 
-std::pair<snm::Byte, snm::Bytes> MemoryManager::ReadInstruction(const snm::Address address) {
-    if (address > opcodes_.size() - 1 || opcodes_.empty()) {
-        throw std::out_of_range("Instruction address out of range.");
-    }
+MemoryManager::MemoryManager() :
+    image_(std::make_shared<ProgramImage>()),
+    image_owned_(true) {
+    MapPages();
+}
+
+void MemoryManager::Load(const snm::ByteCode& byte_code) {
+    Load(std::span(byte_code));
+}
 
-    return std::make_pair(opcodes_[address], arguments_[address]);
+void MemoryManager::Load(const std::span<const snm::Byte> byte_code) {
+    Reset();
+    Load(std::make_shared<ProgramImage>(byte_code));
+    image_owned_ = true;
+}
+
+void MemoryManager::Load(std::shared_ptr<const ProgramImage> image) {
+    ++code_revision_;
+    image_ = std::move(image);
+    image_owned_ = false;
+    ResetData();
+    MapPages();
+}
+
+std::shared_ptr<const ProgramImage> MemoryManager::GetImage() const {
+    return image_;
 }
 
 void MemoryManager::WriteInstruction(const snm::Byte code, const snm::Bytes argument,
                                      const snm::Address address) {
+    ++code_revision_;
+    DetachBase();
+
+    const size_t first_page = std::min<size_t>(image_->Size(), address) / PAGE_SIZE;
+    MutableImage().WriteInstruction(code, argument, address);
+
+    // Коды операций в собственных копиях страниц должны совпадать с образом
+    for (size_t page = first_page; page <= address / PAGE_SIZE; ++page) {
+        if (private_pages_[page]) {
+            const Page& image_page = image_->GetPage(page);
+            for (size_t i = 0; i < PAGE_SIZE; ++i) {
+                (*private_pages_[page])[i].opcode = image_page[i].opcode;
+            }
+        }
+    }
 
-    if (opcodes_.size() <= address) {
-        opcodes_.resize(address + 1);
-        arguments_.resize(address + 1);
+    if (private_pages_[address / PAGE_SIZE]) {
+        (*private_pages_[address / PAGE_SIZE])[address % PAGE_SIZE].argument = argument;
     }
 
-    opcodes_[address] = code;
-    arguments_[address] = argument;
+    MapPages();
 }
 
 void MemoryManager::WriteInstruction(const snm::Byte code, const snm::Bytes argument) {
-    opcodes_.push_back(code);
-    arguments_.push_back(argument);
+    if (Size() == snm::CODE_MEMORY_SIZE) {
+        throw std::out_of_range("Command size exceeds available memory.");
+    }
+
+    WriteInstruction(code, argument, static_cast<snm::Address>(Size()));
+}
+
+void MemoryManager::Reset() {
+    Load(std::make_shared<ProgramImage>());
+    image_owned_ = true;
+}
+
+void MemoryManager::ResetData() {
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        if (private_pages_[page]) {
+            spare_pages_.push_back(std::move(private_pages_[page]));
+            pages_[page] = image_->GetPage(page).data();
+        }
+    }
+
+    if (base_) {
+        base_.reset();
+        MapPages();
+    }
+}
+
+void MemoryManager::Restore(std::shared_ptr<const MemorySnapshot> snapshot) {
+    ++code_revision_;
+    ResetData();
+
+    image_ = snapshot->image_;
+    image_owned_ = false;
+    base_ = std::move(snapshot);
+    MapPages();
+}
+
+size_t MemoryManager::Size() const {
+    return image_->Size();
+}
+
+size_t MemoryManager::CodeRevision() const {
+    return code_revision_;
+}
+
+size_t MemoryManager::GetPrivatePageCount() const {
+    return std::ranges::count_if(private_pages_, [](const auto& page) {
+        return page != nullptr;
+    });
+}
+
+void MemoryManager::WatchArgument(const snm::Address address) {
+    watched_.set(address);
+}
+
+std::vector<snm::Address> MemoryManager::TakeWatchedWrites() {
+    return std::exchange(watched_writes_, {});
 }
 
-void MemoryManager::WriteArgument(const snm::Bytes argument, const snm::Address address) {
-    if (arguments_.size() <= address) {
-        arguments_.resize(address + 1);
+void MemoryManager::ClearWatches() {
+    watched_.reset();
+    watched_writes_.clear();
+}
+
+MemorySnapshot MemoryManager::TakeSnapshot() const {
+    MemorySnapshot snapshot;
+    snapshot.image_ = image_;
+    snapshot.base_ = base_;
+    snapshot.copies_.reserve(GetPrivatePageCount());
+
+    // Страницы восстановленного снимка неизменяемы, поэтому новый снимок ссылается на них без копирования
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        if (private_pages_[page]) {
+            snapshot.pages_[page] = snapshot.copies_.emplace_back(*private_pages_[page]).data();
+        } else {
+            snapshot.pages_[page] = pages_[page];
+        }
     }
 
-    arguments_[address] = argument;
+    return snapshot;
 }
 
-snm::Bytes MemoryManager::ReadArgument(const snm::Address address) const {
-    if (arguments_.size() <= address || arguments_.empty()) {
-        return {};
+void MemoryManager::CopyPage(const size_t page) {
+    std::unique_ptr<Page> copy;
+    if (spare_pages_.empty()) {
+        copy = std::make_unique<Page>();
+    } else {
+        copy = std::move(spare_pages_.back());
+        spare_pages_.pop_back();
     }
+    std::copy_n(pages_[page], PAGE_SIZE, copy->begin());
 
-    return arguments_[address];
+    pages_[page] = copy->data();
+    private_pages_[page] = std::move(copy);
 }
 
-void MemoryManager::Reset() {
-    opcodes_.clear();
-    arguments_.clear();
-    arguments_original_.clear();
+void MemoryManager::MapPages() {
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        if (private_pages_[page]) {
+            pages_[page] = private_pages_[page]->data();
+        } else {
+            pages_[page] = base_ ? base_->pages_[page] : image_->GetPage(page).data();
+        }
+    }
 }
 
-void MemoryManager::ResetData() {
-    arguments_ = arguments_original_;
+void MemoryManager::DetachBase() {
+    if (!base_) {
+        return;
+    }
+
+    for (size_t page = 0; page < PAGE_COUNT; ++page) {
+        if (!private_pages_[page] && pages_[page] != image_->GetPage(page).data()) {
+            CopyPage(page);
+        }
+    }
+    base_.reset();
 }
 
-size_t MemoryManager::Size() const {
-    return opcodes_.size();
+ProgramImage& MemoryManager::MutableImage() {
+    if (!image_owned_ || image_.use_count() != 1) {
+        image_ = std::make_shared<ProgramImage>(*image_);
+        image_owned_ = true;
+    }
+
+    // Образ создан менеджером как изменяемый объект и не разделяется с другими владельцами
+    return const_cast<ProgramImage&>(*image_);
 }
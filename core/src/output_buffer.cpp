@@ -0,0 +1,14 @@
+#include "core/output_buffer.hpp"
+
+void OutputBuffer::Write(const std::string_view text) {
+    std::lock_guard lock(mutex_);
+    pending_.append(text);
+}
+
+bool OutputBuffer::Drain(std::string& output) {
+    output.clear();
+
+    std::lock_guard lock(mutex_);
+    output.swap(pending_);
+    return !output.empty();
+}
@@ -1,10 +1,15 @@
 #include "core/processor.hpp"
 
+#include <algorithm>
+
+#include "core/execution_history.hpp"
+
 Processor::Processor(MemoryManager& memory, ProcessorObserver* observer, ProcessorIo* io) :
     memory_(memory),
     observer_(observer),
     io_(io),
-    state_(snm::ProcessorState::STOPPED) {
+    state_(snm::ProcessorState::STOPPED),
+    execution_mode_(snm::ExecutionMode::THREADED) {
     argument_modifiers_[static_cast<uint8_t>(snm::ArgModifier::NONE)] = snm::ArgModifier::NONE;
     argument_modifiers_[static_cast<uint8_t>(snm::ArgModifier::REF)] = snm::ArgModifier::REF;
     argument_modifiers_[static_cast<uint8_t>(snm::ArgModifier::REF_REF)] = snm::ArgModifier::REF_REF;
@@ -197,6 +202,25 @@ Processor::Processor(MemoryManager& memory, ProcessorObserver* observer, Process
         Halt();
     };
 
+
+    PublishSnapshot();
+}
+
+SnapshotDiff SnapshotDiff::Compare(const ProcessorSnapshot& before, const ProcessorSnapshot& after) {
+    return {
+        .accumulator = static_cast<snm::Word>(before.registers.accumulator)
+                       != static_cast<snm::Word>(after.registers.accumulator),
+        .auxiliary = static_cast<snm::Word>(before.registers.auxiliary)
+                     != static_cast<snm::Word>(after.registers.auxiliary),
+        .instruction_pointer = before.registers.instruction_pointer != after.registers.instruction_pointer,
+        .state = before.state != after.state,
+        .instruction_count = before.instruction_count != after.instruction_count,
+        .cells = before.memory.Diff(after.memory)
+    };
+}
+
+bool SnapshotDiff::Empty() const {
+    return !accumulator && !auxiliary && !instruction_pointer && !state && !instruction_count && cells.empty();
 }
 
 /*
@@ -204,21 +228,111 @@ Processor::Processor(MemoryManager& memory, ProcessorObserver* observer, Process
 */
 
 void Processor::Run() {
-    SetState(snm::ProcessorState::RUNNING);
+    Execute(std::numeric_limits<uint64_t>::max(), true);
+}
 
-    while (IsRunning()) {
-        if (state_ == snm::ProcessorState::PAUSED_BY_IO) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            continue;
+snm::StopReason Processor::RunFor(const uint64_t instruction_budget) {
+    try {
+        return Execute(instruction_budget, false);
+    } catch (const std::exception& e) {
+        last_error_ = e.what();
+        SetState(snm::ProcessorState::STOPPED);
+        return snm::StopReason::EXECUTION_ERROR;
+    }
+}
+
+snm::StopReason Processor::Resume() {
+    return RunFor(std::numeric_limits<uint64_t>::max());
+}
+
+const std::string& Processor::GetLastError() const {
+    return last_error_;
+}
+
+snm::StopReason Processor::Execute(const uint64_t instruction_budget, const bool wait_for_input) {
+    const uint64_t limit = instruction_budget > std::numeric_limits<uint64_t>::max() - instruction_count_
+                               ? std::numeric_limits<uint64_t>::max()
+                               : instruction_count_ + instruction_budget;
+
+    SetRunLoopActive(true);
+
+    snm::StopReason reason;
+    try {
+        if (execution_mode_ == snm::ExecutionMode::REFERENCE) {
+            reason = RunReference(limit, wait_for_input);
+        } else if (execution_mode_ == snm::ExecutionMode::JIT && !observer_ && !profiler_ && !history_
+                   && !breakpoints_enabled_ && JitCompiler::IsSupported()) {
+            reason = RunJit(limit, wait_for_input);
+        } else if (observer_) {
+            reason = RunInstrumented<Observed>(limit, wait_for_input);
+        } else {
+            reason = RunInstrumented<Unobserved>(limit, wait_for_input);
         }
+    } catch (...) {
+        SetRunLoopActive(false);
+        throw;
+    }
 
-        ExecuteInstruction();
+    // Значение, введённое до следующего вызова, должно дождаться цикла исполнения, а не применяться сразу
+    if (reason != snm::StopReason::INPUT_NEEDED) {
+        SetRunLoopActive(false);
     }
 
-    SetState(snm::ProcessorState::STOPPED);
+    return reason;
+}
+
+snm::StopReason Processor::RunReference(const uint64_t limit, const bool wait_for_input) {
+    // Остановка, запрошенная до запуска цикла, завершает его до перехода в RUNNING
+    if (stop_requested_.load(std::memory_order_relaxed)) {
+        return AcceptStop();
+    }
+
+    if (state_ != snm::ProcessorState::PAUSED_BY_IO) {
+        SetState(snm::ProcessorState::RUNNING);
+    }
+
+    while (true) {
+        // Stop() только выставляет запрос, поэтому состояние и наблюдатель изменяются в потоке исполнения
+        if (stop_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            return AcceptStop();
+        }
+
+        const snm::ProcessorState state = state_.load(std::memory_order_relaxed);
+        if (state == snm::ProcessorState::STOPPED) {
+            stop_requested_.store(false, std::memory_order_relaxed);
+            return snm::StopReason::HALTED;
+        }
+        if (state == snm::ProcessorState::BREAKPOINT) {
+            return snm::StopReason::BREAKPOINT;
+        }
+        if (snapshot_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            PublishSnapshot();
+        }
+
+        if (state == snm::ProcessorState::PAUSED_BY_IO) {
+            if (const std::optional<snm::Bytes> input = wait_for_input ? AwaitInput() : TakeInput()) {
+                SetState(snm::ProcessorState::RUNNING);
+                registers_.accumulator = *input;
+                NextInstruction();
+            } else if (!wait_for_input && state_ == snm::ProcessorState::PAUSED_BY_IO) {
+                return snm::StopReason::INPUT_NEEDED;
+            }
+        } else if (instruction_count_ >= limit) {
+            return ExhaustBudget();
+        } else {
+            ExecuteInstruction();
+        }
+
+        if (breakpoints_enabled_) {
+            CheckBreakpoint();
+        }
+    }
 }
 
 void Processor::Step() {
+    // Пошаговое исполнение прерывает приостановленный RunFor(): введённые значения применяются сразу
+    SetRunLoopActive(false);
+    stop_requested_ = false;
     SetState(snm::ProcessorState::RUNNING);
     ExecuteInstruction();
     if (IsRunning()) {
@@ -227,17 +341,198 @@ void Processor::Step() {
 }
 
 void Processor::Stop() {
+    stop_requested_ = true;
+
+    // Под мьютексом ожидающий ввода цикл не может пропустить оповещение между проверкой запроса и ожиданием
+    std::lock_guard lock(input_mutex_);
+    input_ready_.notify_all();
+}
+
+snm::StopReason Processor::ExhaustBudget() {
+    // Эталонный интерпретатор останавливается сразу при переходе за конец программы, а предварительно
+    // декодированный код только при выборке следующей инструкции. Конец кода проверяется раньше бюджета,
+    // чтобы последняя инструкция бюджета, завершающая программу, давала во всех режимах HALTED.
+    if (memory_.ReadInstruction(registers_.instruction_pointer).first == snm::END_OF_CODE) {
+        SetState(snm::ProcessorState::STOPPED);
+        return snm::StopReason::HALTED;
+    }
+
+    SetState(snm::ProcessorState::PAUSED);
+    return snm::StopReason::BUDGET_EXHAUSTED;
+}
+
+snm::StopReason Processor::AcceptStop() {
+    stop_requested_.store(false, std::memory_order_relaxed);
     SetState(snm::ProcessorState::STOPPED);
+    return snm::StopReason::HALTED;
 }
 
 void Processor::Reset() {
     SetAccumulator(0);
     SetAuxiliary(0);
     SetInstructionPointer(0);
+    instruction_count_ = 0;
+
+    if (history_) {
+        history_->Clear();
+    }
 
+    SetRunLoopActive(false);
+    stop_requested_ = false;
     SetState(snm::ProcessorState::STOPPED);
 }
 
+std::shared_ptr<const ProcessorSnapshot> Processor::GetSnapshot() {
+    snapshot_requested_.store(true, std::memory_order_relaxed);
+
+    std::lock_guard lock(snapshot_mutex_);
+    return snapshot_;
+}
+
+void Processor::PublishSnapshot() {
+    snapshot_requested_.store(false, std::memory_order_relaxed);
+
+    // Снимок строится без блокировки, под мьютексом только заменяется указатель
+    auto snapshot = CaptureSnapshot();
+
+    std::lock_guard lock(snapshot_mutex_);
+    snapshot_ = std::move(snapshot);
+}
+
+std::shared_ptr<const ProcessorSnapshot> Processor::CaptureSnapshot() const {
+    return std::make_shared<const ProcessorSnapshot>(
+        ProcessorSnapshot{registers_, state_.load(), instruction_count_, memory_.TakeSnapshot()});
+}
+
+void Processor::Restore(std::shared_ptr<const ProcessorSnapshot> snapshot) {
+    SetRunLoopActive(false);
+    stop_requested_ = false;
+
+    if (history_) {
+        history_->Clear();
+    }
+
+    RestoreRegistersAndMemory(snapshot);
+
+    snm::ProcessorState state = snapshot->state;
+    if (state == snm::ProcessorState::PAUSED_BY_IO) {
+        // Инструкция ввода не завершена: она исполняется повторно и снова запрашивает значение
+        state = snm::ProcessorState::PAUSED;
+        --instruction_count_;
+    } else if (state == snm::ProcessorState::RUNNING) {
+        state = snm::ProcessorState::PAUSED;
+    }
+    ReplaceState(state);
+}
+
+void Processor::SetHistory(ExecutionHistory* history) {
+    history_ = history;
+}
+
+bool Processor::StepBack() {
+    if (!history_ || history_->Size() == 0) {
+        return false;
+    }
+
+    return RewindTo(instruction_count_ - 1);
+}
+
+bool Processor::ReverseContinue() {
+    if (!history_ || history_->Size() == 0) {
+        return false;
+    }
+
+    const std::optional<uint64_t> breakpoint = breakpoints_enabled_ ? history_->FindLast(breakpoints_) : std::nullopt;
+    if (!RewindTo(breakpoint.value_or(history_->GetFirstInstructionCount()))) {
+        return false;
+    }
+
+    if (breakpoint) {
+        ReplaceState(snm::ProcessorState::BREAKPOINT);
+    }
+    return breakpoint.has_value();
+}
+
+bool Processor::RewindTo(const uint64_t instruction_count) {
+    if (!history_ || history_->GetEndInstructionCount() != instruction_count_
+        || instruction_count < history_->GetFirstInstructionCount() || instruction_count > instruction_count_) {
+        return false;
+    }
+
+    SetRunLoopActive(false);
+    stop_requested_ = false;
+
+    // Снимок заменяет отмену записей, сделанных после него
+    if (const auto checkpoint = history_->RewindToCheckpoint(instruction_count)) {
+        RestoreRegistersAndMemory(checkpoint);
+        history_->UpdateCodeRevision(memory_.CodeRevision());
+    }
+
+    while (instruction_count_ > instruction_count) {
+        UndoInstruction();
+    }
+
+    ReplaceState(snm::ProcessorState::PAUSED);
+    return true;
+}
+
+void Processor::ReplaceState(const snm::ProcessorState state) {
+    // SetState() не переводит процессор из ожидания ввода в паузу, поэтому состояние задаётся напрямую
+    if (state_ != state) {
+        state_ = state;
+        if (observer_) {
+            observer_->OnStateChanged(state);
+        }
+    }
+}
+
+void Processor::RestoreRegistersAndMemory(const std::shared_ptr<const ProcessorSnapshot>& snapshot) {
+    std::optional<MemorySnapshot> previous;
+    if (observer_) {
+        previous = memory_.TakeSnapshot();
+    }
+
+    // Память ссылается на снимок процессора, поэтому указатель на неё разделяет с ним владение
+    memory_.Restore(std::shared_ptr<const MemorySnapshot>(snapshot, &snapshot->memory));
+
+    SetAccumulator(snapshot->registers.accumulator);
+    SetAuxiliary(snapshot->registers.auxiliary);
+    SetInstructionPointer(snapshot->registers.instruction_pointer);
+    instruction_count_ = snapshot->instruction_count;
+
+    if (previous) {
+        for (const snm::Address address : previous->Diff(snapshot->memory)) {
+            observer_->OnMemoryChanged(address);
+        }
+    }
+}
+
+void Processor::RecordInstruction() {
+    if (!history_->Continues(instruction_count_, memory_.CodeRevision())) {
+        history_->Start(instruction_count_, memory_.CodeRevision());
+    }
+    if (history_->NeedsCheckpoint()) {
+        history_->AddCheckpoint(CaptureSnapshot());
+    }
+    history_->Record(registers_);
+}
+
+void Processor::UndoInstruction() {
+    const UndoRecord record = history_->PopBack();
+
+    if (record.memory_written) {
+        memory_.WriteArgument(record.argument, record.address);
+        if (observer_) {
+            observer_->OnMemoryChanged(record.address);
+        }
+    }
+
+    SetAccumulator(record.registers.accumulator);
+    SetAuxiliary(record.registers.auxiliary);
+    SetInstructionPointer(record.registers.instruction_pointer);
+    --instruction_count_;
+}
+
 const Registers& Processor::GetRegisters() const {
     return registers_;
 }
@@ -250,6 +545,38 @@ void Processor::SetIo(ProcessorIo* io) {
     io_ = io;
 }
 
+void Processor::SetProfiler(Profiler* profiler) {
+    profiler_ = profiler;
+}
+
+void Processor::SetExecutionMode(const snm::ExecutionMode mode) {
+    execution_mode_ = mode;
+}
+
+snm::ExecutionMode Processor::GetExecutionMode() const {
+    return execution_mode_;
+}
+
+void Processor::SetBreakpoint(const snm::Address address) {
+    breakpoints_.set(address);
+}
+
+void Processor::RemoveBreakpoint(const snm::Address address) {
+    breakpoints_.reset(address);
+}
+
+void Processor::ClearBreakpoints() {
+    breakpoints_.reset();
+}
+
+bool Processor::HasBreakpoint(const snm::Address address) const {
+    return breakpoints_.test(address);
+}
+
+void Processor::SetBreakpointsEnabled(const bool enabled) {
+    breakpoints_enabled_ = enabled;
+}
+
 const snm::Bytes& Processor::GetAccumulator() const {
     return registers_.accumulator;
 }
@@ -274,21 +601,32 @@ void Processor::SetInstructionPointer(const snm::Address value) {
     }
 }
 
-const snm::ProcessorState& Processor::GetState() const {
+snm::ProcessorState Processor::GetState() const {
     return state_;
 }
 
+uint64_t Processor::GetInstructionCount() const {
+    return instruction_count_;
+}
+
 void Processor::ExecuteInstruction() {
-    snm::Byte code;
-    snm::Bytes argument;
+    const auto [code, argument] = memory_.ReadInstruction(registers_.instruction_pointer);
 
-    try {
-        std::tie(code, argument) = memory_.ReadInstruction(registers_.instruction_pointer);
-    } catch ([[maybe_unused]] std::out_of_range& e) {
+    if (code == snm::END_OF_CODE) {
         SetState(snm::ProcessorState::STOPPED);
         return;
     }
 
+    if (history_) {
+        RecordInstruction();
+    }
+
+    ++instruction_count_;
+
+    if (profiler_) {
+        profiler_->OnInstruction(registers_.instruction_pointer, code);
+    }
+
     snm::Byte handler;
 
     if (code == std::numeric_limits<snm::Byte>::max()) {
@@ -338,6 +676,13 @@ snm::Type Processor::TypeIo() {
     return type;
 }
 
+void Processor::CheckBreakpoint() {
+    // Пока процессор ожидает ввода, IP указывает на инструкцию ввода и не должен считаться достигнутым
+    if (state_ == snm::ProcessorState::RUNNING && breakpoints_.test(registers_.instruction_pointer)) {
+        SetState(snm::ProcessorState::BREAKPOINT);
+    }
+}
+
 void Processor::SetState(const snm::ProcessorState state) {
     if (state_ != state) {
         if (state_ == snm::ProcessorState::PAUSED_BY_IO && state == snm::ProcessorState::PAUSED) {
@@ -346,12 +691,69 @@ void Processor::SetState(const snm::ProcessorState state) {
             state_ = state;
 
             if (observer_) {
-                observer_->OnStateChanged(state_);
+                observer_->OnStateChanged(state);
             }
         }
     }
 }
 
+void Processor::RequestInput(const snm::Type type) {
+    SetState(snm::ProcessorState::PAUSED_BY_IO);
+
+    io_->InputRequest(type, [this](const snm::Bytes bytes) {
+        ProvideInput(bytes);
+    });
+}
+
+void Processor::ProvideInput(const snm::Bytes bytes) {
+    std::unique_lock lock(input_mutex_);
+
+    if (state_ != snm::ProcessorState::PAUSED_BY_IO) {
+        return;
+    }
+
+    if (run_loop_active_) {
+        // Оповещение под мьютексом: после пробуждения цикл может завершить Run() и процессор может быть разрушен
+        pending_input_ = bytes;
+        input_ready_.notify_one();
+        return;
+    }
+
+    lock.unlock();
+
+    SetState(snm::ProcessorState::RUNNING);
+    registers_.accumulator = bytes;
+    NextInstruction();
+}
+
+std::optional<snm::Bytes> Processor::AwaitInput() {
+    std::unique_lock lock(input_mutex_);
+    input_ready_.wait(lock, [this] {
+        return pending_input_ || stop_requested_ || state_ != snm::ProcessorState::PAUSED_BY_IO;
+    });
+
+    // Введённое значение отбрасывается: после остановки инструкция ввода не завершается
+    std::optional<snm::Bytes> input = std::exchange(pending_input_, std::nullopt);
+    if (stop_requested_ || state_ != snm::ProcessorState::PAUSED_BY_IO) {
+        return std::nullopt;
+    }
+    return input;
+}
+
+std::optional<snm::Bytes> Processor::TakeInput() {
+    std::lock_guard lock(input_mutex_);
+    return std::exchange(pending_input_, std::nullopt);
+}
+
+void Processor::SetRunLoopActive(const bool active) {
+    std::lock_guard lock(input_mutex_);
+    run_loop_active_ = active;
+
+    if (!active) {
+        pending_input_.reset();
+    }
+}
+
 /*
  *  Реализация инструкций
  */
@@ -432,6 +834,9 @@ void Processor::Store() {
         throw std::out_of_range(std::format("IP {}: Address {} exceeds available memory.", std::to_string(registers_.instruction_pointer), std::to_string(address)));
     }
 
+    if (history_) {
+        history_->RecordMemoryWrite(address, memory_.ReadArgument(address));
+    }
     memory_.WriteArgument(registers_.accumulator, address);
 
     if (observer_) {
@@ -448,15 +853,7 @@ void Processor::Store() {
 template <typename T>
 void Processor::Input() {
     if (io_) {
-        SetState(snm::ProcessorState::PAUSED_BY_IO);
-
-        io_->InputRequest(TypeIo<T>(), [this](const snm::Bytes bytes) {
-            if (state_ == snm::ProcessorState::PAUSED_BY_IO) {
-                SetState(snm::ProcessorState::RUNNING);
-                registers_.accumulator = bytes;
-                NextInstruction();
-            }
-        });
+        RequestInput(TypeIo<T>());
     }
 }
 
@@ -481,7 +878,13 @@ void Processor::Jump() {
 
 template <class T>
 void Processor::SkipLower() {
-    if (static_cast<T>(registers_.accumulator) < static_cast<T>(registers_.auxiliary)) {
+    const bool taken = static_cast<T>(registers_.accumulator) < static_cast<T>(registers_.auxiliary);
+
+    if (profiler_) {
+        profiler_->OnBranch(registers_.instruction_pointer, taken);
+    }
+
+    if (taken) {
         SetInstructionPointer(registers_.instruction_pointer + 2);
     } else {
         NextInstruction();
@@ -490,7 +893,13 @@ void Processor::SkipLower() {
 
 template <class T>
 void Processor::SkipGreater() {
-    if (static_cast<T>(registers_.accumulator) > static_cast<T>(registers_.auxiliary)) {
+    const bool taken = static_cast<T>(registers_.accumulator) > static_cast<T>(registers_.auxiliary);
+
+    if (profiler_) {
+        profiler_->OnBranch(registers_.instruction_pointer, taken);
+    }
+
+    if (taken) {
         SetInstructionPointer(registers_.instruction_pointer + 2);
     } else {
         NextInstruction();
@@ -499,7 +908,13 @@ void Processor::SkipGreater() {
 
 template <class T>
 void Processor::SkipEqual() {
-    if (static_cast<T>(registers_.accumulator) == static_cast<T>(registers_.auxiliary)) {
+    const bool taken = static_cast<T>(registers_.accumulator) == static_cast<T>(registers_.auxiliary);
+
+    if (profiler_) {
+        profiler_->OnBranch(registers_.instruction_pointer, taken);
+    }
+
+    if (taken) {
         SetInstructionPointer(registers_.instruction_pointer + 2);
     } else {
         NextInstruction();
@@ -508,6 +923,9 @@ void Processor::SkipEqual() {
 
 void Processor::JumpAndStore() {
     const auto address = static_cast<snm::Word>(registers_.auxiliary);
+    if (history_) {
+        history_->RecordMemoryWrite(address, memory_.ReadArgument(address));
+    }
     memory_.WriteArgument(snm::Bytes(registers_.instruction_pointer + 1), address);
     if (observer_) {
         observer_->OnMemoryChanged(address);
@@ -516,5 +934,559 @@ void Processor::JumpAndStore() {
 }
 
 void Processor::Halt() {
-    Stop();
+    SetState(snm::ProcessorState::STOPPED);
+}
+
+/*
+ *  Предварительно декодированная программа
+ */
+
+namespace {
+    /**
+     * @brief Полный байт кода операции. В отличие от snm::InstructionByte() вычисляется на этапе компиляции.
+     */
+    constexpr snm::Byte CodeOf(const snm::OpCode opcode, const snm::TypeModifier type_modifier,
+                               const snm::ArgModifier arg_modifier = snm::ArgModifier::NONE) {
+        return static_cast<snm::Byte>(static_cast<int>(opcode) << 4 | static_cast<int>(type_modifier) << 2
+                                      | static_cast<int>(arg_modifier));
+    }
+
+    template <snm::TypeModifier Modifier>
+    using TypeOf = std::conditional_t<Modifier == snm::TypeModifier::C, snm::Byte,
+                   std::conditional_t<Modifier == snm::TypeModifier::W, snm::Word,
+                   std::conditional_t<Modifier == snm::TypeModifier::SW, snm::SignedWord, snm::Real>>>;
+}
+
+/**
+ * @brief Политика исполнения без наблюдателя: уведомления не формируются.
+ */
+struct Processor::Unobserved {
+    static void AccumulatorChanged(Processor&) {
+    }
+
+    static void AuxiliaryChanged(Processor&) {
+    }
+
+    static void InstructionPointerChanged(Processor&) {
+    }
+
+    static void MemoryChanged(Processor&, snm::Address) {
+    }
+
+    static void InstructionStarting(Processor&) {
+    }
+
+    static void MemoryWriting(Processor&, snm::Address) {
+    }
+
+    static void InstructionExecuted(Processor&, snm::Byte) {
+    }
+
+    static void BranchExecuted(Processor&, bool) {
+    }
+
+    static void FusionExecuted(Processor&, snm::Fusion, uint64_t) {
+    }
+
+    static void FusionFallback(Processor&, snm::Fusion) {
+    }
+};
+
+/**
+ * @brief Политика исполнения с наблюдателем: уведомления в том же порядке, что и в эталонном интерпретаторе.
+ */
+struct Processor::Observed {
+    static void AccumulatorChanged(Processor& processor) {
+        processor.observer_->OnRegisterAccChanged(processor.registers_.accumulator);
+    }
+
+    static void AuxiliaryChanged(Processor& processor) {
+        processor.observer_->OnRegisterAuxChanged(processor.registers_.auxiliary);
+    }
+
+    static void InstructionPointerChanged(Processor& processor) {
+        processor.observer_->OnRegisterIpChanged(processor.registers_.instruction_pointer);
+    }
+
+    static void MemoryChanged(Processor& processor, const snm::Address address) {
+        processor.observer_->OnMemoryChanged(address);
+    }
+
+    static void InstructionStarting(Processor&) {
+    }
+
+    static void MemoryWriting(Processor&, snm::Address) {
+    }
+
+    static void InstructionExecuted(Processor&, snm::Byte) {
+    }
+
+    static void BranchExecuted(Processor&, bool) {
+    }
+
+    static void FusionExecuted(Processor&, snm::Fusion, uint64_t) {
+    }
+
+    static void FusionFallback(Processor&, snm::Fusion) {
+    }
+};
+
+/**
+ * @brief Политика исполнения с профилировщиком: уведомления как в Policy, инструкции учитываются в профиле.
+ */
+template <class Policy>
+struct Processor::Profiled : Policy {
+    static void InstructionExecuted(Processor& processor, const snm::Byte code) {
+        processor.profiler_->OnInstruction(processor.registers_.instruction_pointer, code);
+    }
+
+    static void BranchExecuted(Processor& processor, const bool taken) {
+        processor.profiler_->OnBranch(processor.registers_.instruction_pointer, taken);
+    }
+
+    static void FusionExecuted(Processor& processor, const snm::Fusion fusion, const uint64_t instructions) {
+        processor.profiler_->OnFusion(fusion, instructions);
+    }
+
+    static void FusionFallback(Processor& processor, const snm::Fusion fusion) {
+        processor.profiler_->OnFusionFallback(fusion);
+    }
+};
+
+/**
+ * @brief Политика исполнения с журналом: уведомления и профиль как в Policy, перед каждой инструкцией и записью
+ * в память сохраняются данные для её отмены.
+ */
+template <class Policy>
+struct Processor::Recorded : Policy {
+    static void InstructionStarting(Processor& processor) {
+        processor.RecordInstruction();
+    }
+
+    static void MemoryWriting(Processor& processor, const snm::Address address) {
+        processor.history_->RecordMemoryWrite(address, processor.memory_.ReadArgument(address));
+    }
+};
+
+template <class Policy, size_t... Codes>
+constexpr std::array<Processor::ThreadedHandler, sizeof...(Codes)>
+Processor::MakeThreadedHandlers(std::index_sequence<Codes...>) {
+    return {(Codes == snm::END_OF_CODE ? &ThreadedEnd : &ThreadedInstruction<static_cast<snm::Byte>(Codes), Policy>)...};
+}
+
+template <class Policy>
+const std::array<Processor::ThreadedHandler, std::numeric_limits<snm::Byte>::max() + 1> Processor::THREADED_HANDLERS =
+    MakeThreadedHandlers<Policy>(std::make_index_sequence<std::numeric_limits<snm::Byte>::max() + 1>{});
+
+template <class Policy>
+constexpr Processor::FusedSequences Processor::MakeFusedSequences() {
+    using enum snm::OpCode;
+    using enum snm::TypeModifier;
+    using enum snm::ArgModifier;
+    using enum snm::Fusion;
+
+    FusedSequences result{};
+    size_t count = 0;
+
+    const auto add = [&]<snm::Fusion Kind, snm::Byte... Codes>() {
+        result[count++] = {{Codes...}, sizeof...(Codes), &ThreadedFused<Policy, Kind, Codes...>};
+    };
+
+    // Тип LOAD, указанный по умолчанию (SW), часто сочетается с явно указанным типом W второй инструкции
+    const auto add_arithmetic = [&]<snm::TypeModifier LoadType, snm::TypeModifier Type>() {
+        add.template operator()<INCREMENT, CodeOf(LOAD, LoadType, REF), CodeOf(ADD, Type), CodeOf(STORE, W)>();
+        add.template operator()<INCREMENT, CodeOf(LOAD, LoadType, REF), CodeOf(ADD, Type, REF), CodeOf(STORE, W)>();
+        add.template operator()<INCREMENT, CodeOf(LOAD, LoadType, REF), CodeOf(SUB, Type), CodeOf(STORE, W)>();
+        add.template operator()<INCREMENT, CodeOf(LOAD, LoadType, REF), CodeOf(SUB, Type, REF), CodeOf(STORE, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_LOWER, Type), CodeOf(JUMP, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_LOWER, Type, REF), CodeOf(JUMP, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_GREATER, Type), CodeOf(JUMP, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_GREATER, Type, REF), CodeOf(JUMP, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_EQUAL, Type), CodeOf(JUMP, W)>();
+        add.template operator()<LOOP_TEST, CodeOf(LOAD, LoadType, REF), CodeOf(SKIP_EQUAL, Type, REF), CodeOf(JUMP, W)>();
+    };
+
+    const auto add_calls = [&]<snm::TypeModifier LoadType>() {
+        add.template operator()<CALL, CodeOf(LOAD, LoadType), CodeOf(JUMPNSTORE, W)>();
+        add.template operator()<CALL, CodeOf(LOAD, LoadType, REF), CodeOf(JUMPNSTORE, W)>();
+        add.template operator()<CALL, CodeOf(LOAD, LoadType, REF_REF), CodeOf(JUMPNSTORE, W)>();
+        add.template operator()<RETURN, CodeOf(LOAD, LoadType), CodeOf(JUMP, W, REF)>();
+        add.template operator()<RETURN, CodeOf(LOAD, LoadType, REF), CodeOf(JUMP, W, REF)>();
+        add.template operator()<RETURN, CodeOf(LOAD, LoadType, REF_REF), CodeOf(JUMP, W, REF)>();
+    };
+
+    add_arithmetic.template operator()<C, C>();
+    add_arithmetic.template operator()<W, W>();
+    add_arithmetic.template operator()<SW, SW>();
+    add_arithmetic.template operator()<R, R>();
+    add_arithmetic.template operator()<SW, W>();
+    add_arithmetic.template operator()<W, SW>();
+
+    add_calls.template operator()<C>();
+    add_calls.template operator()<W>();
+    add_calls.template operator()<SW>();
+    add_calls.template operator()<R>();
+
+    return result;
+}
+
+template <class Policy>
+const Processor::FusedSequences Processor::FUSED_SEQUENCES =
+    MakeFusedSequences<Policy>();
+
+template <class Policy>
+snm::StopReason Processor::RunInstrumented(const uint64_t limit, const bool wait_for_input) {
+    if (profiler_) {
+        return history_ ? RunThreaded<Recorded<Profiled<Policy>>>(limit, wait_for_input)
+                        : RunThreaded<Profiled<Policy>>(limit, wait_for_input);
+    }
+    return history_ ? RunThreaded<Recorded<Policy>>(limit, wait_for_input)
+                    : RunThreaded<Policy>(limit, wait_for_input);
+}
+
+template <class Policy>
+snm::StopReason Processor::RunThreaded(const uint64_t limit, const bool wait_for_input) {
+    return breakpoints_enabled_ ? RunThreadedLoop<Policy, true>(limit, wait_for_input)
+                                : RunThreadedLoop<Policy, false>(limit, wait_for_input);
+}
+
+template <class Policy, bool Breakpoints>
+snm::StopReason Processor::RunThreadedLoop(const uint64_t limit, const bool wait_for_input) {
+    const auto& handlers = THREADED_HANDLERS<Policy>;
+    // Режим JIT с наблюдателем, профилировщиком, журналом или точками останова исполняется как FUSED
+    const bool fused = execution_mode_ == snm::ExecutionMode::FUSED || execution_mode_ == snm::ExecutionMode::JIT;
+
+    if (threaded_code_.empty() || threaded_code_revision_ != memory_.CodeRevision()
+        || threaded_code_handlers_ != handlers.data() || threaded_code_fused_ != fused) {
+        DecodeThreadedCode(handlers, fused ? std::span<const FusedSequence>(FUSED_SEQUENCES<Policy>)
+                                           : std::span<const FusedSequence>());
+    }
+    instruction_limit_ = limit;
+
+    // Остановка, запрошенная до запуска цикла, завершает его до перехода в RUNNING
+    if (stop_requested_.load(std::memory_order_relaxed)) {
+        return AcceptStop();
+    }
+
+    if (state_ != snm::ProcessorState::PAUSED_BY_IO) {
+        SetState(snm::ProcessorState::RUNNING);
+    }
+
+    const ThreadedHandler* code = threaded_code_.data();
+
+    while (true) {
+        // Stop() только выставляет запрос, поэтому состояние и наблюдатель изменяются в потоке исполнения
+        if (stop_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            return AcceptStop();
+        }
+
+        const snm::ProcessorState state = state_.load(std::memory_order_relaxed);
+        if (state == snm::ProcessorState::STOPPED) {
+            stop_requested_.store(false, std::memory_order_relaxed);
+            return snm::StopReason::HALTED;
+        }
+        if (state == snm::ProcessorState::BREAKPOINT) {
+            return snm::StopReason::BREAKPOINT;
+        }
+        if (snapshot_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            PublishSnapshot();
+        }
+
+        if (state == snm::ProcessorState::PAUSED_BY_IO) {
+            if (const std::optional<snm::Bytes> input = wait_for_input ? AwaitInput() : TakeInput()) {
+                SetState(snm::ProcessorState::RUNNING);
+                registers_.accumulator = *input;
+                JumpTo<Policy>(registers_.instruction_pointer + 1);
+            } else if (!wait_for_input && state_ == snm::ProcessorState::PAUSED_BY_IO) {
+                return snm::StopReason::INPUT_NEEDED;
+            }
+        } else if (instruction_count_ >= limit) {
+            return ExhaustBudget();
+        } else {
+            code[registers_.instruction_pointer](*this);
+        }
+
+        if constexpr (Breakpoints) {
+            CheckBreakpoint();
+        }
+    }
+}
+
+snm::StopReason Processor::RunJit(const uint64_t limit, const bool wait_for_input) {
+    const auto& handlers = THREADED_HANDLERS<Unobserved>;
+
+    if (threaded_code_.empty() || threaded_code_revision_ != memory_.CodeRevision()
+        || threaded_code_handlers_ != handlers.data() || threaded_code_fused_) {
+        DecodeThreadedCode(handlers, std::span<const FusedSequence>());
+    }
+    if (!jit_compiler_) {
+        jit_compiler_ = std::make_unique<JitCompiler>(memory_, stop_requested_, snapshot_requested_);
+    }
+
+    // Остановка, запрошенная до запуска цикла, завершает его до перехода в RUNNING
+    if (stop_requested_.load(std::memory_order_relaxed)) {
+        return AcceptStop();
+    }
+
+    if (state_ != snm::ProcessorState::PAUSED_BY_IO) {
+        SetState(snm::ProcessorState::RUNNING);
+    }
+
+    const ThreadedHandler* code = threaded_code_.data();
+
+    while (true) {
+        // Stop() только выставляет запрос, поэтому состояние и наблюдатель изменяются в потоке исполнения
+        if (stop_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            return AcceptStop();
+        }
+
+        const snm::ProcessorState state = state_.load(std::memory_order_relaxed);
+        if (state == snm::ProcessorState::STOPPED) {
+            stop_requested_.store(false, std::memory_order_relaxed);
+            return snm::StopReason::HALTED;
+        }
+        if (snapshot_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+            PublishSnapshot();
+        }
+
+        if (state == snm::ProcessorState::PAUSED_BY_IO) {
+            if (const std::optional<snm::Bytes> input = wait_for_input ? AwaitInput() : TakeInput()) {
+                SetState(snm::ProcessorState::RUNNING);
+                registers_.accumulator = *input;
+                JumpTo<Unobserved>(registers_.instruction_pointer + 1);
+            } else if (!wait_for_input && state_ == snm::ProcessorState::PAUSED_BY_IO) {
+                return snm::StopReason::INPUT_NEEDED;
+            }
+        } else if (instruction_count_ >= limit) {
+            return ExhaustBudget();
+        } else {
+            const uint64_t budget = limit - instruction_count_;
+            const JitCompiler::Block* block = jit_compiler_->GetBlock(registers_.instruction_pointer);
+
+            // Участок не выполняет ни одной инструкции, если первая из них должна выбросить исключение
+            uint64_t executed = 0;
+            if (block && block->length <= budget) {
+                executed = jit_compiler_->Execute(*block, registers_, budget);
+                instruction_count_ += executed;
+            }
+            if (executed == 0) {
+                code[registers_.instruction_pointer](*this);
+            }
+        }
+    }
+}
+
+void Processor::DecodeThreadedCode(const std::array<ThreadedHandler, std::numeric_limits<snm::Byte>::max() + 1>& handlers,
+                                   const std::span<const FusedSequence> fused_sequences) {
+    threaded_code_.resize(snm::CODE_MEMORY_SIZE);
+
+    for (size_t address = 0; address < snm::CODE_MEMORY_SIZE; ++address) {
+        threaded_code_[address] = handlers[memory_.ReadInstruction(address).first];
+    }
+
+    // Коды операций не изменяются во время исполнения: запись инструкции меняет ревизию и программа декодируется
+    // заново. Аргументы читаются слитыми операциями во время исполнения, поэтому их запись учитывать не нужно.
+    const size_t size = memory_.Size();
+    for (size_t address = 0; address < size; ++address) {
+        for (const FusedSequence& sequence : fused_sequences) {
+            if (address + sequence.length > size) {
+                continue;
+            }
+
+            size_t matched = 0;
+            while (matched < sequence.length
+                   && memory_.ReadInstruction(static_cast<snm::Address>(address + matched)).first
+                          == sequence.codes[matched]) {
+                ++matched;
+            }
+
+            if (matched == sequence.length) {
+                threaded_code_[address] = sequence.handler;
+                break;
+            }
+        }
+    }
+
+    threaded_code_revision_ = memory_.CodeRevision();
+    threaded_code_handlers_ = handlers.data();
+    threaded_code_fused_ = !fused_sequences.empty();
+}
+
+template <class Policy, snm::Fusion Kind, snm::Byte... Codes>
+void Processor::ThreadedFused(Processor& processor) {
+    constexpr size_t length = sizeof...(Codes);
+    constexpr std::array<snm::Byte, length> codes{Codes...};
+
+    const snm::Address start = processor.registers_.instruction_pointer;
+
+    // Цикл исполнения проверяет бюджет и точки останова перед каждой инструкцией
+    if (processor.instruction_limit_ - processor.instruction_count_ < length
+        || processor.HasBreakpointInside(start, length)) {
+        Policy::FusionFallback(processor, Kind);
+        ThreadedInstruction<codes[0], Policy>(processor);
+        return;
+    }
+
+    // Остановка из другого потока учитывается после операции, как если бы она была запрошена позже
+    uint64_t executed = 0;
+    const auto execute = [&]<snm::Byte Code>() {
+        if (processor.registers_.instruction_pointer != static_cast<snm::Address>(start + executed)) {
+            return false;
+        }
+        ThreadedInstruction<Code, Policy>(processor);
+        ++executed;
+        return true;
+    };
+    (execute.template operator()<Codes>() && ...);
+
+    Policy::FusionExecuted(processor, Kind, executed);
+}
+
+bool Processor::HasBreakpointInside(const snm::Address address, const size_t length) const {
+    if (!breakpoints_enabled_) {
+        return false;
+    }
+
+    for (size_t offset = 1; offset < length; ++offset) {
+        if (breakpoints_.test(static_cast<snm::Address>(address + offset))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Processor::ThreadedEnd(Processor& processor) {
+    processor.SetState(snm::ProcessorState::STOPPED);
+}
+
+template <snm::ArgModifier Modifier, class Policy>
+void Processor::FetchOperand() {
+    const snm::Bytes argument = memory_.ReadArgument(registers_.instruction_pointer);
+
+    if constexpr (Modifier == snm::ArgModifier::REF) {
+        registers_.auxiliary = memory_.ReadArgument(static_cast<snm::Word>(argument));
+    } else if constexpr (Modifier == snm::ArgModifier::REF_REF) {
+        registers_.auxiliary =
+            memory_.ReadArgument(static_cast<snm::Word>(memory_.ReadArgument(static_cast<snm::Word>(argument))));
+    } else {
+        registers_.auxiliary = argument;
+    }
+
+    Policy::AuxiliaryChanged(*this);
+}
+
+template <class Policy>
+void Processor::JumpTo(const snm::Address address) {
+    registers_.instruction_pointer = address;
+    Policy::InstructionPointerChanged(*this);
+}
+
+template <snm::Byte Code, class Policy>
+void Processor::ThreadedInstruction(Processor& processor) {
+    constexpr auto opcode = static_cast<snm::OpCode>(Code >> 4);
+    constexpr auto type_modifier = static_cast<snm::TypeModifier>(Code >> 2 & 0b11);
+    // Модификатор 0b11 не используется и, как в эталонном интерпретаторе, трактуется как значение
+    constexpr auto arg_modifier = (Code & 0b11) == 0b11
+                                      ? snm::ArgModifier::NONE
+                                      : static_cast<snm::ArgModifier>(Code & 0b11);
+    using T = TypeOf<type_modifier>;
+
+    Registers& registers = processor.registers_;
+    Policy::InstructionStarting(processor);
+    ++processor.instruction_count_;
+    Policy::InstructionExecuted(processor, Code);
+
+    if constexpr (Code == std::numeric_limits<snm::Byte>::max()) {
+        processor.Halt();
+    } else if constexpr (!snm::IsInstructionDefined(opcode, type_modifier)) {
+        processor.FetchOperand<arg_modifier, Policy>();
+        processor.SetState(snm::ProcessorState::STOPPED);
+        throw std::runtime_error(std::format("Error while executing: instruction {} at {} undefined",
+                                             std::bitset<8>(Code & 0b11111100).to_string(),
+                                             registers.instruction_pointer));
+    } else {
+        processor.FetchOperand<arg_modifier, Policy>();
+
+        const snm::Address next = registers.instruction_pointer + 1;
+        const auto acc = static_cast<T>(registers.accumulator);
+        const auto aux = static_cast<T>(registers.auxiliary);
+
+        if constexpr (opcode == snm::OpCode::NOPE) {
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::ADD) {
+            registers.accumulator = static_cast<T>(acc + aux);
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::SUB) {
+            registers.accumulator = static_cast<T>(acc - aux);
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::MUL) {
+            registers.accumulator = static_cast<T>(acc * aux);
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::DIV) {
+            if (aux == static_cast<T>(0)) {
+                throw std::runtime_error("Error: Division by zero");
+            }
+            registers.accumulator = static_cast<T>(acc / aux);
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::MOD) {
+            if (aux == static_cast<T>(0)) {
+                throw std::runtime_error("Error: Modulo by zero");
+            }
+            if constexpr (std::is_same_v<T, snm::Real>) {
+                registers.accumulator = ::fmodf(acc, aux);
+            } else {
+                registers.accumulator = static_cast<T>(acc % aux);
+            }
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::LOAD) {
+            registers.accumulator = aux;
+            Policy::AccumulatorChanged(processor);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::STORE) {
+            const auto address = static_cast<snm::Word>(registers.auxiliary);
+            if (address >= snm::CODE_MEMORY_SIZE) {
+                throw std::out_of_range(std::format("IP {}: Address {} exceeds available memory.",
+                                                    std::to_string(registers.instruction_pointer),
+                                                    std::to_string(address)));
+            }
+            Policy::MemoryWriting(processor, address);
+            processor.memory_.WriteArgument(registers.accumulator, address);
+            Policy::MemoryChanged(processor, address);
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::INPUT) {
+            if (processor.io_) {
+                processor.RequestInput(TypeIo<T>());
+            }
+        } else if constexpr (opcode == snm::OpCode::OUTPUT) {
+            if (processor.io_) {
+                processor.io_->OutputRequest(registers.accumulator, TypeIo<T>());
+            }
+            processor.JumpTo<Policy>(next);
+        } else if constexpr (opcode == snm::OpCode::JUMP) {
+            processor.JumpTo<Policy>(static_cast<snm::Word>(registers.auxiliary));
+        } else if constexpr (opcode == snm::OpCode::SKIP_LOWER) {
+            const bool taken = acc < aux;
+            Policy::BranchExecuted(processor, taken);
+            processor.JumpTo<Policy>(taken ? next + 1 : next);
+        } else if constexpr (opcode == snm::OpCode::SKIP_GREATER) {
+            const bool taken = acc > aux;
+            Policy::BranchExecuted(processor, taken);
+            processor.JumpTo<Policy>(taken ? next + 1 : next);
+        } else if constexpr (opcode == snm::OpCode::SKIP_EQUAL) {
+            const bool taken = acc == aux;
+            Policy::BranchExecuted(processor, taken);
+            processor.JumpTo<Policy>(taken ? next + 1 : next);
+        } else if constexpr (opcode == snm::OpCode::JUMPNSTORE) {
+            const auto address = static_cast<snm::Word>(registers.auxiliary);
+            Policy::MemoryWriting(processor, address);
+            processor.memory_.WriteArgument(snm::Bytes(registers.instruction_pointer + 1), address);
+            Policy::MemoryChanged(processor, address);
+            processor.JumpTo<Policy>(address + 1);
+        }
+    }
 }
@@ -0,0 +1,12 @@
+#include "core/processor_task.hpp"
+
+ProcessorTask RunSliced(Processor& processor, const uint64_t slice) {
+    while (true) {
+        const snm::StopReason reason = processor.RunFor(slice);
+        co_yield reason;
+
+        if (reason == snm::StopReason::HALTED || reason == snm::StopReason::EXECUTION_ERROR) {
+            co_return;
+        }
+    }
+}
@@ -0,0 +1,228 @@
+#include "core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <string>
+
+namespace {
+    constexpr std::array<std::string_view, 4> TYPE_MODIFIER_NAMES = {"C", "W", "SW", "R"};
+    constexpr std::array BRANCH_OPCODES = {snm::OpCode::SKIP_LOWER, snm::OpCode::SKIP_GREATER, snm::OpCode::SKIP_EQUAL};
+    constexpr std::array<std::string_view, 4> FUSION_NAMES = {"increment", "loop_test", "call", "return"};
+
+    snm::OpCode OpCodeOf(const snm::Byte code) {
+        return static_cast<snm::OpCode>(code >> 4);
+    }
+
+    std::string_view OpCodeName(const snm::OpCode opcode) {
+        return snm::OPCODE_PROPERTIES.at(opcode).name;
+    }
+
+    /**
+     * @brief Возвращает обозначение модификатора типа инструкции. У HALT модификатора нет.
+     */
+    std::string_view TypeModifierName(const snm::Byte code) {
+        return OpCodeOf(code) == snm::OpCode::HALT ? std::string_view() : TYPE_MODIFIER_NAMES[code >> 2 & 0b11];
+    }
+
+    bool IsBranch(const snm::Byte code) {
+        return std::ranges::find(BRANCH_OPCODES, OpCodeOf(code)) != BRANCH_OPCODES.end();
+    }
+
+    snm::BytecodeToSourceMap InvertSourceMap(const snm::SourceToBytecodeMap& source_map) {
+        snm::BytecodeToSourceMap result;
+        for (const auto& [line, address] : source_map) {
+            result.emplace(address, line);
+        }
+        return result;
+    }
+}
+
+Profiler::Profiler() :
+    addresses_(snm::CODE_MEMORY_SIZE) {
+}
+
+void Profiler::Reset() {
+    std::ranges::fill(addresses_, AddressProfile{});
+    fusions_.fill({});
+}
+
+template <class F>
+void Profiler::ForEachExecuted(F&& function) const {
+    for (size_t address = 0; address < addresses_.size(); ++address) {
+        if (addresses_[address].count > 0) {
+            function(static_cast<snm::Address>(address), addresses_[address]);
+        }
+    }
+}
+
+uint64_t Profiler::GetInstructionCount() const {
+    uint64_t count = 0;
+    ForEachExecuted([&count](snm::Address, const AddressProfile& profile) {
+        count += profile.count;
+    });
+    return count;
+}
+
+uint64_t Profiler::GetAddressCount(const snm::Address address) const {
+    return addresses_[address].count;
+}
+
+BranchCounts Profiler::GetBranchCounts(const snm::Address address) const {
+    return addresses_[address].branches;
+}
+
+uint64_t Profiler::GetOpCodeCount(const snm::OpCode opcode) const {
+    uint64_t count = 0;
+    ForEachExecuted([&](snm::Address, const AddressProfile& profile) {
+        if (OpCodeOf(profile.code) == opcode) {
+            count += profile.count;
+        }
+    });
+    return count;
+}
+
+uint64_t Profiler::GetTypeModifierCount(const snm::TypeModifier type_modifier) const {
+    uint64_t count = 0;
+    ForEachExecuted([&](snm::Address, const AddressProfile& profile) {
+        if (OpCodeOf(profile.code) != snm::OpCode::HALT
+            && static_cast<snm::TypeModifier>(profile.code >> 2 & 0b11) == type_modifier) {
+            count += profile.count;
+        }
+    });
+    return count;
+}
+
+BranchCounts Profiler::GetBranchCounts(const snm::OpCode opcode) const {
+    BranchCounts counts;
+    ForEachExecuted([&](snm::Address, const AddressProfile& profile) {
+        if (OpCodeOf(profile.code) == opcode) {
+            counts.taken += profile.branches.taken;
+            counts.not_taken += profile.branches.not_taken;
+        }
+    });
+    return counts;
+}
+
+FusionCounts Profiler::GetFusionCounts(const snm::Fusion fusion) const {
+    return fusions_[static_cast<size_t>(fusion)];
+}
+
+std::map<unsigned int, uint64_t> Profiler::GetLineCounts(const snm::SourceToBytecodeMap& source_map) const {
+    std::map<unsigned int, uint64_t> result;
+    for (const auto& [line, address] : source_map) {
+        if (const uint64_t count = addresses_[address].count; count > 0) {
+            result[line] += count;
+        }
+    }
+    return result;
+}
+
+void Profiler::WriteCsv(std::ostream& stream, const snm::SourceToBytecodeMap& source_map) const {
+    const snm::BytecodeToSourceMap lines = InvertSourceMap(source_map);
+
+    stream << "address,line,opcode,type,count,taken,not_taken\n";
+    ForEachExecuted([&](const snm::Address address, const AddressProfile& profile) {
+        const auto line = lines.find(address);
+        stream << std::format("{},{},{},{},{},", address, line != lines.end() ? std::to_string(line->second) : "",
+                              OpCodeName(OpCodeOf(profile.code)), TypeModifierName(profile.code), profile.count);
+        if (IsBranch(profile.code)) {
+            stream << std::format("{},{}", profile.branches.taken, profile.branches.not_taken);
+        } else {
+            stream << ',';
+        }
+        stream << '\n';
+    });
+}
+
+void Profiler::WriteJson(std::ostream& stream, const snm::SourceToBytecodeMap& source_map) const {
+    const snm::BytecodeToSourceMap lines = InvertSourceMap(source_map);
+
+    const uint64_t instruction_count = GetInstructionCount();
+
+    stream << std::format("{{\n  \"instructions\": {},\n  \"opcodes\": {{", instruction_count);
+    for (int i = 0; i <= static_cast<int>(snm::OpCode::HALT); ++i) {
+        const auto opcode = static_cast<snm::OpCode>(i);
+        stream << std::format("{}\"{}\": {}", i == 0 ? "" : ", ", OpCodeName(opcode), GetOpCodeCount(opcode));
+    }
+
+    stream << "},\n  \"type_modifiers\": {";
+    for (size_t i = 0; i < TYPE_MODIFIER_NAMES.size(); ++i) {
+        stream << std::format("{}\"{}\": {}", i == 0 ? "" : ", ", TYPE_MODIFIER_NAMES[i],
+                              GetTypeModifierCount(static_cast<snm::TypeModifier>(i)));
+    }
+
+    stream << "},\n  \"branches\": {";
+    for (size_t i = 0; i < BRANCH_OPCODES.size(); ++i) {
+        const auto [taken, not_taken] = GetBranchCounts(BRANCH_OPCODES[i]);
+        stream << std::format("{}\"{}\": {{\"taken\": {}, \"not_taken\": {}}}", i == 0 ? "" : ", ",
+                              OpCodeName(BRANCH_OPCODES[i]), taken, not_taken);
+    }
+
+    // share: доля инструкций программы, исполненных в составе слитой операции
+    stream << "},\n  \"fusions\": {";
+    for (size_t i = 0; i < FUSION_NAMES.size(); ++i) {
+        const auto [hits, fallbacks, instructions] = fusions_[i];
+        stream << std::format("{}\"{}\": {{\"hits\": {}, \"fallbacks\": {}, \"instructions\": {}, \"share\": {:.4f}}}",
+                              i == 0 ? "" : ", ", FUSION_NAMES[i], hits, fallbacks, instructions,
+                              instruction_count ? static_cast<double>(instructions) / instruction_count : 0.0);
+    }
+
+    stream << "},\n  \"addresses\": [";
+    bool first = true;
+    ForEachExecuted([&](const snm::Address address, const AddressProfile& profile) {
+        stream << std::format("{}\n    {{\"address\": {}", first ? "" : ",", address);
+        if (const auto line = lines.find(address); line != lines.end()) {
+            stream << std::format(", \"line\": {}", line->second);
+        }
+        stream << std::format(", \"opcode\": \"{}\", \"count\": {}", OpCodeName(OpCodeOf(profile.code)),
+                              profile.count);
+        if (IsBranch(profile.code)) {
+            stream << std::format(", \"taken\": {}, \"not_taken\": {}", profile.branches.taken,
+                                  profile.branches.not_taken);
+        }
+        stream << '}';
+        first = false;
+    });
+
+    stream << "\n  ],\n  \"lines\": [";
+    first = true;
+    for (const auto& [line, count] : GetLineCounts(source_map)) {
+        stream << std::format("{}\n    {{\"line\": {}, \"count\": {}}}", first ? "" : ",", line, count);
+        first = false;
+    }
+    stream << "\n  ]\n}\n";
+}
+
+void Profiler::WriteCollapsedStacks(std::ostream& stream, const snm::SourceToBytecodeMap& source_map,
+                                    const snm::LabelMap& labels) const {
+    const snm::BytecodeToSourceMap lines = InvertSourceMap(source_map);
+
+    // Метки по адресам. При нескольких метках на одном адресе используется первая по имени.
+    std::map<snm::Address, std::string_view> label_addresses;
+    for (const auto& [name, address] : labels) {
+        if (const auto it = label_addresses.find(address); it == label_addresses.end() || name < it->second) {
+            label_addresses[address] = name;
+        }
+    }
+
+    std::map<std::string, uint64_t> stacks;
+    ForEachExecuted([&](const snm::Address address, const AddressProfile& profile) {
+        std::string stack;
+        if (auto label = label_addresses.upper_bound(address); label != label_addresses.begin()) {
+            stack = std::format("{};", (--label)->second);
+        }
+
+        if (const auto line = lines.find(address); line != lines.end()) {
+            stack += std::format("line {}", line->second);
+        } else {
+            stack += std::format("0x{:04X}", address);
+        }
+
+        stacks[stack] += profile.count;
+    });
+
+    for (const auto& [stack, count] : stacks) {
+        stream << std::format("{} {}\n", stack, count);
+    }
+}
@@ -0,0 +1,236 @@
+#include "core/program_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "binary_format.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SNM_PROGRAM_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using snm::binary::AppendLittleEndian;
+    using snm::binary::InvalidFile;
+    using snm::binary::ReadLittleEndian;
+
+    constexpr std::array<snm::Byte, 4> MAGIC = {'S', 'N', 'M', 'B'};
+    constexpr size_t HEADER_SIZE = 20;
+    constexpr size_t INSTRUCTION_SIZE = snm::ARGUMENT_SIZE + 1;
+    constexpr size_t LABEL_HEADER_SIZE = 4;
+    constexpr size_t SOURCE_MAP_ENTRY_SIZE = 6;
+    constexpr std::string_view FILE_KIND = "program";
+}
+
+/**
+ * @brief Содержимое файла, отображённое в память только для чтения.
+ *
+ * На платформах без mmap файл читается в буфер целиком.
+ */
+class ProgramFile::Mapping {
+public:
+    explicit Mapping(const std::string& path) {
+#ifdef SNM_PROGRAM_FILE_MMAP
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error(std::format("Cannot open file {}", path));
+        }
+
+        struct stat status{};
+        if (fstat(descriptor, &status) != 0) {
+            close(descriptor);
+            throw std::runtime_error(std::format("Cannot open file {}", path));
+        }
+
+        size_ = static_cast<size_t>(status.st_size);
+        if (size_ > 0) {
+            address_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        }
+        close(descriptor);
+
+        if (address_ == MAP_FAILED) {
+            address_ = nullptr;
+            throw std::runtime_error(std::format("Cannot map file {}", path));
+        }
+#else
+        buffer_ = snm::binary::ReadFile(path);
+#endif
+    }
+
+    ~Mapping() {
+#ifdef SNM_PROGRAM_FILE_MMAP
+        if (address_) {
+            munmap(address_, size_);
+        }
+#endif
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    [[nodiscard]] std::span<const snm::Byte> Data() const {
+#ifdef SNM_PROGRAM_FILE_MMAP
+        if (!address_) {
+            return {};
+        }
+        return {static_cast<const snm::Byte*>(address_), size_};
+#else
+        return buffer_;
+#endif
+    }
+
+private:
+#ifdef SNM_PROGRAM_FILE_MMAP
+    void* address_ = nullptr; ///< Начало отображения
+    size_t size_ = 0; ///< Размер файла
+#else
+    std::vector<snm::Byte> buffer_; ///< Содержимое файла
+#endif
+};
+
+ProgramFile::ProgramFile(const std::string& path) :
+    mapping_(std::make_unique<Mapping>(path)) {
+    Parse(mapping_->Data());
+}
+
+ProgramFile::~ProgramFile() = default;
+
+ProgramFile::ProgramFile(ProgramFile&&) noexcept = default;
+
+ProgramFile& ProgramFile::operator=(ProgramFile&&) noexcept = default;
+
+void ProgramFile::Parse(const std::span<const snm::Byte> data) {
+    if (data.size() < HEADER_SIZE || !std::ranges::equal(data.first(MAGIC.size()), MAGIC)) {
+        throw InvalidFile(FILE_KIND, "signature not found");
+    }
+
+    if (const auto version = ReadLittleEndian<uint16_t>(data, 4); version != VERSION) {
+        throw InvalidFile(FILE_KIND, std::format("unsupported version {}", version));
+    }
+
+    const auto instruction_count = ReadLittleEndian<uint32_t>(data, 8);
+    label_count_ = ReadLittleEndian<uint32_t>(data, 12);
+    source_map_size_ = ReadLittleEndian<uint32_t>(data, 16);
+
+    if (instruction_count > snm::CODE_MEMORY_SIZE) {
+        throw InvalidFile(FILE_KIND, "too many instructions");
+    }
+
+    size_t offset = HEADER_SIZE;
+    const size_t byte_code_size = instruction_count * INSTRUCTION_SIZE;
+    if (data.size() - offset < byte_code_size) {
+        throw InvalidFile(FILE_KIND, "bytecode is truncated");
+    }
+    byte_code_ = data.subspan(offset, byte_code_size);
+    offset += byte_code_size;
+
+    const size_t labels_offset = offset;
+    for (uint32_t i = 0; i < label_count_; ++i) {
+        if (data.size() - offset < LABEL_HEADER_SIZE) {
+            throw InvalidFile(FILE_KIND, "label table is truncated");
+        }
+
+        const auto name_size = ReadLittleEndian<uint16_t>(data, offset + 2);
+        offset += LABEL_HEADER_SIZE;
+        if (data.size() - offset < name_size) {
+            throw InvalidFile(FILE_KIND, "label table is truncated");
+        }
+        offset += name_size;
+    }
+    labels_ = data.subspan(labels_offset, offset - labels_offset);
+
+    if (data.size() - offset != static_cast<size_t>(source_map_size_) * SOURCE_MAP_ENTRY_SIZE) {
+        throw InvalidFile(FILE_KIND, "source map size does not match file size");
+    }
+    source_map_ = data.subspan(offset);
+}
+
+std::span<const snm::Byte> ProgramFile::GetByteCode() const {
+    return byte_code_;
+}
+
+snm::LabelMap ProgramFile::GetLabels() const {
+    snm::LabelMap labels;
+    labels.reserve(label_count_);
+
+    for (size_t offset = 0; offset < labels_.size();) {
+        const auto address = ReadLittleEndian<snm::Address>(labels_, offset);
+        const auto name_size = ReadLittleEndian<uint16_t>(labels_, offset + 2);
+        offset += LABEL_HEADER_SIZE;
+
+        const auto name = labels_.subspan(offset, name_size);
+        labels.emplace(std::string(name.begin(), name.end()), address);
+        offset += name_size;
+    }
+
+    return labels;
+}
+
+snm::SourceToBytecodeMap ProgramFile::GetSourceMap() const {
+    snm::SourceToBytecodeMap source_map;
+    source_map.reserve(source_map_size_);
+
+    for (size_t offset = 0; offset < source_map_.size(); offset += SOURCE_MAP_ENTRY_SIZE) {
+        source_map.emplace(ReadLittleEndian<uint32_t>(source_map_, offset),
+                           ReadLittleEndian<snm::Address>(source_map_, offset + 4));
+    }
+
+    return source_map;
+}
+
+snm::ByteCode ProgramFile::Serialize(const Program& program) {
+    if (program.byte_code.size() % INSTRUCTION_SIZE != 0) {
+        throw std::invalid_argument("Invalid bytecode format. Unable to parse.");
+    }
+
+    const size_t instruction_count = program.byte_code.size() / INSTRUCTION_SIZE;
+    if (instruction_count > snm::CODE_MEMORY_SIZE) {
+        throw std::invalid_argument("Command size exceeds available memory.");
+    }
+
+    std::vector<std::pair<std::string_view, snm::Address>> labels(program.labels.begin(), program.labels.end());
+    std::ranges::sort(labels);
+
+    std::vector<std::pair<unsigned int, snm::Address>> source_map(program.source_map.begin(),
+                                                                  program.source_map.end());
+    std::ranges::sort(source_map);
+
+    snm::ByteCode data(MAGIC.begin(), MAGIC.end());
+    data.reserve(HEADER_SIZE + program.byte_code.size() + source_map.size() * SOURCE_MAP_ENTRY_SIZE);
+
+    AppendLittleEndian<uint16_t>(data, VERSION);
+    AppendLittleEndian<uint16_t>(data, 0);
+    AppendLittleEndian(data, static_cast<uint32_t>(instruction_count));
+    AppendLittleEndian(data, static_cast<uint32_t>(labels.size()));
+    AppendLittleEndian(data, static_cast<uint32_t>(source_map.size()));
+
+    data.insert(data.end(), program.byte_code.begin(), program.byte_code.end());
+
+    for (const auto& [name, address] : labels) {
+        if (name.size() > std::numeric_limits<uint16_t>::max()) {
+            throw std::invalid_argument(std::format("Label name is too long: {}", name));
+        }
+
+        AppendLittleEndian(data, address);
+        AppendLittleEndian(data, static_cast<uint16_t>(name.size()));
+        data.insert(data.end(), name.begin(), name.end());
+    }
+
+    for (const auto& [line, address] : source_map) {
+        AppendLittleEndian(data, static_cast<uint32_t>(line));
+        AppendLittleEndian(data, address);
+    }
+
+    return data;
+}
+
+void ProgramFile::Write(const std::string& path, const Program& program) {
+    snm::binary::WriteFile(path, Serialize(program));
+}
@@ -0,0 +1,45 @@
+#include "core/program_image.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+ProgramImage::ProgramImage(const std::span<const snm::Byte> byte_code) {
+    if (byte_code.size() > std::numeric_limits<snm::Address>::max()) {
+        throw std::invalid_argument("Command size exceeds available memory. Cannot load instructions.");
+    }
+
+    if (byte_code.size() % 5 != 0) {
+        throw std::invalid_argument("Invalid bytecode format. Unable to parse.");
+    }
+
+    size_ = byte_code.size() / 5;
+    pages_.resize((size_ + PAGE_SIZE - 1) / PAGE_SIZE);
+
+    for (size_t address = 0; address < size_; ++address) {
+        MemoryCell& cell = pages_[address / PAGE_SIZE][address % PAGE_SIZE];
+        cell.opcode = byte_code[address * 5];
+
+        for (size_t j = 0; j < 4; ++j) {
+            cell.argument[j] = byte_code[address * 5 + 1 + j];
+        }
+    }
+}
+
+void ProgramImage::WriteInstruction(const snm::Byte code, const snm::Bytes argument, const snm::Address address) {
+    if (address >= size_) {
+        pages_.resize(address / PAGE_SIZE + 1);
+
+        // Ячейки между концом программы и новой инструкцией становятся пустыми инструкциями
+        for (; size_ < address; ++size_) {
+            pages_[size_ / PAGE_SIZE][size_ % PAGE_SIZE].opcode = static_cast<snm::Byte>(snm::OpCode::NOPE);
+        }
+        size_ = address + 1;
+    }
+
+    pages_[address / PAGE_SIZE][address % PAGE_SIZE] = {code, argument};
+}
+
+const ProgramImage::Page& ProgramImage::EmptyPage() {
+    static const Page page{};
+    return page;
+}
@@ -0,0 +1,32 @@
+#include "core/recording_io.hpp"
+
+RecordingIo::RecordingIo(ProcessorIo& io, InstructionCounter instruction_counter) :
+    io_(io),
+    instruction_counter_(std::move(instruction_counter)) {
+}
+
+void RecordingIo::InputRequest(const snm::Type type, const InputCallback callback) {
+    const uint64_t instruction_count = GetInstructionCount();
+
+    io_.InputRequest(type, [this, type, instruction_count, callback](const snm::Bytes bytes) {
+        events_.push_back({IoEvent::Kind::INPUT, type, bytes, instruction_count});
+        callback(bytes);
+    });
+}
+
+void RecordingIo::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
+    events_.push_back({IoEvent::Kind::OUTPUT, type, bytes, GetInstructionCount()});
+    io_.OutputRequest(bytes, type);
+}
+
+const std::vector<IoEvent>& RecordingIo::GetEvents() const {
+    return events_;
+}
+
+void RecordingIo::Clear() {
+    events_.clear();
+}
+
+uint64_t RecordingIo::GetInstructionCount() const {
+    return instruction_counter_ ? instruction_counter_() : 0;
+}
@@ -0,0 +1,97 @@
+#include "core/replay_io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr std::array<std::string_view, 4> TYPE_NAMES = {"byte", "word", "signed word", "real"};
+
+    std::string Describe(const IoEvent& event) {
+        std::string value;
+        switch (event.type) {
+        case snm::Type::BYTE:
+            value = std::to_string(static_cast<snm::Byte>(event.bytes));
+            break;
+        case snm::Type::WORD:
+            value = std::to_string(static_cast<snm::Word>(event.bytes));
+            break;
+        case snm::Type::SIGNED_WORD:
+            value = std::to_string(static_cast<snm::SignedWord>(event.bytes));
+            break;
+        case snm::Type::REAL:
+            value = std::format("{}", static_cast<snm::Real>(event.bytes));
+            break;
+        }
+
+        if (event.kind == IoEvent::Kind::INPUT) {
+            return std::format("input of {} at instruction {}", TYPE_NAMES[event.type], event.instruction_count);
+        }
+        return std::format("output of {} {} at instruction {}", TYPE_NAMES[event.type], value,
+                           event.instruction_count);
+    }
+}
+
+ReplayIo::ReplayIo(std::vector<IoEvent> events, ProcessorIo& io, InstructionCounter instruction_counter) :
+    events_(std::move(events)),
+    io_(io),
+    instruction_counter_(std::move(instruction_counter)) {
+}
+
+void ReplayIo::InputRequest(const snm::Type type, const InputCallback callback) {
+    const IoEvent& event = Expect({IoEvent::Kind::INPUT, type, snm::Bytes{}, 0});
+    callback(event.bytes);
+}
+
+void ReplayIo::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
+    Expect({IoEvent::Kind::OUTPUT, type, bytes, 0});
+    io_.OutputRequest(bytes, type);
+}
+
+void ReplayIo::Rewind() {
+    next_ = 0;
+}
+
+size_t ReplayIo::GetRemaining() const {
+    return events_.size() - next_;
+}
+
+void ReplayIo::Finish() const {
+    if (next_ != events_.size()) {
+        throw std::runtime_error(std::format("Error: Replay mismatch at event {}: expected {}, program stopped",
+                                             next_, Describe(events_[next_])));
+    }
+}
+
+const IoEvent& ReplayIo::Expect(const IoEvent& actual) {
+    IoEvent request = actual;
+
+    // Без источника счётчика сверяются только значения, поэтому счётчик запроса берётся из записи
+    if (instruction_counter_) {
+        request.instruction_count = instruction_counter_();
+    } else if (next_ != events_.size()) {
+        request.instruction_count = events_[next_].instruction_count;
+    }
+
+    if (next_ == events_.size()) {
+        throw std::runtime_error(std::format("Error: Replay mismatch at event {}: recording ended, got {}",
+                                             next_, Describe(request)));
+    }
+
+    // Значение ввода задаёт запись, поэтому у запроса ввода сверяются только тип и счётчик
+    const IoEvent& expected = events_[next_];
+    if (request.kind == IoEvent::Kind::INPUT) {
+        request.bytes = expected.bytes;
+    }
+
+    if (expected.kind != request.kind || expected.type != request.type
+        || expected.instruction_count != request.instruction_count
+        || !std::ranges::equal(expected.bytes, request.bytes)) {
+        throw std::runtime_error(std::format("Error: Replay mismatch at event {}: expected {}, got {}",
+                                             next_, Describe(expected), Describe(request)));
+    }
+
+    return events_[next_++];
+}
@@ -0,0 +1,110 @@
+#include "core/snapshot_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "binary_format.hpp"
+
+namespace {
+    using snm::binary::AppendBytes;
+    using snm::binary::AppendLittleEndian;
+    using snm::binary::InvalidFile;
+    using snm::binary::ReadBytes;
+    using snm::binary::ReadLittleEndian;
+
+    constexpr std::array<snm::Byte, 4> MAGIC = {'S', 'N', 'M', 'S'};
+    constexpr size_t HEADER_SIZE = 36;
+    constexpr size_t INSTRUCTION_SIZE = snm::ARGUMENT_SIZE + 1;
+    constexpr size_t CELL_ENTRY_SIZE = snm::ARGUMENT_SIZE + 2;
+    constexpr std::string_view FILE_KIND = "snapshot";
+}
+
+snm::ByteCode SnapshotFile::Serialize(const ProcessorSnapshot& snapshot) {
+    const ProgramImage& image = *snapshot.memory.GetImage();
+    const std::vector<snm::Address> cells = snapshot.memory.GetWrittenCells();
+
+    snm::ByteCode data(MAGIC.begin(), MAGIC.end());
+    data.reserve(HEADER_SIZE + image.Size() * INSTRUCTION_SIZE + cells.size() * CELL_ENTRY_SIZE);
+
+    AppendLittleEndian<uint16_t>(data, VERSION);
+    AppendLittleEndian(data, static_cast<uint8_t>(snapshot.state));
+    AppendLittleEndian<uint8_t>(data, 0);
+    AppendLittleEndian(data, snapshot.instruction_count);
+    AppendBytes(data, snapshot.registers.accumulator);
+    AppendBytes(data, snapshot.registers.auxiliary);
+    AppendLittleEndian(data, snapshot.registers.instruction_pointer);
+    AppendLittleEndian<uint16_t>(data, 0);
+    AppendLittleEndian(data, static_cast<uint32_t>(image.Size()));
+    AppendLittleEndian(data, static_cast<uint32_t>(cells.size()));
+
+    for (size_t address = 0; address < image.Size(); ++address) {
+        const MemoryCell& cell = image.GetCell(static_cast<snm::Address>(address));
+        data.push_back(cell.opcode);
+        AppendBytes(data, cell.argument);
+    }
+
+    for (const snm::Address address : cells) {
+        AppendLittleEndian(data, address);
+        AppendBytes(data, snapshot.memory.ReadArgument(address));
+    }
+
+    return data;
+}
+
+std::shared_ptr<const ProcessorSnapshot> SnapshotFile::Deserialize(const std::span<const snm::Byte> data) {
+    if (data.size() < HEADER_SIZE || !std::ranges::equal(data.first(MAGIC.size()), MAGIC)) {
+        throw InvalidFile(FILE_KIND, "signature not found");
+    }
+
+    if (const auto version = ReadLittleEndian<uint16_t>(data, 4); version != VERSION) {
+        throw InvalidFile(FILE_KIND, std::format("unsupported version {}", version));
+    }
+
+    const auto state = ReadLittleEndian<uint8_t>(data, 6);
+    if (state > snm::ProcessorState::BREAKPOINT) {
+        throw InvalidFile(FILE_KIND, std::format("unknown processor state {}", state));
+    }
+
+    const auto image_size = ReadLittleEndian<uint32_t>(data, 28);
+    const auto cell_count = ReadLittleEndian<uint32_t>(data, 32);
+    if (image_size > snm::CODE_MEMORY_SIZE || cell_count > snm::CODE_MEMORY_SIZE) {
+        throw InvalidFile(FILE_KIND, "too many cells");
+    }
+
+    if (data.size() - HEADER_SIZE != image_size * INSTRUCTION_SIZE + cell_count * CELL_ENTRY_SIZE) {
+        throw InvalidFile(FILE_KIND, "cell table size does not match file size");
+    }
+
+    // Образ строится по инструкциям, поэтому размер программы не ограничен размером байт-кода MemoryManager::Load
+    auto image = std::make_shared<ProgramImage>();
+    size_t offset = HEADER_SIZE;
+    for (uint32_t address = 0; address < image_size; ++address, offset += INSTRUCTION_SIZE) {
+        image->WriteInstruction(data[offset], ReadBytes(data, offset + 1), static_cast<snm::Address>(address));
+    }
+
+    MemoryManager memory;
+    memory.Load(std::shared_ptr<const ProgramImage>(std::move(image)));
+    for (uint32_t i = 0; i < cell_count; ++i, offset += CELL_ENTRY_SIZE) {
+        memory.WriteArgument(ReadBytes(data, offset + 2), ReadLittleEndian<snm::Address>(data, offset));
+    }
+
+    const Registers registers{
+        .accumulator = ReadBytes(data, 16),
+        .auxiliary = ReadBytes(data, 20),
+        .instruction_pointer = ReadLittleEndian<snm::Address>(data, 24)
+    };
+
+    return std::make_shared<const ProcessorSnapshot>(ProcessorSnapshot{
+        registers, static_cast<snm::ProcessorState>(state), ReadLittleEndian<uint64_t>(data, 8), memory.TakeSnapshot()
+    });
+}
+
+void SnapshotFile::Write(const std::string& path, const ProcessorSnapshot& snapshot) {
+    snm::binary::WriteFile(path, Serialize(snapshot));
+}
+
+std::shared_ptr<const ProcessorSnapshot> SnapshotFile::Read(const std::string& path) {
+    return Deserialize(snm::binary::ReadFile(path));
+}
@@ -0,0 +1,49 @@
+#include "core/stream_io.hpp"
+
+#include "core/virtual_machine.hpp"
+
+StreamIo::StreamIo(std::istream& input, std::ostream& output, const size_t buffer_size) :
+    input_(input),
+    output_(output),
+    buffer_size_(buffer_size) {
+    buffer_.reserve(buffer_size_);
+}
+
+StreamIo::~StreamIo() {
+    Flush();
+}
+
+void StreamIo::InputRequest(const snm::Type type, const InputCallback callback) {
+    Flush();
+
+    std::string token;
+    if (!(input_ >> token)) {
+        throw std::runtime_error("Error: Unexpected end of input");
+    }
+
+    snm::Bytes bytes;
+    try {
+        bytes = VirtualMachine::BytesFromString(token, type);
+    } catch ([[maybe_unused]] const std::logic_error& e) {
+        throw std::runtime_error(std::format("Error: Invalid input value {}", token));
+    }
+
+    callback(bytes);
+}
+
+void StreamIo::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
+    buffer_ += VirtualMachine::BytesToString(bytes, type);
+
+    if (buffer_.size() >= buffer_size_) {
+        Flush();
+    }
+}
+
+void StreamIo::Flush() {
+    if (!buffer_.empty()) {
+        output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+
+    output_.flush();
+}
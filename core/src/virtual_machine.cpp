@@ -10,6 +10,10 @@ void VirtualMachine::Load(const snm::ByteCode& byte_code) {
     memory_manager_->Load(byte_code);
 }
 
+void VirtualMachine::Load(const std::span<const snm::Byte> byte_code) {
+    memory_manager_->Load(byte_code);
+}
+
 void VirtualMachine::Reset() {
     if (processor_->IsRunning()) {
         processor_->Stop();
@@ -23,6 +27,14 @@ void VirtualMachine::Run() {
     processor_->Run();
 }
 
+snm::StopReason VirtualMachine::RunFor(const uint64_t instruction_budget) {
+    return processor_->RunFor(instruction_budget);
+}
+
+snm::StopReason VirtualMachine::Resume() {
+    return processor_->Resume();
+}
+
 void VirtualMachine::Stop() {
     processor_->Stop();
 }
@@ -31,6 +43,14 @@ void VirtualMachine::Step() {
     processor_->Step();
 }
 
+bool VirtualMachine::StepBack() {
+    return processor_->StepBack();
+}
+
+bool VirtualMachine::ReverseContinue() {
+    return processor_->ReverseContinue();
+}
+
 snm::Bytes VirtualMachine::ReadMemory(const snm::Address& address) {
     return memory_manager_->ReadArgument(address);
 }
@@ -43,7 +63,7 @@ bool VirtualMachine::IsRunning() {
     return processor_->IsRunning();
 }
 
-const snm::ProcessorState& VirtualMachine::GetState() {
+snm::ProcessorState VirtualMachine::GetState() {
     return processor_->GetState();
 }
 
@@ -51,6 +71,22 @@ Registers VirtualMachine::GetRegisters() {
     return processor_->GetRegisters();
 }
 
+uint64_t VirtualMachine::GetInstructionCount() {
+    return processor_->GetInstructionCount();
+}
+
+std::shared_ptr<const ProcessorSnapshot> VirtualMachine::GetSnapshot() {
+    return processor_->GetSnapshot();
+}
+
+std::shared_ptr<const ProcessorSnapshot> VirtualMachine::Snapshot() {
+    return processor_->CaptureSnapshot();
+}
+
+void VirtualMachine::Restore(std::shared_ptr<const ProcessorSnapshot> snapshot) {
+    processor_->Restore(std::move(snapshot));
+}
+
 void VirtualMachine::SetInstructionPointer(const snm::Address value) {
     processor_->SetInstructionPointer(value);
 }
@@ -88,7 +124,8 @@ void VirtualMachine::SetAuxiliary(const snm::Real value) {
 }
 
 void VirtualMachine::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
-    std::cout << BytesToString(bytes, type) << std::endl;
+    // Поток сбрасывается при вводе и завершении программы, а не после каждого значения
+    std::cout << BytesToString(bytes, type) << '\n';
 }
 
 void VirtualMachine::InputRequest(const snm::Type type, const InputCallback callback) {
@@ -105,6 +142,34 @@ void VirtualMachine::SetProcessorIo(ProcessorIo* processor_io) const {
     processor_->SetIo(processor_io);
 }
 
+void VirtualMachine::SetProfiler(Profiler* profiler) const {
+    processor_->SetProfiler(profiler);
+}
+
+void VirtualMachine::SetHistory(ExecutionHistory* history) const {
+    processor_->SetHistory(history);
+}
+
+void VirtualMachine::SetExecutionMode(const snm::ExecutionMode mode) const {
+    processor_->SetExecutionMode(mode);
+}
+
+void VirtualMachine::SetBreakpoint(const snm::Address address) const {
+    processor_->SetBreakpoint(address);
+}
+
+void VirtualMachine::RemoveBreakpoint(const snm::Address address) const {
+    processor_->RemoveBreakpoint(address);
+}
+
+void VirtualMachine::ClearBreakpoints() const {
+    processor_->ClearBreakpoints();
+}
+
+void VirtualMachine::SetBreakpointsEnabled(const bool enabled) const {
+    processor_->SetBreakpointsEnabled(enabled);
+}
+
 std::string VirtualMachine::BytesToString(const snm::Bytes& bytes, const snm::Type& type) {
     switch (type) {
     case snm::Type::BYTE:
@@ -31,6 +31,11 @@ public:
     [[nodiscard]] int LineNumberAreaWidth() const;
     void HighlightLine(unsigned int line_number);
     void ClearHighlightedLines();
+    /**
+     * @brief Задаёт долю исполнений по строкам для подсветки области номеров строк.
+     * @param line_heat Доля исполнений строки от максимальной, от 0 до 1. Строки без значения не подсвечиваются.
+     */
+    void SetLineHeat(QHash<unsigned int, double> line_heat);
     void ScrollToLine(int line_number);
 
 signals:
@@ -63,6 +68,7 @@ private:
     QVector<unsigned int> underlined_lines_;
     QSet<unsigned int> highlighted_lines_;
     QSet<unsigned int> breakpoints_;
+    QHash<unsigned int, double> line_heat_;
     unsigned int hovered_line_;
 
     [[nodiscard]] int LineNumberAtPosition(const QPoint& pos) const;
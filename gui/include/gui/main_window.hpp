@@ -1,12 +1,19 @@
 #ifndef MAIN_WINDOW_HPP
 #define MAIN_WINDOW_HPP
 
+#include <optional>
+
 #include <QMainWindow>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <QLabel>
+#include <QTimer>
 
 #include "core/assembler.hpp"
 #include "core/common_definitions.hpp"
+#include "core/input_feed_io.hpp"
+#include "core/output_buffer.hpp"
+#include "core/recording_io.hpp"
+#include "core/replay_io.hpp"
 #include "core/virtual_machine.hpp"
 #include "gui/code_editor.hpp"
 #include "gui/console.hpp"
@@ -30,21 +37,17 @@ public:
      * @param parent Родительский виджет (по умолчанию nullptr)
      */
     explicit MainWindow(QWidget* parent = nullptr);
+    /**
+     * @brief Останавливает виртуальную машину, так как поток исполнения обращается к окну как к обработчику
+     * ввода-вывода.
+     */
+    ~MainWindow() override;
 
 signals:
     /**
      * @brief Сигнал, испускаемый при применении новой темы
      */
     void ThemeApplied();
-    /**
-     * @brief Сигнал готовности данных для вывода
-     *
-     * Внутренний сигнал для асинхронного вывода
-     *
-     * @param bytes Данные, готовые для вывода, в формате байтов
-     * @param type Тип данных, указывающий способ их интерпретации
-     */
-    void OutputReady(snm::Bytes bytes, snm::Type type);
 
 private slots:
     // === Управление виртуальной машиной ===
@@ -101,6 +104,24 @@ private slots:
      * @brief Обработчик сохранения файла с выбором имени
      */
     void OnSaveAsFile();
+    /**
+     * @brief Обработчик выбора файла входных значений. Значения разбираются сразу и при исполнении вводятся
+     * без обращения к консоли.
+     */
+    void OnOpenInputFile();
+    /**
+     * @brief Обработчик отказа от файла входных значений. Ввод снова запрашивается через консоль.
+     */
+    void OnClearInputFile();
+    /**
+     * @brief Обработчик сохранения записи ввода-вывода последнего запуска в файл .snmr.
+     */
+    void OnSaveIoRecording();
+    /**
+     * @brief Обработчик выбора записи ввода-вывода. При исполнении ввод берётся из записи без обращения
+     * к консоли, а вывод сверяется с ней.
+     */
+    void OnOpenIoRecording();
 
     // === Взаимодействие с пользователем ===
     /**
@@ -123,6 +144,7 @@ private:
     MemoryModel* memory_table_model_;
     MemoryView* memory_table_view_;
     Console* console_;
+    QTimer* output_timer_; ///< Таймер переноса накопленного вывода в консоль во время исполнения
     QToolBar* tool_bar_;
     QStatusBar* status_bar_;
     QMenu* examples_menu_;
@@ -133,16 +155,23 @@ private:
     QAction* action_pause_continue_;
     QAction* action_debug_;
     QAction* action_step_;
+    QAction* action_step_back_;
+    QAction* action_reverse_continue_;
 
     // === Состояние приложения ===
     QString current_file_path_; ///< Путь к текущему открытому файлу
     bool is_bytecode_fresh_; ///< Флаг актуальности байт-кода
+    mutable OutputBuffer output_buffer_; ///< Вывод программы, ещё не перенесённый в консоль
+    mutable std::string output_chunk_; ///< Фрагмент вывода, переносимый в консоль. Переиспользуется между переносами.
+    std::optional<InputFeedIo> input_feed_; ///< Входные значения из файла. Если не заданы, ввод запрашивается через консоль.
+    std::optional<ReplayIo> replay_; ///< Воспроизводимая запись ввода-вывода. Заменяет файл ввода и консоль.
+    std::optional<RecordingIo> recording_; ///< Запись ввода-вывода текущего или последнего запуска
 
     /**
      * @brief Создает панель инструментов основного окна приложения.
      *
      * Метод инициализирует панель инструментов, добавляет на нее действия для управления
-     * выполнением программы, включая запуск, отладку, паузу/продолжение, остановку и шаг.
+     * выполнением программы, включая запуск, отладку, паузу/продолжение, остановку, шаг и возврат назад.
      * Каждое из действий получает соответствующую иконку, горячие клавиши, а также
      * соединяется со слотами или функциями обратного вызова для выполнения связанных операций.
      */
@@ -168,6 +197,14 @@ private:
      * @return true, если байт-код успешно обновлен, иначе false
      */
     bool UpdateByteCode();
+    /**
+     * @brief Подготавливает ввод к запуску программы с начала
+     *
+     * Если выбрана запись ввода-вывода или файл входных значений, возвращает их к началу, иначе ввод
+     * запрашивается через консоль. Обмен запуска записывается заново для OnSaveIoRecording(). Вызывается
+     * только при остановленной виртуальной машине.
+     */
+    void PrepareInput();
     /**
      * @brief Создает структуру главного меню приложения
      *
@@ -252,22 +289,19 @@ private:
     /**
      * @brief Обрабатывает запрос на вывод данных
      *
-     * Метод вызывает сигнал OutputReady с переданными данными и их типом.
+     * Метод преобразует массив байт в строку и дописывает её в буфер вывода. Вызывается из потока исполнения,
+     * в консоль вывод переносится FlushOutput().
      *
      * @param bytes Данные, которые необходимо вывести
      * @param type Тип данных для вывода
      */
     void OutputRequest(snm::Bytes bytes, snm::Type type) override;
     /**
-     * @brief Вывод данных в консоль приложения
-     *
-     * Метод преобразует массив байт в строку в соответствии с указанным типом,
-     * а затем выводит преобразованную строку в консоль.
+     * @brief Переносит накопленный вывод в консоль одним фрагментом
      *
-     * @param bytes Массив байт, который необходимо преобразовать и вывести
-     * @param type Тип данных, по которому осуществляется преобразование массива байт
+     * Вызывается по таймеру во время исполнения, а также при остановке, паузе, ошибке и перед запросом ввода.
      */
-    void Output(snm::Bytes bytes, snm::Type type) const;
+    void FlushOutput() const;
 };
 
 #endif
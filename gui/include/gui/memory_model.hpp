@@ -2,6 +2,8 @@
 #define MEMORY_MODEL_HPP
 
 #include <QAbstractTableModel>
+#include <algorithm>
+#include <vector>
 
 #include "core/common_definitions.hpp"
 #include "core/virtual_machine.hpp"
@@ -10,13 +12,56 @@
 /**
  * @class MemoryModel
  * @brief Класс для асбстрактного представления модели памяти в виде таблицы.
+ *
+ * Модель хранит копию значений ячеек и их отформатированные строки. Refresh() перечитывает только ячейки,
+ * о возможном изменении которых сообщил контроллер, и уведомляет представление об изменённых строках
+ * таблицы. Строка ячейки форматируется при первом отображении после изменения значения.
  */
 class MemoryModel final : public QAbstractTableModel {
     Q_OBJECT
 
 public:
     explicit MemoryModel(VirtualMachineController& virtual_machine, QObject* parent = nullptr) :
-        QAbstractTableModel(parent), vm_controller_(virtual_machine) {
+        QAbstractTableModel(parent), vm_controller_(virtual_machine), values_(snm::CODE_MEMORY_SIZE),
+        texts_(snm::CODE_MEMORY_SIZE) {
+    }
+
+    /**
+     * @brief Перечитывает изменённые ячейки памяти и уведомляет представление об изменившихся строках.
+     */
+    void Refresh() {
+        std::vector<int> rows;
+
+        auto update = [&](const snm::Address address) {
+            const auto value = static_cast<snm::Word>(vm_controller_.ReadMemory(address));
+            if (value != values_[address]) {
+                values_[address] = value;
+                texts_[address] = QString();
+                rows.push_back(address / columnCount());
+            }
+        };
+
+        if (const auto dirty = vm_controller_.TakeDirtyMemory()) {
+            for (const snm::Address address : *dirty) {
+                update(address);
+            }
+            std::ranges::sort(rows);
+        } else {
+            for (size_t address = 0; address < snm::CODE_MEMORY_SIZE; ++address) {
+                update(static_cast<snm::Address>(address));
+            }
+        }
+
+        // Соседние изменённые строки объединяются в один диапазон
+        for (size_t first = 0; first < rows.size();) {
+            size_t last = first;
+            while (last + 1 < rows.size() && rows[last + 1] - rows[last] <= 1) {
+                ++last;
+            }
+            emit dataChanged(index(rows[first], 0), index(rows[last], columnCount() - 1),
+                             {Qt::DisplayRole, Qt::EditRole});
+            first = last + 1;
+        }
     }
 
     [[nodiscard]] snm::Address Address(const QModelIndex& index) const {
@@ -47,11 +92,12 @@ public:
         }
 
         if (role == Qt::DisplayRole || role == Qt::EditRole) {
-            snm::Bytes value = vm_controller_.ReadMemory(Address(index));
-
-            std::string hex = value.ToHexString();
+            const snm::Address address = Address(index);
+            if (texts_[address].isNull()) {
+                texts_[address] = QString::fromStdString(snm::Bytes(values_[address]).ToHexString()).toUpper();
+            }
 
-            return QString(hex.data()).toUpper();
+            return texts_[address];
         }
 
         return {};
@@ -84,6 +130,8 @@ public:
         }
 
         vm_controller_.WriteMemory(Address(index), snm::Bytes(source_value));
+        values_[Address(index)] = source_value;
+        texts_[Address(index)] = QString();
 
         emit dataChanged(index, index);
 
@@ -99,6 +147,8 @@ public:
 
 private:
     VirtualMachineController& vm_controller_;
+    std::vector<snm::Word> values_; ///< Значения ячеек на момент последнего обновления
+    mutable std::vector<QString> texts_; ///< Отформатированные значения ячеек. Строка без значения (isNull) ещё не отформатирована.
 };
 
 #endif
@@ -68,6 +68,10 @@ public:
         return IsDarkTheme() ? QColor(188, 190, 196) : QColor(7, 7, 22);
     }
 
+    static QColor LineNumberAreaHeat() {
+        return IsDarkTheme() ? QColor(214, 92, 62) : QColor(255, 112, 67);
+    }
+
 private:
     static bool IsDarkTheme() {
         return qApp && qApp->styleHints()->colorScheme() == Qt::ColorScheme::Dark;
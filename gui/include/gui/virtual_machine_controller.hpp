@@ -1,12 +1,22 @@
 #ifndef VIRTUAL_MACHINE_CONTROLLER_HPP
 #define VIRTUAL_MACHINE_CONTROLLER_HPP
 
+#include <QHash>
 #include <QMap>
 #include <QSet>
 #include <QThreadPool>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
+#include "core/batching_observer.hpp"
+#include "core/execution_history.hpp"
 #include "core/processor_observer.hpp"
+#include "core/profiler.hpp"
 #include "core/virtual_machine.hpp"
 
 /**
@@ -25,8 +35,20 @@ enum VmState {
  *
  * Этот класс обеспечивает интерфейс для управления виртуальной машиной, включая
  * загрузку байт-кода, управление точками останова, выполнение и отладку программы.
+ *
+ * При пошаговом выполнении контроллер наблюдает за процессором напрямую, а при отладочном запуске
+ * получает изменения пакетами через BatchingObserver, чтобы не обновлять интерфейс на каждой инструкции.
+ * Точки останова для байт-кода хранятся и проверяются в процессоре. Отладочный запуск и пошаговое выполнение
+ * профилируются и записываются в журнал исполнения, по которому приостановленную программу можно вернуть
+ * на шаг назад или к предыдущей точке останова. Профиль и журнал сбрасываются при каждом запуске
+ * из остановленного состояния.
+ *
+ * Запуск выполняется в потоке из QThreadPool. Пока машина в состоянии RUNNING, регистры и память читаются
+ * из снимка процессора, обновляемого UpdateSnapshot(), а не из самого процессора. Остановка, пауза, сброс
+ * и загрузка дожидаются завершения потока исполнения, прежде чем изменять процессор.
  */
-class VirtualMachineController final : public QObject, public VirtualMachine, public ProcessorObserver {
+class VirtualMachineController final : public QObject, public VirtualMachine, public ProcessorObserver,
+                                       public ProcessorChangesObserver {
     Q_OBJECT
 
 public:
@@ -36,6 +58,10 @@ public:
      * @param parent Родительский QObject (по умолчанию nullptr).
      */
     explicit VirtualMachineController(ProcessorIo* processor_io = nullptr, QObject* parent = nullptr);
+    /**
+     * @brief Останавливает исполнение и дожидается завершения потока исполнения.
+     */
+    ~VirtualMachineController() override;
 
     /**
      * @brief Загружает байт-код и карту соответствия исходного кода байт-коду.
@@ -53,10 +79,41 @@ public:
      * @return Номер текущей строки кода.
      */
     unsigned int GetCurrentCodeLine();
+    /**
+     * @brief Возвращает долю исполнений каждой строки исходного кода от максимальной за отладочный запуск.
+     * @return Значения от 0 до 1 по номерам строк. Пусто, если программа не запускалась в режиме отладки
+     *         или по шагам.
+     */
+    [[nodiscard]] QHash<unsigned int, double> GetLineHeat() const;
     /**
      * @brief Сбрасывает состояние процессора включая регистры, но не сбрасывает память
      */
     void ResetProcessor() const;
+    /**
+     * @brief Обновляет снимок, из которого читаются регистры и память во время исполнения.
+     *
+     * Вызывается из потока интерфейса, например перед каждой перерисовкой. Не останавливает исполнение.
+     */
+    void UpdateSnapshot();
+    /**
+     * @brief Читает аргумент ячейки памяти. Во время исполнения значение берётся из снимка.
+     * @param address Адрес ячейки.
+     * @return Аргумент ячейки.
+     */
+    [[nodiscard]] snm::Bytes ReadMemory(const snm::Address& address) override;
+    /**
+     * @brief Возвращает регистры процессора. Во время исполнения значения берутся из снимка.
+     */
+    [[nodiscard]] Registers GetRegisters() override;
+    /**
+     * @brief Возвращает адреса ячеек памяти, которые могли измениться с предыдущего вызова, и очищает их.
+     *
+     * Изменения собираются из уведомлений наблюдателя при отладочном запуске и пошаговом выполнении.
+     * Загрузка, сброс и запуск без наблюдателя не сообщают отдельных адресов и делают устаревшей всю память.
+     *
+     * @return Адреса в произвольном порядке, возможно с повторами, или std::nullopt, если устарела вся память.
+     */
+    [[nodiscard]] std::optional<std::vector<snm::Address>> TakeDirtyMemory();
 
     // === Методы-наблюдатели, реализующие интерфейс ProcessorObserver ===
 
@@ -66,6 +123,10 @@ public:
     void OnRegisterAuxChanged(const snm::Bytes& auxiliary) override;
     void OnRegisterIpChanged(const snm::Address& instruction_pointer) override;
 
+    // === Методы-наблюдатели, реализующие интерфейс ProcessorChangesObserver ===
+
+    void OnChanges(const ProcessorChanges& changes) override;
+
 public slots:
     // === Управление состоянием машины ===
     /**
@@ -80,6 +141,14 @@ public slots:
      * @brief Выполняет один шаг программы.
      */
     void OnStep();
+    /**
+     * @brief Отменяет последний выполненный шаг программы по журналу исполнения.
+     */
+    void OnStepBack();
+    /**
+     * @brief Возвращает исполнение к предыдущей точке останова по журналу исполнения.
+     */
+    void OnReverseContinue();
     /**
      * @brief Останавливает и сбрасывает полностью состояние виртуальной машины.
      */
@@ -150,18 +219,36 @@ signals:
     void ErrorOccurred(const QString& error);
 
 private:
-    VmState state_; ///< Текущее состояние
-    bool debugging_; ///< Признак работы в режиме отладки
-    QSet<snm::Address> breakpoints_; ///< Точки останова для байт-кода
+    std::atomic<VmState> state_; ///< Текущее состояние. Изменяется также потоком исполнения.
+    std::atomic<bool> debugging_; ///< Признак работы в режиме отладки
+    std::mutex worker_mutex_; ///< Защищает признак потока исполнения
+    std::condition_variable worker_finished_; ///< Оповещает о завершении потока исполнения
+    bool worker_active_ = false; ///< Признак незавершённого потока исполнения
+    std::atomic<bool> pause_requested_ = false; ///< Признак остановки исполнения для паузы, а не завершения
+    std::shared_ptr<const ProcessorSnapshot> snapshot_; ///< Снимок для чтения во время исполнения
+    std::mutex dirty_memory_mutex_; ///< Защищает изменённые адреса, пополняемые также потоком исполнения
+    std::vector<snm::Address> dirty_memory_; ///< Адреса ячеек, изменённых с последнего TakeDirtyMemory()
+    bool all_memory_dirty_ = true; ///< Признак изменения памяти без уведомлений об отдельных адресах
     QSet<unsigned int> source_breakpoints_; ///< Точки останова для исходного кода
     snm::SourceToBytecodeMap source_to_bytecode_map_; ///< Карта соответствия исходного кода байт-коду
     snm::BytecodeToSourceMap bytecode_to_source_map_; ///< Карта соответствия байт-кода исходному коду
+    BatchingObserver batching_observer_; ///< Наблюдатель, объединяющий изменения при отладочном запуске
+    Profiler profiler_; ///< Профиль отладочного запуска
+    ExecutionHistory history_; ///< Журнал отладочного запуска и пошагового выполнения для возврата назад
 
     /**
      * @brief Устанавливает новое состояние виртуальной машины.
      * @param state Новое состояние.
      */
     void SetState(VmState state);
+    /**
+     * @brief Дожидается завершения потока исполнения, если он запущен.
+     */
+    void WaitForWorker();
+    /**
+     * @brief Отмечает всю память как изменённую.
+     */
+    void MarkAllMemoryDirty();
     /**
      * @brief Обновляет точки останова в соответствии с байт-кодом
      */
@@ -137,6 +137,12 @@ void CodeEditor::LineNumberAreaPaintEvent(const QPaintEvent* event) const {
             const int circle_y = top + (font_height - 14) / 2;
             const int arrow_y = top + (font_height - 10) / 2;
 
+            if (const double heat = line_heat_.value(current_line); heat > 0) {
+                QColor color = StyleColors::LineNumberAreaHeat();
+                color.setAlphaF(static_cast<float>(0.15 + 0.65 * heat));
+                painter.fillRect(0, top, line_number_area_->width() - 1, font_height, color);
+            }
+
             if (highlighted_lines_.contains(current_line))
                 DrawArrow(painter, 0, arrow_y);
 
@@ -349,6 +355,11 @@ void CodeEditor::ClearHighlightedLines() {
     viewport()->update();
 }
 
+void CodeEditor::SetLineHeat(QHash<unsigned int, double> line_heat) {
+    line_heat_ = std::move(line_heat);
+    line_number_area_->update();
+}
+
 void CodeEditor::ApplyTheme() {
     QPalette palette = this->palette();
     palette.setColor(QPalette::Text, StyleColors::CodeEditorOther());
@@ -12,8 +12,11 @@
 #include <QStatusBar>
 #include <QTextBrowser>
 #include <QToolBar>
+#include <QTransform>
 #include <QVBoxLayout>
 
+#include <sstream>
+
 #include "../include/gui/main_window.hpp"
 #include "../include/gui/style_colors.hpp"
 
@@ -26,6 +29,7 @@ MainWindow::MainWindow(QWidget* parent)
       memory_table_model_(new MemoryModel(*vm_controller_, this)),
       memory_table_view_(new MemoryView(this)),
       console_(new Console(this)),
+      output_timer_(new QTimer(this)),
       tool_bar_(new QToolBar(this)),
       status_bar_(new QStatusBar(this)),
       examples_menu_(new QMenu(this)),
@@ -34,6 +38,8 @@ MainWindow::MainWindow(QWidget* parent)
       action_pause_continue_(new QAction(this)),
       action_debug_(new QAction(this)),
       action_step_(new QAction(this)),
+      action_step_back_(new QAction(this)),
+      action_reverse_continue_(new QAction(this)),
       is_bytecode_fresh_(false)
 {
     SetupUi();
@@ -43,6 +49,10 @@ MainWindow::MainWindow(QWidget* parent)
     ApplyTheme();
 }
 
+MainWindow::~MainWindow() {
+    vm_controller_->OnStop();
+}
+
 void MainWindow::SetupUi() {
     memory_table_view_->setModel(memory_table_model_);
     for (int column = 0; column < memory_table_model_->columnCount(); ++column) {
@@ -66,7 +76,9 @@ void MainWindow::SetupUi() {
 }
 
 void MainWindow::SetupConnections() {
-    connect(this, &MainWindow::OutputReady, this, &MainWindow::Output, Qt::QueuedConnection);
+    // Интервал соответствует одному кадру: вывод появляется без задержки, заметной глазу
+    output_timer_->setInterval(16);
+    connect(output_timer_, &QTimer::timeout, this, &MainWindow::FlushOutput);
 
     connect(memory_table_view_, &MemoryView::CellHovered, this,
         [this](const int row, const int column, std::optional<snm::Word> value) {
@@ -103,11 +115,21 @@ void MainWindow::CreateMenus() {
     const QAction* save_action = file_menu->addAction("Сохранить", QKeySequence(Qt::CTRL | Qt::Key_S));
     const QAction* save_as_action = file_menu->addAction("Сохранить как ...",
                                                          QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_S));
+    file_menu->addSeparator();
+    const QAction* open_input_action = file_menu->addAction("Файл ввода ...");
+    const QAction* clear_input_action = file_menu->addAction("Ввод из консоли");
+    const QAction* save_recording_action = file_menu->addAction("Сохранить запись ввода-вывода ...");
+    const QAction* open_recording_action = file_menu->addAction("Воспроизвести запись ввода-вывода ...");
+    file_menu->addSeparator();
     const QAction* exit_action = file_menu->addAction("Выход", QKeySequence(Qt::CTRL | Qt::Key_Q));
 
     connect(open_action, &QAction::triggered, this, &MainWindow::OnOpenFile);
     connect(save_action, &QAction::triggered, this, &MainWindow::OnSaveFile);
     connect(save_as_action, &QAction::triggered, this, &MainWindow::OnSaveAsFile);
+    connect(open_input_action, &QAction::triggered, this, &MainWindow::OnOpenInputFile);
+    connect(clear_input_action, &QAction::triggered, this, &MainWindow::OnClearInputFile);
+    connect(save_recording_action, &QAction::triggered, this, &MainWindow::OnSaveIoRecording);
+    connect(open_recording_action, &QAction::triggered, this, &MainWindow::OnOpenIoRecording);
     connect(exit_action, &QAction::triggered, this, &QMainWindow::close);
 
     QMenu* emulator_menu = menuBar()->addMenu("Эмулятор");
@@ -282,6 +304,119 @@ void MainWindow::OnSaveAsFile() {
     OnSaveFile();
 }
 
+void MainWindow::OnOpenInputFile() {
+    // Исполняемая программа обращается к текущему вводу из потока исполнения
+    if (vm_controller_->GetState() != STOPPED) {
+        QMessageBox::information(this, "Файл ввода", "Файл ввода можно выбрать только при остановленной программе");
+        return;
+    }
+
+    const QString file_name = QFileDialog::getOpenFileName(
+        this,
+        "Открыть файл ввода",
+        "",
+        "Текстовые файлы (*.txt);;Все файлы (*.*)"
+        );
+
+    if (file_name.isEmpty()) {
+        return;
+    }
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QMessageBox::critical(this, "Ошибка", "Не удалось открыть файл");
+        return;
+    }
+
+    std::istringstream input(file.readAll().toStdString());
+    file.close();
+
+    try {
+        input_feed_.emplace(InputFeedIo::Parse(input), *this);
+    } catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+        return;
+    }
+
+    status_bar_->showMessage(QString("Файл ввода: %1, значений: %2").arg(file_name).arg(input_feed_->GetRemaining()));
+}
+
+void MainWindow::OnClearInputFile() {
+    if (vm_controller_->GetState() != STOPPED) {
+        QMessageBox::information(this, "Файл ввода", "Файл ввода можно сбросить только при остановленной программе");
+        return;
+    }
+
+    input_feed_.reset();
+    replay_.reset();
+    status_bar_->showMessage("Ввод из консоли");
+}
+
+void MainWindow::OnSaveIoRecording() {
+    if (vm_controller_->GetState() != STOPPED) {
+        QMessageBox::information(this, "Запись ввода-вывода",
+                                 "Запись ввода-вывода можно сохранить только при остановленной программе");
+        return;
+    }
+
+    if (!recording_) {
+        QMessageBox::information(this, "Запись ввода-вывода", "Программа ещё не запускалась");
+        return;
+    }
+
+    const QString file_name = QFileDialog::getSaveFileName(
+        this,
+        "Сохранить запись ввода-вывода",
+        "",
+        "Записи ввода-вывода (*.snmr);;Все файлы (*.*)"
+        );
+
+    if (file_name.isEmpty()) {
+        return;
+    }
+
+    try {
+        IoLogFile::Write(file_name.toStdString(), recording_->GetEvents());
+    } catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+        return;
+    }
+
+    status_bar_->showMessage(QString("Запись ввода-вывода сохранена: %1, событий: %2")
+        .arg(file_name).arg(recording_->GetEvents().size()));
+}
+
+void MainWindow::OnOpenIoRecording() {
+    if (vm_controller_->GetState() != STOPPED) {
+        QMessageBox::information(this, "Запись ввода-вывода",
+                                 "Запись ввода-вывода можно выбрать только при остановленной программе");
+        return;
+    }
+
+    const QString file_name = QFileDialog::getOpenFileName(
+        this,
+        "Воспроизвести запись ввода-вывода",
+        "",
+        "Записи ввода-вывода (*.snmr);;Все файлы (*.*)"
+        );
+
+    if (file_name.isEmpty()) {
+        return;
+    }
+
+    try {
+        replay_.emplace(IoLogFile::Read(file_name.toStdString()), *this, [this] {
+            return vm_controller_->GetInstructionCount();
+        });
+    } catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+        return;
+    }
+
+    status_bar_->showMessage(QString("Воспроизведение записи: %1, событий: %2")
+        .arg(file_name).arg(replay_->GetRemaining()));
+}
+
 void MainWindow::ShowHelp() {
     // ReSharper disable once CppDFAMemoryLeak
     const auto help_dialog = new QDialog(this);
@@ -389,24 +524,35 @@ void MainWindow::CreateToolBar() {
     action_pause_continue_ = tool_bar_->addAction("Пауза/Продолжить");
     action_stop_ = tool_bar_->addAction("Остановка");
     action_step_ = tool_bar_->addAction("Шаг");
+    action_step_back_ = tool_bar_->addAction("Шаг назад");
+    action_reverse_continue_ = tool_bar_->addAction("Назад до точки останова");
 
     action_start_->setIcon(QIcon(":/resources/icons/start.png"));
     action_debug_->setIcon(QIcon(":/resources/icons/debug.png"));
     action_pause_continue_->setIcon(QIcon(":/resources/icons/pause.png"));
     action_stop_->setIcon(QIcon(":/resources/icons/stop.png"));
     action_step_->setIcon(QIcon(":/resources/icons/next.png"));
+    // Действия обратного исполнения используют отражённые иконки шага и продолжения
+    action_step_back_->setIcon(QIcon(QPixmap(":/resources/icons/next.png").transformed(QTransform().scale(-1, 1))));
+    action_reverse_continue_->setIcon(
+        QIcon(QPixmap(":/resources/icons/continue.png").transformed(QTransform().scale(-1, 1))));
 
     connect(action_start_, &QAction::triggered, this, &MainWindow::OnRun);
     connect(action_debug_, &QAction::triggered, this, &MainWindow::OnDebug);
     connect(action_pause_continue_, &QAction::triggered, vm_controller_, &VirtualMachineController::OnPauseContinue);
     connect(action_stop_, &QAction::triggered, vm_controller_, &VirtualMachineController::OnStop);
     connect(action_step_, &QAction::triggered, this, &MainWindow::OnStep);
+    connect(action_step_back_, &QAction::triggered, vm_controller_, &VirtualMachineController::OnStepBack);
+    connect(action_reverse_continue_, &QAction::triggered, vm_controller_,
+            &VirtualMachineController::OnReverseContinue);
 
     action_start_->setShortcut(QKeyCombination(Qt::CTRL | Qt::Key_R));
     action_debug_->setShortcut(QKeyCombination(Qt::CTRL | Qt::Key_F5));
     action_pause_continue_->setShortcut(QKeyCombination(Qt::CTRL | Qt::Key_R));
     action_stop_->setShortcut(QKeyCombination(Qt::CTRL | Qt::SHIFT | Qt::Key_F5));
     action_step_->setShortcut(QKeyCombination(Qt::CTRL | Qt::Key_F7));
+    action_step_back_->setShortcut(QKeyCombination(Qt::CTRL | Qt::SHIFT | Qt::Key_F7));
+    action_reverse_continue_->setShortcut(QKeyCombination(Qt::CTRL | Qt::SHIFT | Qt::Key_F8));
 
     emit OnStateVmChanged(STOPPED, false);
 }
@@ -420,6 +566,8 @@ void MainWindow::SetToolbarActions(const VmState state, bool debugging = false)
         : QIcon(":/resources/icons/pause.png"));
     action_stop_->setVisible(state == RUNNING || state == PAUSED);
     action_step_->setVisible(state != RUNNING);
+    action_step_back_->setVisible(state == PAUSED);
+    action_reverse_continue_->setVisible(state == PAUSED);
 }
 
 void MainWindow::UpdateStatusBar(const std::optional<snm::Word> value, const int address) const {
@@ -466,17 +614,37 @@ bool MainWindow::UpdateByteCode() {
     return false;
 }
 
+void MainWindow::PrepareInput() {
+    ProcessorIo* io = this;
+    if (replay_) {
+        replay_->Rewind();
+        io = &*replay_;
+    } else if (input_feed_) {
+        input_feed_->Rewind();
+        io = &*input_feed_;
+    }
+
+    recording_.emplace(*io, [this] {
+        return vm_controller_->GetInstructionCount();
+    });
+    vm_controller_->SetProcessorIo(&*recording_);
+}
+
 void MainWindow::OnRun() {
     vm_controller_->ResetProcessor();
     if (!UpdateByteCode()) {
         return;
     }
+    PrepareInput();
     emit vm_controller_->OnRun();
 }
 
 void MainWindow::OnStep() {
-    if (vm_controller_->GetState() == STOPPED && !UpdateByteCode()) {
-        return;
+    if (vm_controller_->GetState() == STOPPED) {
+        if (!UpdateByteCode()) {
+            return;
+        }
+        PrepareInput();
     }
     emit vm_controller_->OnStep();
 }
@@ -486,12 +654,23 @@ void MainWindow::OnDebug() {
     if (!UpdateByteCode()) {
         return;
     }
+    PrepareInput();
     emit vm_controller_->OnDebug();
 }
 
 void MainWindow::OnStateVmChanged(const VmState state, const bool debugging) const {
+    if (state == RUNNING) {
+        output_timer_->start();
+    } else {
+        output_timer_->stop();
+        FlushOutput();
+    }
+
     SetToolbarActions(state, debugging);
     code_editor_->ClearHighlightedLines();
+    if (state != RUNNING) {
+        code_editor_->SetLineHeat(vm_controller_->GetLineHeat());
+    }
     if (state == PAUSED) {
         const unsigned int current_line = vm_controller_->GetCurrentCodeLine();
         code_editor_->ScrollToLine(current_line); // NOLINT(*-narrowing-conversions)
@@ -503,7 +682,8 @@ void MainWindow::OnStateVmChanged(const VmState state, const bool debugging) con
 }
 
 void MainWindow::OnUpdateVm() const {
-    emit memory_table_model_->layoutChanged();
+    vm_controller_->UpdateSnapshot();
+    memory_table_model_->Refresh();
 
     const auto [accumulator, auxiliary, instruction_pointer] = vm_controller_->GetRegisters();
 
@@ -517,6 +697,7 @@ void MainWindow::OnResetVm() {
 }
 
 void MainWindow::OnErrorOccurred(const QString& error) const {
+    FlushOutput();
     console_->append(error + "\n");
 }
 
@@ -585,27 +766,29 @@ void MainWindow::InputRequest(snm::Type type, InputCallback callback) {
         callback({});
         return;
     }
-    console_->GetInputStringAsync([this, type, callback](const QString& input) {
-        snm::Bytes bytes{};
-        try {
-            bytes = VirtualMachine::BytesFromString(input.toStdString(), type);
-        } catch (const std::exception& e) {
-            console_->insertPlainText("\nError: " + QString(e.what()));
-        }
-        callback(bytes);
-    });
+
+    // Запрос приходит из потока исполнения: консоль изменяется в потоке интерфейса после уже выведенного текста
+    QMetaObject::invokeMethod(this, [this, type, callback] {
+        FlushOutput();
+        console_->GetInputStringAsync([this, type, callback](const QString& input) {
+            snm::Bytes bytes{};
+            try {
+                bytes = VirtualMachine::BytesFromString(input.toStdString(), type);
+            } catch (const std::exception& e) {
+                console_->insertPlainText("\nError: " + QString(e.what()));
+            }
+            callback(bytes);
+        });
+    }, Qt::QueuedConnection);
 }
 
 void MainWindow::OutputRequest(const snm::Bytes bytes, const snm::Type type) {
-    emit OutputReady(bytes, type);
+    output_buffer_.Write(VirtualMachine::BytesToString(bytes, type));
 }
 
-void MainWindow::Output(const snm::Bytes bytes, const snm::Type type) const {
-    if (!console_) {
+void MainWindow::FlushOutput() const {
+    if (!output_buffer_.Drain(output_chunk_) || !console_) {
         return;
     }
-    const auto result = VirtualMachine::BytesToString(bytes, type);
-    if (!result.empty()) {
-        console_->insertPlainText(QString::fromStdString(result));
-    }
+    console_->insertPlainText(QString::fromStdString(output_chunk_));
 }
@@ -4,15 +4,24 @@
 VirtualMachineController::VirtualMachineController(ProcessorIo* processor_io, QObject* parent) :
     QObject(parent),
     state_(STOPPED),
-    debugging_(false) {
+    debugging_(false),
+    batching_observer_(*this) {
     SetProcessorIo(processor_io);
+    snapshot_ = VirtualMachine::GetSnapshot();
+}
+
+VirtualMachineController::~VirtualMachineController() {
+    VirtualMachine::Stop();
+    WaitForWorker();
 }
 
 // === Управление машиной ===
 
 void VirtualMachineController::Load(const snm::ByteCode& byte_code,
                                     snm::SourceToBytecodeMap& source_to_bytecode_map) {
+    WaitForWorker();
     VirtualMachine::Load(byte_code);
+    MarkAllMemoryDirty();
     source_to_bytecode_map_ = std::move(source_to_bytecode_map);
 
     bytecode_to_source_map_.clear();
@@ -24,36 +33,74 @@ void VirtualMachineController::Load(const snm::ByteCode& byte_code,
 }
 
 void VirtualMachineController::OnRun() {
-    SetProcessorObserver(debugging_ ? this : nullptr);
+    WaitForWorker();
+
+    batching_observer_.Discard();
+    SetProcessorObserver(debugging_ ? &batching_observer_ : nullptr);
+    SetBreakpointsEnabled(debugging_);
+    SetProfiler(debugging_ ? &profiler_ : nullptr);
+    SetHistory(debugging_ ? &history_ : nullptr);
 
     if (state_ == STOPPED) {
         memory_manager_->ResetData();
+        profiler_.Reset();
+        history_.Clear();
+        MarkAllMemoryDirty();
     }
 
+    // До запуска процессор принадлежит потоку интерфейса, поэтому снимок публикуется здесь
+    processor_->PublishSnapshot();
+    snapshot_ = VirtualMachine::GetSnapshot();
+
+    pause_requested_ = false;
+    {
+        std::lock_guard lock(worker_mutex_);
+        worker_active_ = true;
+    }
     SetState(RUNNING);
 
     QThreadPool::globalInstance()->start([this] {
+        // Снимает признак потока исполнения при любом выходе. Оповещение под мьютексом не даёт ожидающему
+        // потоку разрушить контроллер до завершения оповещения.
+        struct WorkerGuard {
+            VirtualMachineController& controller;
+
+            ~WorkerGuard() {
+                std::lock_guard lock(controller.worker_mutex_);
+                controller.worker_active_ = false;
+                controller.worker_finished_.notify_all();
+            }
+        } guard{*this};
+
         try {
             VirtualMachine::Run();
         } catch (const std::exception& e) {
+            MarkAllMemoryDirty();
             SetState(STOPPED);
             emit ErrorOccurred(QString(e.what()));
             return;
         }
-        if (state_ != PAUSED) {
+        // Запуск без наблюдателя не сообщает об изменённых ячейках
+        if (!debugging_) {
+            MarkAllMemoryDirty();
+        }
+
+        if (VirtualMachine::GetState() == snm::ProcessorState::BREAKPOINT) {
+            SetState(PAUSED);
+        } else if (!pause_requested_) {
             SetState(STOPPED);
-        } else {
-            emit Update();
         }
     });
 }
 
 void VirtualMachineController::OnStop() {
-    SetProcessorObserver(nullptr);
-
     VirtualMachine::Stop();
+    WaitForWorker();
+
+    SetProcessorObserver(nullptr);
     processor_->Reset();
     memory_manager_->ResetData();
+    MarkAllMemoryDirty();
     SetState(STOPPED);
 }
 
@@ -61,8 +108,13 @@ void VirtualMachineController::OnStep() {
     if (state_ == STOPPED) {
         processor_->Reset();
         memory_manager_->ResetData();
+        profiler_.Reset();
+        history_.Clear();
+        MarkAllMemoryDirty();
 
         SetProcessorObserver(this);
+        SetProfiler(&profiler_);
+        SetHistory(&history_);
         // Так как машина остановлена, необходимо встать на первую инструкцию, но не выполнять ее
         SetState(PAUSED);
     } else {
@@ -79,9 +131,36 @@ void VirtualMachineController::OnStep() {
     }
 }
 
+void VirtualMachineController::OnStepBack() {
+    if (state_ != PAUSED) {
+        return;
+    }
+
+    // Изменения регистров и памяти при возврате сообщаются напрямую, а не пакетами отладочного запуска
+    SetProcessorObserver(this);
+    VirtualMachine::StepBack();
+    emit StateChanged(state_, debugging_);
+    emit Update();
+}
+
+void VirtualMachineController::OnReverseContinue() {
+    if (state_ != PAUSED) {
+        return;
+    }
+
+    SetProcessorObserver(this);
+    VirtualMachine::ReverseContinue();
+    emit StateChanged(state_, debugging_);
+    emit Update();
+}
+
 void VirtualMachineController::OnReset() {
+    VirtualMachine::Stop();
+    WaitForWorker();
+
     SetProcessorObserver(nullptr);
     VirtualMachine::Reset();
+    MarkAllMemoryDirty();
     emit Update();
     emit Reseted();
 }
@@ -90,15 +169,56 @@ void VirtualMachineController::ResetProcessor() const {
     processor_->Reset();
 }
 
+void VirtualMachineController::UpdateSnapshot() {
+    if (state_ == RUNNING) {
+        snapshot_ = VirtualMachine::GetSnapshot();
+    }
+}
+
+snm::Bytes VirtualMachineController::ReadMemory(const snm::Address& address) {
+    if (state_ == RUNNING) {
+        return snapshot_->memory.ReadArgument(address);
+    }
+
+    return VirtualMachine::ReadMemory(address);
+}
+
+std::optional<std::vector<snm::Address>> VirtualMachineController::TakeDirtyMemory() {
+    std::lock_guard lock(dirty_memory_mutex_);
+
+    // Во время запуска без наблюдателя память меняется без уведомлений
+    if (std::exchange(all_memory_dirty_, false) || (state_ == RUNNING && !debugging_)) {
+        dirty_memory_.clear();
+        return std::nullopt;
+    }
+
+    return std::exchange(dirty_memory_, {});
+}
+
+Registers VirtualMachineController::GetRegisters() {
+    if (state_ == RUNNING) {
+        return snapshot_->registers;
+    }
+
+    return VirtualMachine::GetRegisters();
+}
+
 void VirtualMachineController::OnDebug() {
     debugging_ = true;
     OnRun();
 }
 
 void VirtualMachineController::OnPauseContinue() {
-    if (IsRunning()) {
+    // Состояние контроллера, в отличие от состояния процессора, равно RUNNING и до старта потока исполнения
+    if (state_ == RUNNING) {
+        pause_requested_ = true;
         VirtualMachine::Stop();
-        SetState(PAUSED);
+        WaitForWorker();
+
+        // Программа могла завершиться раньше остановки
+        if (state_ == RUNNING) {
+            SetState(PAUSED);
+        }
     } else {
         OnRun();
         // Слот не требуется, так как бросается в OnRun
@@ -119,6 +239,17 @@ void VirtualMachineController::SetState(const VmState state) {
     emit Update();
 }
 
+void VirtualMachineController::MarkAllMemoryDirty() {
+    std::lock_guard lock(dirty_memory_mutex_);
+    all_memory_dirty_ = true;
+    dirty_memory_.clear();
+}
+
+void VirtualMachineController::WaitForWorker() {
+    std::unique_lock lock(worker_mutex_);
+    worker_finished_.wait(lock, [this] { return !worker_active_; });
+}
+
 VmState VirtualMachineController::GetState() const {
     return state_;
 }
@@ -131,33 +262,45 @@ unsigned int VirtualMachineController::GetCurrentCodeLine() {
     return 0;
 }
 
+QHash<unsigned int, double> VirtualMachineController::GetLineHeat() const {
+    const std::map<unsigned int, uint64_t> counts = profiler_.GetLineCounts(source_to_bytecode_map_);
+    const auto max = std::ranges::max_element(counts, {}, &std::pair<const unsigned int, uint64_t>::second);
+
+    QHash<unsigned int, double> result;
+    for (const auto& [line, count] : counts) {
+        result.insert(line, static_cast<double>(count) / static_cast<double>(max->second));
+    }
+
+    return result;
+}
+
 // === Точки останова ===
 
 void VirtualMachineController::OnInsertBreakpoint(const unsigned int breakpoint) {
     source_breakpoints_.insert(breakpoint);
 
     if (source_to_bytecode_map_.contains(breakpoint)) {
-        breakpoints_.insert(source_to_bytecode_map_[breakpoint]);
+        SetBreakpoint(source_to_bytecode_map_[breakpoint]);
     }
 }
 
 void VirtualMachineController::OnRemoveBreakpoint(const unsigned int breakpoint) {
     source_breakpoints_.remove(breakpoint);
     if (source_to_bytecode_map_.contains(breakpoint)) {
-        breakpoints_.remove(source_to_bytecode_map_[breakpoint]);
+        RemoveBreakpoint(source_to_bytecode_map_[breakpoint]);
     }
 }
 
 void VirtualMachineController::OnClearBreakpoints() {
-    breakpoints_.clear();
+    ClearBreakpoints();
 }
 
 void VirtualMachineController::UpdateBreakpoints() {
-    breakpoints_.clear();
+    ClearBreakpoints();
 
     for (auto breakpoint : source_breakpoints_) {
         if (source_to_bytecode_map_.contains(breakpoint)) {
-            breakpoints_.insert(source_to_bytecode_map_[breakpoint]);
+            SetBreakpoint(source_to_bytecode_map_[breakpoint]);
         }
     }
 }
@@ -179,10 +322,6 @@ void VirtualMachineController::OnInstructionPointerEdited(const int value) {
 // === Методы-наблюдатели, реализующие интерфейс ProcessorObserver ===
 
 void VirtualMachineController::OnRegisterIpChanged(const snm::Address& instruction_pointer) {
-    if (debugging_ && breakpoints_.contains(instruction_pointer)) {
-        VirtualMachine::Stop();
-        SetState(PAUSED);
-    }
     emit StateChanged(state_, debugging_);
     emit Update();
 }
@@ -194,7 +333,22 @@ void VirtualMachineController::OnRegisterAuxChanged(const snm::Bytes& auxiliary)
 }
 
 void VirtualMachineController::OnMemoryChanged(const snm::Address& address) {
+    std::lock_guard lock(dirty_memory_mutex_);
+    dirty_memory_.push_back(address);
 }
 
 void VirtualMachineController::OnStateChanged(const snm::ProcessorState& state) {
 }
+
+// === Методы-наблюдатели, реализующие интерфейс ProcessorChangesObserver ===
+
+void VirtualMachineController::OnChanges(const ProcessorChanges& changes) {
+    // Вызывается в потоке исполнения, поэтому снимок для интерфейса публикуется вместе с пакетом
+    processor_->PublishSnapshot();
+    {
+        std::lock_guard lock(dirty_memory_mutex_);
+        dirty_memory_.insert(dirty_memory_.end(), changes.memory.begin(), changes.memory.end());
+    }
+    emit StateChanged(state_, debugging_);
+    emit Update();
+}
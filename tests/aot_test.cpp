@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "core/aot_runtime.hpp"
+#include "core/aot_translator.hpp"
+#include "core/assembler.hpp"
+#include "core/stream_io.hpp"
+
+extern const AotProgram AOT_FACTORIAL;
+extern const AotProgram AOT_BUBBLE_SORT;
+extern const AotProgram AOT_MAX;
+extern const AotProgram AOT_SELF_MODIFYING;
+
+namespace {
+    struct RunResult {
+        std::string output;
+        Registers registers;
+        uint64_t instruction_count;
+        std::vector<snm::Word> memory;
+    };
+
+    std::vector<snm::Word> ReadMemory(const MemoryManager& memory) {
+        std::vector<snm::Word> result;
+        for (size_t address = 0; address < snm::CODE_MEMORY_SIZE; ++address) {
+            result.push_back(static_cast<snm::Word>(memory.ReadArgument(static_cast<snm::Address>(address))));
+        }
+        return result;
+    }
+
+    RunResult RunInterpreted(const AotProgram& program, const std::string& input) {
+        std::istringstream input_stream(input);
+        std::ostringstream output_stream;
+        MemoryManager memory;
+        RunResult result;
+
+        {
+            StreamIo io(input_stream, output_stream);
+            Processor processor(memory, nullptr, &io);
+            memory.Load(program.byte_code);
+            processor.Run();
+
+            result.registers = processor.GetRegisters();
+            result.instruction_count = processor.GetInstructionCount();
+        }
+
+        result.output = output_stream.str();
+        result.memory = ReadMemory(memory);
+        return result;
+    }
+
+    RunResult RunCompiled(AotRuntime& runtime) {
+        runtime.Run();
+        return {{}, runtime.GetRegisters(), runtime.GetInstructionCount(), ReadMemory(runtime.GetMemory())};
+    }
+
+    void ExpectSameResult(const AotProgram& program, const std::string& input, const bool interpreted) {
+        const RunResult expected = RunInterpreted(program, input);
+
+        std::istringstream input_stream(input);
+        std::ostringstream output_stream;
+        StreamIo io(input_stream, output_stream);
+        AotRuntime runtime(program, io);
+
+        // Второй запуск после Reset() проверяет восстановление исходной памяти
+        for (int run = 0; run < 2; ++run) {
+            input_stream.clear();
+            input_stream.seekg(0);
+            output_stream.str("");
+            runtime.Reset();
+
+            RunResult actual = RunCompiled(runtime);
+            io.Flush();
+            actual.output = output_stream.str();
+
+            EXPECT_EQ(actual.output, expected.output);
+            EXPECT_EQ(static_cast<snm::Word>(actual.registers.accumulator),
+                      static_cast<snm::Word>(expected.registers.accumulator));
+            EXPECT_EQ(static_cast<snm::Word>(actual.registers.auxiliary),
+                      static_cast<snm::Word>(expected.registers.auxiliary));
+            EXPECT_EQ(actual.registers.instruction_pointer, expected.registers.instruction_pointer);
+            EXPECT_EQ(actual.instruction_count, expected.instruction_count);
+            EXPECT_EQ(actual.memory, expected.memory);
+            EXPECT_EQ(runtime.IsInterpreted(), interpreted);
+        }
+    }
+}
+
+TEST(AotTest, Examples) {
+    ExpectSameResult(AOT_FACTORIAL, "", false);
+    ExpectSameResult(AOT_BUBBLE_SORT, "", false);
+    ExpectSameResult(AOT_MAX, "-5 7", false);
+    ExpectSameResult(AOT_MAX, "12 7", false);
+}
+
+TEST(AotTest, SelfModifyingCode) {
+    ExpectSameResult(AOT_SELF_MODIFYING, "", true);
+}
+
+TEST(AotTest, Errors) {
+    std::istringstream input_stream;
+    std::ostringstream output_stream;
+    StreamIo io(input_stream, output_stream);
+
+    // Ввод закончился: ошибка обработчика ввода-вывода после ячеек A и B, IP указывает на инструкцию ввода
+    AotRuntime runtime(AOT_MAX, io);
+    EXPECT_THROW(runtime.Run(), std::runtime_error);
+    EXPECT_EQ(runtime.GetRegisters().instruction_pointer, 2);
+    EXPECT_EQ(runtime.GetInstructionCount(), 3);
+}
+
+TEST(AotTest, Translate) {
+    Assembler assembler;
+    const snm::ByteCode byte_code = assembler.Compile("Loop: Add 1\nJump Loop\nJump & 0");
+
+    const std::string source = AotTranslator::Translate(byte_code, "PROGRAM", {{"LOOP", 0}});
+    EXPECT_NE(source.find("// LOOP:"), std::string::npos);
+    EXPECT_NE(source.find("goto L0;"), std::string::npos);
+    EXPECT_NE(source.find("goto dispatch;"), std::string::npos);
+    EXPECT_NE(source.find("const AotProgram PROGRAM{BYTE_CODE, Run};"), std::string::npos);
+    EXPECT_EQ(source.find("int main("), std::string::npos);
+
+    EXPECT_NE(AotTranslator::Translate(byte_code).find("int main("), std::string::npos);
+    EXPECT_THROW(static_cast<void>(AotTranslator::Translate(byte_code, "not a name")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(AotTranslator::Translate(snm::ByteCode(3))), std::invalid_argument);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "core/assembler.hpp"
+#include "core/batch_runner.hpp"
+
+namespace {
+    const std::string SQUARE = R"(
+        n: 0
+        Input
+        Store n
+        Mul & n
+        Output
+    )";
+}
+
+TEST(BatchRunnerTest, Run) {
+    Assembler assembler{};
+    const snm::ByteCode byte_code = assembler.Compile(SQUARE);
+
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 100; ++i) {
+        inputs.push_back(std::to_string(i - 50));
+    }
+    inputs.emplace_back("");
+
+    for (const auto mode : {snm::ExecutionMode::THREADED, snm::ExecutionMode::REFERENCE}) {
+        BatchRunner runner(4);
+        runner.SetExecutionMode(mode);
+        const std::vector<BatchResult> results = runner.Run(byte_code, inputs);
+
+        ASSERT_EQ(results.size(), inputs.size());
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_EQ(results[i].output, std::to_string((i - 50) * (i - 50)));
+            EXPECT_EQ(static_cast<snm::SignedWord>(results[i].registers.accumulator), (i - 50) * (i - 50));
+            EXPECT_EQ(results[i].instruction_count, 5);
+            EXPECT_TRUE(results[i].error.empty());
+        }
+
+        EXPECT_EQ(results.back().error, "Error: Unexpected end of input");
+        EXPECT_EQ(results.back().registers.instruction_pointer, 1);
+    }
+}
+
+TEST(BatchRunnerTest, InvalidByteCode) {
+    const BatchRunner runner(2);
+    EXPECT_EQ(runner.GetThreadCount(), 2);
+    EXPECT_TRUE(runner.Run(snm::ByteCode{}, {}).empty());
+    EXPECT_THROW(std::ignore = runner.Run(snm::ByteCode{0, 1}, {"1"}), std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "core/assembler.hpp"
+#include "core/batching_observer.hpp"
+#include "core/virtual_machine.hpp"
+
+#include "sample_programs.hpp"
+
+namespace {
+    using sample_programs::COUNTING_LOOP;
+
+    /**
+     * @brief Получатель, сохраняющий все пакеты и изменения IP.
+     */
+    class RecordingChangesObserver final : public ProcessorChangesObserver {
+    public:
+        std::vector<ProcessorChanges> batches;
+        std::vector<snm::Address> instruction_pointers;
+
+        void OnInstructionPointerChanged(const snm::Address& instruction_pointer) override {
+            instruction_pointers.push_back(instruction_pointer);
+        }
+
+        void OnChanges(const ProcessorChanges& changes) override {
+            batches.push_back(changes);
+        }
+    };
+}
+
+TEST(BatchingObserverTest, CoalescesChanges) {
+    RecordingChangesObserver target;
+    BatchingObserver observer(target, BatchingObserver::Clock::duration::zero(), 100);
+
+    for (int i = 0; i < 99; ++i) {
+        observer.OnMemoryChanged(static_cast<snm::Address>(10 - i % 3));
+        observer.OnRegisterAccChanged(snm::Bytes(i));
+        observer.OnRegisterIpChanged(static_cast<snm::Address>(i));
+    }
+    EXPECT_TRUE(target.batches.empty());
+    EXPECT_EQ(target.instruction_pointers.size(), 99);
+
+    observer.OnRegisterIpChanged(99);
+    ASSERT_EQ(target.batches.size(), 1);
+
+    const ProcessorChanges& batch = target.batches.front();
+    EXPECT_TRUE(batch.accumulator);
+    EXPECT_FALSE(batch.auxiliary);
+    EXPECT_TRUE(batch.instruction_pointer);
+    EXPECT_FALSE(batch.state.has_value());
+    EXPECT_EQ(static_cast<int>(batch.registers.accumulator), 98);
+    EXPECT_EQ(batch.registers.instruction_pointer, 99);
+    EXPECT_EQ(batch.instructions, 100);
+    EXPECT_EQ(batch.memory, (std::vector<snm::Address>{8, 9, 10}));
+
+    observer.Flush();
+    EXPECT_EQ(target.batches.size(), 1);
+
+    observer.OnMemoryChanged(9);
+    observer.OnStateChanged(snm::ProcessorState::STOPPED);
+    ASSERT_EQ(target.batches.size(), 2);
+    EXPECT_EQ(target.batches.back().memory, std::vector<snm::Address>{9});
+    EXPECT_EQ(target.batches.back().state, snm::ProcessorState::STOPPED);
+    EXPECT_FALSE(target.batches.back().accumulator);
+}
+
+TEST(BatchingObserverTest, RunProgram) {
+    RecordingChangesObserver target;
+    BatchingObserver observer(target, std::chrono::hours(1));
+
+    Assembler assembler{};
+    VirtualMachine virtual_machine;
+    virtual_machine.Load(assembler.Compile(COUNTING_LOOP));
+    // Граница цикла n увеличивается, чтобы пакет накопил изменения тысячи итераций
+    virtual_machine.WriteMemory(1, snm::Bytes(1000));
+    virtual_machine.SetProcessorObserver(&observer);
+    virtual_machine.Run();
+
+    ASSERT_EQ(target.batches.size(), 2);
+    EXPECT_EQ(target.batches.front().state, snm::ProcessorState::RUNNING);
+    EXPECT_EQ(target.batches.back().state, snm::ProcessorState::STOPPED);
+
+    uint64_t instructions = 0;
+    std::set<snm::Address> memory;
+    for (const ProcessorChanges& batch : target.batches) {
+        instructions += batch.instructions;
+        memory.insert(batch.memory.begin(), batch.memory.end());
+    }
+
+    EXPECT_EQ(instructions, target.instruction_pointers.size());
+    EXPECT_EQ(memory, std::set<snm::Address>{0});
+    EXPECT_EQ(target.batches.back().registers.instruction_pointer, virtual_machine.GetRegisters().instruction_pointer);
+    EXPECT_EQ(static_cast<snm::Word>(virtual_machine.ReadMemory(0)), 1000);
+}
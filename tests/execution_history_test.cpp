@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/execution_history.hpp"
+#include "core/processor.hpp"
+#include "core/stream_io.hpp"
+
+#include "sample_programs.hpp"
+
+namespace {
+    using sample_programs::LOOP;
+
+    /**
+     * @brief Состояние, восстанавливаемое обратным исполнением.
+     */
+    struct State {
+        snm::Word accumulator;
+        snm::Word auxiliary;
+        snm::Address instruction_pointer;
+        uint64_t instruction_count;
+        snm::Word counter;
+
+        bool operator==(const State&) const = default;
+    };
+
+    State Capture(const Processor& processor, const MemoryManager& memory) {
+        const Registers& registers = processor.GetRegisters();
+        return {static_cast<snm::Word>(registers.accumulator), static_cast<snm::Word>(registers.auxiliary),
+                registers.instruction_pointer, processor.GetInstructionCount(),
+                static_cast<snm::Word>(memory.ReadArgument(0))};
+    }
+
+    class ExecutionHistoryTest : public testing::Test, public testing::WithParamInterface<snm::ExecutionMode> {
+    protected:
+        Assembler assembler_{};
+        MemoryManager memory_;
+        Processor processor_{memory_};
+
+        void SetUp() override {
+            memory_.Load(assembler_.Compile(LOOP));
+            processor_.SetExecutionMode(GetParam());
+        }
+
+        /**
+         * @brief Исполняет программу без журнала с начала до заданного счётчика.
+         */
+        State RunReference(const uint64_t instruction_count) const {
+            MemoryManager reference_memory;
+            reference_memory.Load(memory_.GetImage());
+            Processor reference(reference_memory);
+            reference.RunFor(instruction_count);
+            return Capture(reference, reference_memory);
+        }
+    };
+}
+
+TEST_P(ExecutionHistoryTest, StepBack) {
+    ExecutionHistory history(1000, 4);
+    processor_.SetHistory(&history);
+    EXPECT_FALSE(processor_.StepBack());
+
+    std::vector<State> states{Capture(processor_, memory_)};
+    for (int i = 0; i < 30; ++i) {
+        processor_.Step();
+        states.push_back(Capture(processor_, memory_));
+    }
+    EXPECT_EQ(history.Size(), 30);
+    EXPECT_EQ(history.GetCheckpointCount(), 8);
+
+    for (size_t i = states.size() - 1; i > 0; --i) {
+        ASSERT_TRUE(processor_.StepBack());
+        EXPECT_EQ(Capture(processor_, memory_), states[i - 1]);
+        EXPECT_EQ(processor_.GetState(), snm::ProcessorState::PAUSED);
+    }
+    EXPECT_FALSE(processor_.StepBack());
+}
+
+TEST_P(ExecutionHistoryTest, RewindTo) {
+    ExecutionHistory history(ExecutionHistory::DEFAULT_CAPACITY, 64);
+    processor_.SetHistory(&history);
+    processor_.Run();
+
+    const State final_state = Capture(processor_, memory_);
+    EXPECT_EQ(final_state.counter, 1000);
+    EXPECT_EQ(history.Size(), final_state.instruction_count);
+    EXPECT_LE(history.GetCheckpointCount(), final_state.instruction_count / 64 + 1);
+
+    // Возврат восстанавливает ближайший снимок и отменяет оставшиеся записи
+    for (const uint64_t instruction_count : {4000, 3001, 3000, 2999, 10, 0}) {
+        ASSERT_TRUE(processor_.RewindTo(instruction_count));
+        EXPECT_EQ(Capture(processor_, memory_), RunReference(instruction_count));
+        EXPECT_EQ(history.GetEndInstructionCount(), instruction_count);
+    }
+    EXPECT_FALSE(processor_.RewindTo(1));
+
+    // Журнал продолжается с восстановленного состояния
+    processor_.Run();
+    EXPECT_EQ(Capture(processor_, memory_), final_state);
+    EXPECT_EQ(history.Size(), final_state.instruction_count);
+    EXPECT_TRUE(processor_.RewindTo(2500));
+    EXPECT_EQ(Capture(processor_, memory_), RunReference(2500));
+
+    processor_.Reset();
+    EXPECT_EQ(history.Size(), 0);
+}
+
+TEST_P(ExecutionHistoryTest, Capacity) {
+    ExecutionHistory history(100, 16);
+    processor_.SetHistory(&history);
+    processor_.RunFor(5000);
+
+    EXPECT_EQ(history.Size(), 100);
+    EXPECT_EQ(history.GetFirstInstructionCount(), 4900);
+    EXPECT_LE(history.GetCheckpointCount(), 100 / 16 + 1);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(processor_.StepBack());
+    }
+    EXPECT_FALSE(processor_.StepBack());
+    EXPECT_EQ(Capture(processor_, memory_), RunReference(4900));
+
+    history.SetCapacity(10);
+    processor_.RunFor(50);
+    EXPECT_EQ(history.Size(), 10);
+    ASSERT_TRUE(processor_.RewindTo(4940));
+    EXPECT_EQ(Capture(processor_, memory_), RunReference(4940));
+}
+
+TEST_P(ExecutionHistoryTest, ReverseContinue) {
+    ExecutionHistory history;
+    processor_.SetHistory(&history);
+    processor_.SetBreakpoint(3);
+    processor_.SetBreakpointsEnabled(true);
+
+    for (const uint64_t instruction_count : {3, 8, 13}) {
+        processor_.Run();
+        EXPECT_EQ(processor_.GetState(), snm::ProcessorState::BREAKPOINT);
+        EXPECT_EQ(processor_.GetInstructionCount(), instruction_count);
+    }
+
+    for (const uint64_t instruction_count : {8, 3}) {
+        EXPECT_TRUE(processor_.ReverseContinue());
+        EXPECT_EQ(processor_.GetState(), snm::ProcessorState::BREAKPOINT);
+        EXPECT_EQ(Capture(processor_, memory_), RunReference(instruction_count));
+    }
+
+    EXPECT_FALSE(processor_.ReverseContinue());
+    EXPECT_EQ(processor_.GetState(), snm::ProcessorState::PAUSED);
+    EXPECT_EQ(Capture(processor_, memory_), RunReference(0));
+
+    // Исполнение вперёд после возврата снова останавливается на точке останова
+    processor_.Run();
+    EXPECT_EQ(processor_.GetInstructionCount(), 3);
+}
+
+TEST_P(ExecutionHistoryTest, Call) {
+    memory_.Load(assembler_.Compile(R"(
+        Load 3
+        JnS Twice
+        JnS Twice
+        Store 30
+        Halt
+        Twice: 0
+            Store 31
+            Add & 31
+            Jump & Twice
+    )"));
+    const MemorySnapshot initial = memory_.TakeSnapshot();
+
+    ExecutionHistory history(ExecutionHistory::DEFAULT_CAPACITY, 4);
+    processor_.SetHistory(&history);
+    processor_.Run();
+    EXPECT_EQ(static_cast<snm::Word>(memory_.ReadArgument(30)), 12);
+
+    // Отмена вызова подпрограммы восстанавливает ячейку адреса возврата
+    for (uint64_t instruction_count = processor_.GetInstructionCount(); instruction_count-- > 0;) {
+        ASSERT_TRUE(processor_.RewindTo(instruction_count));
+        EXPECT_EQ(Capture(processor_, memory_), RunReference(instruction_count));
+    }
+    EXPECT_TRUE(memory_.TakeSnapshot().Diff(initial).empty());
+}
+
+TEST_P(ExecutionHistoryTest, Input) {
+    memory_.Load(assembler_.Compile(R"(
+        Input
+        Store 10
+        Output
+        Halt
+    )"));
+
+    std::istringstream input("7 9");
+    std::ostringstream output;
+    StreamIo io(input, output);
+    processor_.SetIo(&io);
+
+    ExecutionHistory history;
+    processor_.SetHistory(&history);
+    processor_.Step();
+    processor_.Step();
+    EXPECT_EQ(static_cast<snm::Word>(memory_.ReadArgument(10)), 7);
+
+    // Отменённая инструкция ввода запрашивает значение повторно
+    ASSERT_TRUE(processor_.StepBack());
+    ASSERT_TRUE(processor_.StepBack());
+    EXPECT_EQ(processor_.GetInstructionCount(), 0);
+    EXPECT_EQ(static_cast<snm::Word>(memory_.ReadArgument(10)), 0);
+
+    processor_.Run();
+    io.Flush();
+    EXPECT_EQ(static_cast<snm::Word>(memory_.ReadArgument(10)), 9);
+    EXPECT_EQ(output.str(), "9");
+    EXPECT_EQ(processor_.GetInstructionCount(), 4);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ExecutionHistory,
+    ExecutionHistoryTest,
+    ::testing::Values(
+        snm::ExecutionMode::REFERENCE,
+        snm::ExecutionMode::THREADED,
+        snm::ExecutionMode::FUSED,
+        snm::ExecutionMode::JIT
+    ),
+    [](const testing::TestParamInfo<snm::ExecutionMode>& info) {
+    switch (info.param) {
+    case snm::ExecutionMode::REFERENCE:
+        return "REFERENCE";
+    case snm::ExecutionMode::THREADED:
+        return "THREADED";
+    case snm::ExecutionMode::FUSED:
+        return "FUSED";
+    default:
+        return "JIT";
+    }
+});
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/input_feed_io.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+TEST(InputFeedIoTest, Parse) {
+    std::istringstream text("17 -3 2.5 # comment 99\n\n  1e2\t0\n");
+    const auto values = InputFeedIo::Parse(text);
+
+    ASSERT_EQ(values.size(), 5);
+    EXPECT_EQ(values[0].type, snm::Type::WORD);
+    EXPECT_EQ(static_cast<snm::Word>(values[0].bytes), 17);
+    EXPECT_EQ(values[1].type, snm::Type::SIGNED_WORD);
+    EXPECT_EQ(static_cast<snm::SignedWord>(values[1].bytes), -3);
+    EXPECT_EQ(values[2].type, snm::Type::REAL);
+    EXPECT_EQ(static_cast<snm::Real>(values[2].bytes), 2.5f);
+    EXPECT_EQ(static_cast<snm::Real>(values[3].bytes), 100.0f);
+    EXPECT_EQ(static_cast<snm::Word>(values[4].bytes), 0);
+
+    for (const std::string invalid : {"abc", "12x", "4294967296", "1.2.3"}) {
+        std::istringstream stream(invalid);
+        EXPECT_THROW(static_cast<void>(InputFeedIo::Parse(stream)), std::runtime_error) << invalid;
+    }
+}
+
+TEST(InputFeedIoTest, Convert) {
+    std::istringstream fallback_input;
+    std::ostringstream output;
+    StreamIo stream_io(fallback_input, output);
+
+    // Значение другого типа разбирается так же, как при вводе с консоли
+    const std::vector<std::pair<std::string, snm::Type>> requests{
+        {"1e30", snm::Type::WORD}, {"1e30", snm::Type::SIGNED_WORD}, {"-2.5", snm::Type::BYTE},
+        {"-7", snm::Type::WORD}, {"-7", snm::Type::REAL}, {"300", snm::Type::BYTE}, {"2.5", snm::Type::REAL}
+    };
+    for (const auto& [token, type] : requests) {
+        std::istringstream text(token);
+        InputFeedIo io(InputFeedIo::Parse(text), stream_io);
+
+        snm::Bytes bytes;
+        io.InputRequest(type, [&bytes](const snm::Bytes value) {
+            bytes = value;
+        });
+        EXPECT_EQ(static_cast<snm::Word>(bytes), static_cast<snm::Word>(VirtualMachine::BytesFromString(token, type)))
+            << token;
+    }
+
+    std::istringstream text("3000000000");
+    InputFeedIo io(InputFeedIo::Parse(text), stream_io);
+    EXPECT_THROW(io.InputRequest(snm::Type::SIGNED_WORD, [](snm::Bytes) {}), std::runtime_error);
+}
+
+TEST(InputFeedIoTest, Run) {
+    const std::string source = R"(
+        Input W
+        Output W
+        Input SW
+        Output SW
+        Input R
+        Mul R 2.0
+        Output R
+        Input C
+        Output C
+        Input W
+        Output W
+    )";
+
+    std::istringstream text("7 -2 3 65");
+    std::istringstream fallback_input("11");
+    std::ostringstream output;
+    StreamIo stream_io(fallback_input, output);
+    InputFeedIo io(InputFeedIo::Parse(text), stream_io);
+
+    Assembler assembler;
+    VirtualMachine virtual_machine(&io);
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        io.Rewind();
+        fallback_input.clear();
+        fallback_input.seekg(0);
+        output.str("");
+        virtual_machine.Reset();
+        virtual_machine.Load(assembler.Compile(source));
+        virtual_machine.SetExecutionMode(mode);
+
+        // Ввод из заранее разобранных значений не останавливает исполнение
+        EXPECT_EQ(virtual_machine.RunFor(100), snm::StopReason::HALTED);
+        stream_io.Flush();
+        EXPECT_EQ(output.str(), "7-26.000000A11");
+        EXPECT_EQ(io.GetRemaining(), 0);
+    }
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/io_log_file.hpp"
+#include "core/recording_io.hpp"
+#include "core/replay_io.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+namespace {
+    const std::string SOURCE = R"(
+        n: 0
+        i: 0
+        Input
+        Store n
+        Loop: Load & i
+            Add 1
+            Store i
+            Output
+            SkipEq & n
+            Jump Loop
+        Halt
+    )";
+
+    struct Event {
+        IoEvent::Kind kind;
+        snm::Type type;
+        snm::Word value;
+        uint64_t instruction_count;
+
+        bool operator==(const Event&) const = default;
+    };
+
+    std::vector<Event> Convert(const std::vector<IoEvent>& events) {
+        std::vector<Event> result;
+        for (const IoEvent& event : events) {
+            result.push_back({event.kind, event.type, static_cast<snm::Word>(event.bytes), event.instruction_count});
+        }
+        return result;
+    }
+
+    class IoRecordingTest : public testing::Test {
+    protected:
+        Assembler assembler_{};
+        snm::ByteCode program_ = assembler_.Compile(SOURCE);
+
+        /**
+         * @brief Исполняет программу с воспроизведением записи.
+         * @return Вывод программы.
+         */
+        static std::string Replay(const snm::ByteCode& byte_code, const std::vector<IoEvent>& events,
+                                  const snm::ExecutionMode mode = snm::ExecutionMode::THREADED) {
+            std::istringstream input;
+            std::ostringstream output;
+            StreamIo io(input, output);
+
+            VirtualMachine virtual_machine;
+            ReplayIo replay(events, io, [&virtual_machine] { return virtual_machine.GetInstructionCount(); });
+            virtual_machine.SetProcessorIo(&replay);
+            virtual_machine.SetExecutionMode(mode);
+            virtual_machine.Load(byte_code);
+            virtual_machine.Run();
+            replay.Finish();
+            io.Flush();
+
+            return output.str();
+        }
+    };
+}
+
+TEST_F(IoRecordingTest, RecordAndReplay) {
+    std::istringstream input("3");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    VirtualMachine virtual_machine;
+    RecordingIo recording(io, [&virtual_machine] { return virtual_machine.GetInstructionCount(); });
+    virtual_machine.SetProcessorIo(&recording);
+    virtual_machine.Load(program_);
+    virtual_machine.Run();
+    io.Flush();
+
+    EXPECT_EQ(output.str(), "123");
+    EXPECT_EQ(Convert(recording.GetEvents()), (std::vector<Event>{
+                  {IoEvent::Kind::INPUT, snm::Type::SIGNED_WORD, 3, 3},
+                  {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, 1, 8},
+                  {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, 2, 14},
+                  {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, 3, 20}
+                  }));
+
+    // Воспроизведение не читает ввод и совпадает во всех режимах исполнения
+    for (const snm::ExecutionMode mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED,
+                                          snm::ExecutionMode::FUSED, snm::ExecutionMode::JIT}) {
+        EXPECT_EQ(Replay(program_, recording.GetEvents(), mode), "123");
+    }
+
+    recording.Clear();
+    EXPECT_TRUE(recording.GetEvents().empty());
+}
+
+TEST_F(IoRecordingTest, Mismatch) {
+    const std::vector<IoEvent> events{
+        {IoEvent::Kind::INPUT, snm::Type::SIGNED_WORD, snm::Bytes(2), 3},
+        {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, snm::Bytes(1), 8},
+        {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, snm::Bytes(2), 14}
+    };
+    EXPECT_EQ(Replay(program_, events), "12");
+
+    // Другое значение вывода
+    std::vector<IoEvent> changed = events;
+    changed[2].bytes = snm::Bytes(5);
+    EXPECT_THROW(Replay(program_, changed), std::runtime_error);
+
+    // Другой счётчик инструкций
+    changed = events;
+    changed[1].instruction_count = 9;
+    EXPECT_THROW(Replay(program_, changed), std::runtime_error);
+
+    // Программа выводит больше, чем записано
+    changed = events;
+    changed[0].bytes = snm::Bytes(3);
+    EXPECT_THROW(Replay(program_, changed), std::runtime_error);
+
+    // Программа завершается раньше записи
+    changed = events;
+    changed.push_back({IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, snm::Bytes(3), 20});
+    EXPECT_THROW(Replay(program_, changed), std::runtime_error);
+
+    // Ввод другого типа
+    changed = events;
+    changed[0].type = snm::Type::REAL;
+    EXPECT_THROW(Replay(program_, changed), std::runtime_error);
+
+    // Без источника счётчика сверяются только значения
+    std::istringstream input;
+    std::ostringstream output;
+    StreamIo io(input, output);
+    changed = events;
+    changed[1].instruction_count = 7;
+    changed[2].instruction_count = 7;
+    ReplayIo replay(changed, io);
+
+    VirtualMachine virtual_machine(&replay);
+    virtual_machine.Load(program_);
+    virtual_machine.Run();
+    EXPECT_EQ(replay.GetRemaining(), 0);
+    EXPECT_NO_THROW(replay.Finish());
+
+    replay.Rewind();
+    EXPECT_EQ(replay.GetRemaining(), 3);
+}
+
+TEST_F(IoRecordingTest, File) {
+    const std::vector<IoEvent> events{
+        {IoEvent::Kind::INPUT, snm::Type::REAL, snm::Bytes(1.5f), 1},
+        {IoEvent::Kind::OUTPUT, snm::Type::SIGNED_WORD, snm::Bytes(static_cast<snm::SignedWord>(-7)), 100},
+        {IoEvent::Kind::OUTPUT, snm::Type::BYTE, snm::Bytes('A'), 100},
+        {IoEvent::Kind::INPUT, snm::Type::WORD, snm::Bytes(42), 5'000'000'000}
+    };
+
+    // Событие занимает байт заголовка, значение и приращение счётчика
+    const snm::ByteCode data = IoLogFile::Serialize(events);
+    EXPECT_EQ(data.size(), 12 + 4 * 5 + 1 + 1 + 1 + 5);
+
+    const auto check = [&events](const std::vector<IoEvent>& restored) {
+        ASSERT_EQ(restored.size(), events.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            EXPECT_EQ(restored[i].kind, events[i].kind);
+            EXPECT_EQ(restored[i].type, events[i].type);
+            EXPECT_EQ(static_cast<snm::Word>(restored[i].bytes), static_cast<snm::Word>(events[i].bytes));
+            EXPECT_EQ(restored[i].instruction_count, events[i].instruction_count);
+        }
+    };
+    check(IoLogFile::Deserialize(data));
+    EXPECT_TRUE(IoLogFile::Deserialize(IoLogFile::Serialize({})).empty());
+
+    const std::string path = testing::TempDir() + "io_recording_test" + std::string(IoLogFile::EXTENSION);
+    IoLogFile::Write(path, events);
+    check(IoLogFile::Read(path));
+    std::filesystem::remove(path);
+
+    snm::ByteCode corrupted = data;
+    corrupted[4] = 0xFF;
+    EXPECT_THROW((void)IoLogFile::Deserialize(corrupted), std::invalid_argument);
+    corrupted = data;
+    corrupted.pop_back();
+    EXPECT_THROW((void)IoLogFile::Deserialize(corrupted), std::invalid_argument);
+    corrupted = data;
+    corrupted.push_back(0);
+    EXPECT_THROW((void)IoLogFile::Deserialize(corrupted), std::invalid_argument);
+    corrupted = data;
+    corrupted[12] = 0x40;
+    EXPECT_THROW((void)IoLogFile::Deserialize(corrupted), std::invalid_argument);
+    EXPECT_THROW((void)IoLogFile::Deserialize(program_), std::invalid_argument);
+
+    std::vector<IoEvent> unordered = events;
+    std::swap(unordered[0], unordered[1]);
+    EXPECT_THROW((void)IoLogFile::Serialize(unordered), std::invalid_argument);
+}
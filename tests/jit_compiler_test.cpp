@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "core/assembler.hpp"
+#include "core/jit_compiler.hpp"
+#include "core/processor.hpp"
+
+#include "sample_programs.hpp"
+
+class JitCompilerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (!JitCompiler::IsSupported()) {
+            GTEST_SKIP() << "JIT is not supported on this platform";
+        }
+    }
+
+    Assembler assembler_{};
+    MemoryManager memory_;
+    std::atomic<bool> stop_requested_ = false;
+    std::atomic<bool> snapshot_requested_ = false;
+    JitCompiler compiler_{memory_, stop_requested_, snapshot_requested_};
+};
+
+TEST_F(JitCompilerTest, Loop) {
+    memory_.Load(assembler_.Compile(sample_programs::LOOP));
+
+    const JitCompiler::Block* block = compiler_.GetBlock(1);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->length, 5);
+    EXPECT_EQ(compiler_.GetBlock(6), nullptr);
+
+    Registers registers{};
+    registers.instruction_pointer = 1;
+    EXPECT_EQ(compiler_.Execute(*block, registers, 10000), 999 * 5 + 4);
+    EXPECT_EQ(registers.instruction_pointer, 6);
+    EXPECT_EQ(static_cast<snm::Word>(registers.accumulator), 1000);
+    EXPECT_EQ(static_cast<snm::Word>(memory_.ReadArgument(0)), 1000);
+    EXPECT_EQ(compiler_.GetTranslationCount(), 1);
+}
+
+TEST_F(JitCompilerTest, Budget) {
+    memory_.Load(assembler_.Compile(R"(
+        Loop: Add 1
+            Jump Loop
+    )"));
+
+    const JitCompiler::Block* block = compiler_.GetBlock(0);
+    ASSERT_NE(block, nullptr);
+
+    // Переход назад завершает участок, если следующий проход может превысить бюджет
+    Registers registers{};
+    const uint64_t executed = compiler_.Execute(*block, registers, 101);
+    EXPECT_LE(executed, 101);
+    EXPECT_GT(executed, 101 - block->length);
+    EXPECT_EQ(static_cast<snm::Word>(registers.accumulator), executed / 2);
+    EXPECT_EQ(registers.instruction_pointer, 0);
+
+    stop_requested_ = true;
+    EXPECT_EQ(compiler_.Execute(*block, registers, 1000), 2);
+}
+
+TEST_F(JitCompilerTest, InvalidateEmbeddedArgument) {
+    // Store изменяет аргумент инструкции того же участка, встроенный в машинный код как константа
+    memory_.Load(assembler_.Compile(R"(
+        Load 5
+        Store Step
+        Load 0
+        Step: Add 1
+        Halt
+    )"));
+
+    const JitCompiler::Block* block = compiler_.GetBlock(0);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->length, 4);
+
+    Registers registers{};
+    EXPECT_EQ(compiler_.Execute(*block, registers, 100), 2);
+    EXPECT_EQ(registers.instruction_pointer, 2);
+
+    block = compiler_.GetBlock(2);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(compiler_.GetInvalidationCount(), 1);
+    EXPECT_EQ(compiler_.Execute(*block, registers, 100), 2);
+    EXPECT_EQ(static_cast<snm::Word>(registers.accumulator), 5);
+
+    // Записанная ячейка больше не встраивается, поэтому повторная запись не снимает участок
+    registers = {};
+    block = compiler_.GetBlock(0);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(compiler_.Execute(*block, registers, 100), 4);
+    EXPECT_EQ(static_cast<snm::Word>(registers.accumulator), 5);
+    EXPECT_EQ(compiler_.GetInvalidationCount(), 1);
+}
+
+TEST_F(JitCompilerTest, WriteInstruction) {
+    memory_.Load(assembler_.Compile("Load 1\nAdd 2\nHalt"));
+
+    const JitCompiler::Block* block = compiler_.GetBlock(0);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->length, 2);
+
+    // Запись инструкции снимает все участки
+    memory_.WriteInstruction(snm::InstructionByte(snm::OpCode::MUL, snm::TypeModifier::W), snm::Bytes(3), 1);
+    block = compiler_.GetBlock(0);
+    ASSERT_NE(block, nullptr);
+
+    Registers registers{};
+    EXPECT_EQ(compiler_.Execute(*block, registers, 100), 2);
+    EXPECT_EQ(static_cast<snm::Word>(registers.accumulator), 3);
+    EXPECT_EQ(compiler_.GetTranslationCount(), 2);
+}
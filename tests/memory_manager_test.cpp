@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "core/memory_manager.hpp"
+
+TEST(MemoryManagerTest, EndOfCode) {
+    MemoryManager memory;
+    EXPECT_EQ(memory.Size(), 0);
+    EXPECT_EQ(memory.ReadInstruction(0).first, snm::END_OF_CODE);
+    EXPECT_EQ(memory.ReadInstruction(snm::CODE_MEMORY_SIZE - 1).first, snm::END_OF_CODE);
+
+    memory.WriteInstruction(snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W), snm::Bytes(7));
+    memory.WriteInstruction(snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C), snm::Bytes(0), 3);
+    EXPECT_EQ(memory.Size(), 4);
+    EXPECT_EQ(memory.ReadInstruction(0).first, snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W));
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadInstruction(0).second), 7);
+    EXPECT_EQ(memory.ReadInstruction(1).first, static_cast<snm::Byte>(snm::OpCode::NOPE));
+    EXPECT_EQ(memory.ReadInstruction(3).first, std::numeric_limits<snm::Byte>::max());
+    EXPECT_EQ(memory.ReadInstruction(4).first, snm::END_OF_CODE);
+
+    memory.Reset();
+    EXPECT_EQ(memory.Size(), 0);
+    EXPECT_EQ(memory.ReadInstruction(0).first, snm::END_OF_CODE);
+}
+
+TEST(MemoryManagerTest, ResetData) {
+    MemoryManager memory;
+    memory.Load({
+        snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), 5, 0, 0, 0,
+        snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C), 0, 0, 0, 0,
+    });
+    ASSERT_EQ(memory.Size(), 2);
+
+    memory.WriteArgument(snm::Bytes(10), 0);
+    memory.WriteArgument(snm::Bytes(20), 1000);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(1000)), 20);
+    EXPECT_EQ(memory.ReadInstruction(1000).first, snm::END_OF_CODE);
+    EXPECT_EQ(memory.Size(), 2);
+
+    memory.ResetData();
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 5);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(1000)), 0);
+
+    memory.WriteInstruction(snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), snm::Bytes(30), 300);
+    memory.WriteArgument(snm::Bytes(40), 300);
+    memory.WriteArgument(snm::Bytes(50), 299);
+    memory.ResetData();
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(300)), 30);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(299)), 0);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 5);
+}
+
+TEST(MemoryManagerTest, SharedImage) {
+    const auto image = std::make_shared<const ProgramImage>(snm::ByteCode{
+        snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), 5, 0, 0, 0,
+        snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), 6, 0, 0, 0,
+    });
+
+    MemoryManager first;
+    MemoryManager second;
+    first.Load(image);
+    second.Load(image);
+    EXPECT_EQ(first.GetImage(), image);
+    EXPECT_EQ(first.Size(), 2);
+    EXPECT_EQ(first.GetPrivatePageCount(), 0);
+
+    first.WriteArgument(snm::Bytes(10), 0);
+    first.WriteArgument(snm::Bytes(20), 1);
+    first.WriteArgument(snm::Bytes(30), 5000);
+    EXPECT_EQ(first.GetPrivatePageCount(), 2);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(1)), 20);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(5000)), 30);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(0)), 5);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(5000)), 0);
+    EXPECT_EQ(static_cast<snm::Word>(image->GetCell(0).argument), 5);
+
+    first.ResetData();
+    EXPECT_EQ(first.GetPrivatePageCount(), 0);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(0)), 5);
+
+    // Запись инструкции не меняет разделяемый образ
+    second.WriteArgument(snm::Bytes(40), 1);
+    second.WriteInstruction(snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W), snm::Bytes(7), 3);
+    EXPECT_NE(second.GetImage(), image);
+    EXPECT_EQ(second.Size(), 4);
+    EXPECT_EQ(second.ReadInstruction(2).first, static_cast<snm::Byte>(snm::OpCode::NOPE));
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(1)), 40);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(3)), 7);
+    EXPECT_EQ(image->Size(), 2);
+    EXPECT_EQ(first.ReadInstruction(3).first, snm::END_OF_CODE);
+}
+
+TEST(MemoryManagerTest, Snapshot) {
+    MemoryManager memory;
+    memory.Load(snm::ByteCode{
+        snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), 5, 0, 0, 0,
+        snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W), 6, 0, 0, 0,
+    });
+    memory.WriteArgument(snm::Bytes(10), 0);
+    memory.WriteArgument(snm::Bytes(30), 5000);
+
+    const MemorySnapshot snapshot = memory.TakeSnapshot();
+    memory.WriteArgument(snm::Bytes(11), 0);
+    memory.WriteArgument(snm::Bytes(12), 1);
+    memory.WriteInstruction(snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C), snm::Bytes(0), 1);
+
+    // Снимок не меняется при последующих записях, в том числе в разделяемый с ним образ
+    EXPECT_EQ(static_cast<snm::Word>(snapshot.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(snapshot.ReadArgument(1)), 6);
+    EXPECT_EQ(static_cast<snm::Word>(snapshot.ReadArgument(5000)), 30);
+    EXPECT_EQ(snapshot.ReadInstruction(1).first, snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W));
+    EXPECT_EQ(snapshot.ReadInstruction(2).first, snm::END_OF_CODE);
+    EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 11);
+    EXPECT_EQ(memory.ReadInstruction(1).first, snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C));
+}
+
+TEST(MemoryManagerTest, Restore) {
+    MemoryManager memory;
+    memory.Load(snm::ByteCode{
+        snm::InstructionByte(snm::OpCode::NOPE, snm::TypeModifier::W), 5, 0, 0, 0,
+        snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W), 6, 0, 0, 0,
+    });
+    memory.WriteArgument(snm::Bytes(10), 0);
+    memory.WriteArgument(snm::Bytes(30), 5000);
+    const auto snapshot = std::make_shared<const MemorySnapshot>(memory.TakeSnapshot());
+    EXPECT_EQ(snapshot->GetWrittenCells(), (std::vector<snm::Address>{0, 5000}));
+
+    // Восстановленные менеджеры разделяют страницы снимка до первой записи
+    MemoryManager first;
+    MemoryManager second;
+    const size_t revision = first.CodeRevision();
+    first.Restore(snapshot);
+    second.Restore(snapshot);
+    EXPECT_GT(first.CodeRevision(), revision);
+    EXPECT_EQ(first.Size(), 2);
+    EXPECT_EQ(first.GetPrivatePageCount(), 0);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(5000)), 30);
+
+    first.WriteArgument(snm::Bytes(11), 1);
+    EXPECT_EQ(first.GetPrivatePageCount(), 1);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(1)), 11);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(1)), 6);
+    EXPECT_EQ(static_cast<snm::Word>(snapshot->ReadArgument(1)), 6);
+
+    // Снимок восстановленной памяти ссылается на неизменённые страницы восстановленного снимка
+    const MemorySnapshot forked = first.TakeSnapshot();
+    EXPECT_EQ(forked.Diff(*snapshot), (std::vector<snm::Address>{1}));
+    EXPECT_EQ(forked.GetWrittenCells(), (std::vector<snm::Address>{0, 1, 5000}));
+    EXPECT_TRUE(second.TakeSnapshot().Diff(*snapshot).empty());
+
+    // Запись инструкции сохраняет аргументы снимка
+    second.WriteInstruction(snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C), snm::Bytes(0), 1);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(0)), 10);
+    EXPECT_EQ(static_cast<snm::Word>(second.ReadArgument(5000)), 30);
+    EXPECT_EQ(second.ReadInstruction(1).first, snm::InstructionByte(snm::OpCode::HALT, snm::TypeModifier::C));
+    EXPECT_EQ(snapshot->ReadInstruction(1).first, snm::InstructionByte(snm::OpCode::LOAD, snm::TypeModifier::W));
+
+    // Сброс данных возвращает исходные аргументы образа, а не снимка
+    first.ResetData();
+    EXPECT_EQ(first.GetPrivatePageCount(), 0);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(0)), 5);
+    EXPECT_EQ(static_cast<snm::Word>(first.ReadArgument(5000)), 0);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "core/output_buffer.hpp"
+
+TEST(OutputBufferTest, Drain) {
+    OutputBuffer buffer;
+    std::string output = "stale";
+
+    EXPECT_FALSE(buffer.Drain(output));
+    EXPECT_TRUE(output.empty());
+
+    buffer.Write("Hello");
+    buffer.Write(", ");
+    buffer.Write("world");
+    EXPECT_TRUE(buffer.Drain(output));
+    EXPECT_EQ(output, "Hello, world");
+    EXPECT_FALSE(buffer.Drain(output));
+}
+
+TEST(OutputBufferTest, ConcurrentWriteAndDrain) {
+    constexpr int COUNT = 100000;
+
+    OutputBuffer buffer;
+    std::string expected;
+    for (int i = 0; i < COUNT; ++i) {
+        expected += static_cast<char>('a' + i % 26);
+    }
+
+    std::jthread writer([&buffer, &expected] {
+        for (const char c : expected) {
+            buffer.Write(std::string_view(&c, 1));
+        }
+    });
+
+    // Фрагменты, забранные во время записи, складываются в исходном порядке
+    std::string received;
+    std::string chunk;
+    while (received.size() < expected.size()) {
+        if (buffer.Drain(chunk)) {
+            received += chunk;
+        }
+    }
+
+    EXPECT_EQ(received, expected);
+}
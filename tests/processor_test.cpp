@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "core/processor.hpp"
+#include "core/processor_task.hpp"
 #include "core/assembler.hpp"
 
 class ProcessorTest : public testing::Test, public testing::WithParamInterface<snm::ArgModifier> {
@@ -572,4 +576,691 @@ TEST_F(ProcessorTest, Halt) {
     processor->Run();
     EXPECT_EQ(processor->IsRunning(), false);
     EXPECT_EQ(GetIP(), 0);
-}
\ No newline at end of file
+}
+
+/**
+ * Ввод-вывод, отвечающий на запросы ввода заранее заданными значениями и запоминающий вывод
+ */
+class ScriptedIo final : public ProcessorIo {
+public:
+    explicit ScriptedIo(std::vector<snm::Word> input = {}) :
+        input_(std::move(input)) {
+    }
+
+    void InputRequest(snm::Type, const InputCallback callback) override {
+        callback(snm::Bytes(input_.at(next_input_++)));
+    }
+
+    void OutputRequest(const snm::Bytes bytes, const snm::Type type) override {
+        output.emplace_back(static_cast<snm::Word>(bytes), type);
+    }
+
+    std::vector<std::pair<snm::Word, snm::Type>> output;
+
+private:
+    std::vector<snm::Word> input_;
+    size_t next_input_ = 0;
+};
+
+/**
+ * Ввод-вывод, передающий вводимые значения из отдельного потока после возврата из InputRequest.
+ * Если значения закончились, запрос остаётся без ответа.
+ */
+class AsyncIo final : public ProcessorIo {
+public:
+    explicit AsyncIo(std::vector<snm::Word> input = {}) :
+        input_(std::move(input)) {
+    }
+
+    void InputRequest(snm::Type, const InputCallback callback) override {
+        if (next_input_ < input_.size()) {
+            threads_.emplace_back([callback, value = input_[next_input_++]] {
+                callback(snm::Bytes(value));
+            });
+        }
+    }
+
+    void OutputRequest(const snm::Bytes bytes, const snm::Type) override {
+        output.push_back(static_cast<snm::Word>(bytes));
+    }
+
+    std::vector<snm::Word> output;
+
+private:
+    std::vector<snm::Word> input_;
+    size_t next_input_ = 0;
+    std::vector<std::jthread> threads_;
+};
+
+/**
+ * Ввод-вывод, запоминающий запрос ввода, на который тест отвечает позже вызовом Respond()
+ */
+class DeferredIo final : public ProcessorIo {
+public:
+    void InputRequest(snm::Type, const InputCallback callback) override {
+        callback_ = callback;
+    }
+
+    void OutputRequest(const snm::Bytes bytes, const snm::Type) override {
+        output.push_back(static_cast<snm::Word>(bytes));
+    }
+
+    void Respond(const snm::Word value) {
+        std::exchange(callback_, nullptr)(snm::Bytes(value));
+    }
+
+    [[nodiscard]] bool HasRequest() const {
+        return static_cast<bool>(callback_);
+    }
+
+    std::vector<snm::Word> output;
+
+private:
+    InputCallback callback_;
+};
+
+/**
+ * Наблюдатель, записывающий все уведомления процессора в порядке поступления
+ */
+class RecordingObserver final : public ProcessorObserver {
+public:
+    void OnRegisterIpChanged(const snm::Address& instruction_pointer) override {
+        events.push_back(std::format("ip {}", instruction_pointer));
+    }
+
+    void OnRegisterAccChanged(const snm::Bytes& accumulator) override {
+        events.push_back(std::format("acc {}", static_cast<snm::Word>(accumulator)));
+    }
+
+    void OnRegisterAuxChanged(const snm::Bytes& auxiliary) override {
+        events.push_back(std::format("aux {}", static_cast<snm::Word>(auxiliary)));
+    }
+
+    void OnMemoryChanged(const snm::Address& address) override {
+        events.push_back(std::format("memory {}", address));
+    }
+
+    void OnStateChanged(const snm::ProcessorState& state) override {
+        events.push_back(std::format("state {}", static_cast<int>(state)));
+    }
+
+    std::vector<std::string> events;
+};
+
+struct ExecutionResult {
+    snm::Word accumulator;
+    snm::Word auxiliary;
+    snm::Address instruction_pointer;
+    snm::ProcessorState state;
+    uint64_t instruction_count;
+    std::vector<std::pair<snm::Word, snm::Type>> output;
+    std::vector<snm::Word> memory;
+    std::vector<std::string> events;
+};
+
+class ExecutionModeTest : public testing::Test {
+public:
+    static ExecutionResult Execute(const std::string& source, const snm::ExecutionMode mode,
+                                   const std::vector<snm::Word>& input = {}, const bool observed = false) {
+        Assembler assembler{};
+        MemoryManager memory;
+        ScriptedIo io(input);
+        RecordingObserver observer;
+        Processor processor(memory, observed ? &observer : nullptr, &io);
+
+        memory.Load(assembler.Compile(source));
+        processor.SetExecutionMode(mode);
+        processor.Run();
+
+        ExecutionResult result{
+            static_cast<snm::Word>(processor.GetAccumulator()),
+            static_cast<snm::Word>(processor.GetAuxiliary()),
+            processor.GetInstructionPointer(),
+            processor.GetState(),
+            processor.GetInstructionCount(),
+            io.output,
+            {},
+            observer.events
+        };
+
+        for (size_t address = 0; address < snm::CODE_MEMORY_SIZE; ++address) {
+            result.memory.push_back(static_cast<snm::Word>(memory.ReadArgument(address)));
+        }
+
+        return result;
+    }
+
+    static void ExpectSameResult(const std::string& source, const std::vector<snm::Word>& input = {},
+                                 const bool observed = false) {
+        const auto reference = Execute(source, snm::ExecutionMode::REFERENCE, input, observed);
+
+        for (const auto mode : {snm::ExecutionMode::THREADED, snm::ExecutionMode::FUSED, snm::ExecutionMode::JIT}) {
+            SCOPED_TRACE(static_cast<int>(mode));
+            const auto threaded = Execute(source, mode, input, observed);
+
+            EXPECT_EQ(threaded.accumulator, reference.accumulator);
+            EXPECT_EQ(threaded.auxiliary, reference.auxiliary);
+            EXPECT_EQ(threaded.instruction_pointer, reference.instruction_pointer);
+            EXPECT_EQ(threaded.state, reference.state);
+            EXPECT_EQ(threaded.instruction_count, reference.instruction_count);
+            EXPECT_EQ(threaded.output, reference.output);
+            EXPECT_EQ(threaded.memory, reference.memory);
+            EXPECT_EQ(threaded.events, reference.events);
+        }
+    }
+};
+
+TEST_F(ExecutionModeTest, Factorial) {
+    const std::string source = R"(
+        StackPointer: 0xFF00
+        Load 10
+        JnS Push
+        JnS Factorial
+        Output W
+        Halt
+
+        Factorial:
+            Factorial_tmp0: 0
+            JnS Pop
+            JnS Push
+            Store Factorial_tmp0
+            Load & Factorial
+            JnS Push
+            Load & Factorial_tmp0
+            SkipLo W 2
+            Jump Factorial_N
+            Load 1
+            Jump Factorial_return
+            Factorial_N:
+                Sub W 1
+                JnS Push
+                JnS Factorial
+                Factorial_tmp2: 0
+                Store Factorial_tmp2
+                JnS Pop
+                Add W 1
+                Mul W & Factorial_tmp2
+            Factorial_return:
+            Factorial_tmp3: 0
+            Store Factorial_tmp3
+            JnS Pop
+            Store Factorial
+            Load & Factorial_tmp3
+            Jump & Factorial
+
+        Push:
+            Push_ACC_original: 0
+            Store & StackPointer
+            Store Push_ACC_original
+            Load & StackPointer
+            Add W 1
+            Store StackPointer
+            Load & Push_ACC_original
+            Jump & Push
+
+        Pop:
+            Load & StackPointer
+            Sub W 1
+            Store StackPointer
+            Load && StackPointer
+            Jump & Pop
+    )";
+
+    ExpectSameResult(source);
+    ExpectSameResult(source, {}, true);
+    EXPECT_EQ(Execute(source, snm::ExecutionMode::THREADED).output.front().first, 3628800);
+}
+
+TEST_F(ExecutionModeTest, ArithmeticAndBranches) {
+    const std::string source = R"(
+        a: 0
+        b: 0
+        r: 1.5
+        Input SW
+        Store a
+        Input SW
+        Store b
+        Load & a
+        SkipGt & b
+        Jump less
+        Sub & b
+        Mod SW 7
+        Output SW
+        Jump real
+        less:
+        Load & b
+        Div SW & a
+        Output SW
+        real:
+        Load R & r
+        Mul R 2.5
+        Add R 0.25
+        Output R
+        SkipEq R 4.0
+        Load C 'x'
+        Output C
+    )";
+
+    ExpectSameResult(source, {100, 7});
+    ExpectSameResult(source, {3, 1000});
+    ExpectSameResult(source, {100, 7}, true);
+}
+
+TEST_F(ExecutionModeTest, FusedSequences) {
+    // Первый проход входит в середину последовательности, а сама последовательность изменяет аргумент
+    // инструкции Step, входящей в другую последовательность
+    const std::string source = R"(
+        i: 0
+        sum: 0
+        Jump Step
+        Loop:
+            Load & i
+            SkipLo 100
+            Jump End
+            Load & i
+            Step: Add 1
+            Store i
+            Load & Step
+            Add 1
+            Store Step
+            Load & i
+            JnS Double
+            Output W
+            Jump Loop
+        Double: 0
+            Store sum
+            Add & sum
+            Store sum
+            Load & sum
+            Jump & Double
+        End:
+    )";
+
+    ExpectSameResult(source);
+    ExpectSameResult(source, {}, true);
+    EXPECT_EQ(Execute(source, snm::ExecutionMode::FUSED).output.back().first, 210);
+}
+
+TEST_F(ExecutionModeTest, Errors) {
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED, snm::ExecutionMode::JIT}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        processor.SetExecutionMode(mode);
+
+        memory.Load(assembler.Compile("Load 1\nDiv 0"));
+        EXPECT_THROW(processor.Run(), std::runtime_error);
+        EXPECT_EQ(processor.GetInstructionPointer(), 1);
+        EXPECT_EQ(processor.GetInstructionCount(), 2);
+
+        processor.Reset();
+        memory.Load(assembler.Compile("Load 1\nStore 0x10000"));
+        EXPECT_THROW(processor.Run(), std::out_of_range);
+
+        processor.Reset();
+        memory.Reset();
+        memory.WriteInstruction(snm::InstructionByte(snm::OpCode::JUMP, snm::TypeModifier::C), snm::Bytes(0));
+        EXPECT_THROW(processor.Run(), std::runtime_error);
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+    }
+}
+
+TEST_F(ExecutionModeTest, Breakpoints) {
+    const std::string source = R"(
+        i: 0
+        Loop:
+            Load & i
+            Add 1
+            Store i
+            SkipEq 3
+            Jump Loop
+    )";
+
+    Assembler assembler{};
+
+    for (const bool observed : {false, true}) {
+        for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED, snm::ExecutionMode::FUSED,
+                                snm::ExecutionMode::JIT}) {
+            MemoryManager memory;
+            RecordingObserver observer;
+            Processor processor(memory, observed ? &observer : nullptr);
+            processor.SetExecutionMode(mode);
+            memory.Load(assembler.Compile(source));
+
+            // Store i
+            processor.SetBreakpoint(4);
+            EXPECT_TRUE(processor.HasBreakpoint(4));
+
+            processor.Run();
+            EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+            EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 3);
+
+            memory.ResetData();
+            processor.Reset();
+            processor.SetBreakpointsEnabled(true);
+
+            for (snm::Word i = 1; i <= 3; ++i) {
+                processor.Run();
+                EXPECT_EQ(processor.GetState(), snm::ProcessorState::BREAKPOINT);
+                EXPECT_FALSE(processor.IsRunning());
+                EXPECT_EQ(processor.GetInstructionPointer(), 4);
+                EXPECT_EQ(static_cast<snm::Word>(processor.GetAccumulator()), i);
+                EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), i - 1);
+            }
+
+            processor.RemoveBreakpoint(4);
+            processor.Run();
+            EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+            EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 3);
+            EXPECT_EQ(processor.GetInstructionCount(), 18);
+        }
+    }
+}
+
+TEST_F(ExecutionModeTest, AsynchronousInput) {
+    const std::string source = R"(
+        sum: 0
+        Loop:
+            Input W
+            SkipGt W 0
+            Jump End
+            Add W & sum
+            Store sum
+            Jump Loop
+        End:
+        Load & sum
+        Output W
+    )";
+
+    Assembler assembler{};
+    std::vector<snm::Word> input(200, 3);
+    input.push_back(0);
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        // Разрушается раньше процессора, дожидаясь завершения потоков ввода
+        AsyncIo io(input);
+        processor.SetIo(&io);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile(source));
+
+        // Каждый ввод продолжает исполнение сразу, без опроса состояния с задержкой
+        const auto start = std::chrono::steady_clock::now();
+        processor.Run();
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+        ASSERT_EQ(io.output.size(), 1);
+        EXPECT_EQ(io.output.front(), 600);
+    }
+}
+
+TEST_F(ExecutionModeTest, StopWhileWaitingForInput) {
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        AsyncIo io;
+        processor.SetIo(&io);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile("Input\nOutput"));
+
+        std::jthread stopper([&processor] {
+            while (processor.GetState() != snm::ProcessorState::PAUSED_BY_IO) {
+                std::this_thread::yield();
+            }
+            processor.Stop();
+        });
+
+        processor.Run();
+        stopper.join();
+
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+        EXPECT_EQ(processor.GetInstructionPointer(), 0);
+        EXPECT_TRUE(io.output.empty());
+    }
+}
+
+TEST_F(ExecutionModeTest, StopConcurrentWithRun) {
+    Assembler assembler{};
+    const snm::ByteCode loop = assembler.Compile("Loop: Jump Loop");
+    const snm::ByteCode input = assembler.Compile("Input\nOutput");
+
+    // Программы завершаются только остановкой, поэтому потерянный запрос остановки приводит к зависанию.
+    // Остановка приходит в разные моменты: до запуска цикла, между запуском и переходом в RUNNING или в
+    // ожидание ввода, во время исполнения и во время ожидания.
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED, snm::ExecutionMode::FUSED,
+                            snm::ExecutionMode::JIT}) {
+        for (int i = 0; i < 24; ++i) {
+            MemoryManager memory;
+            Processor processor(memory);
+            AsyncIo io;
+            processor.SetIo(&io);
+            processor.SetExecutionMode(mode);
+            memory.Load(i % 2 == 0 ? loop : input);
+
+            std::jthread stopper([&processor, i] {
+                for (int delay = 0; delay < i / 4; ++delay) {
+                    std::this_thread::yield();
+                }
+                processor.Stop();
+            });
+
+            if (i % 4 < 2) {
+                processor.Run();
+            } else {
+                while (processor.RunFor(1000) != snm::StopReason::HALTED) {
+                }
+            }
+            stopper.join();
+
+            EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+            EXPECT_TRUE(io.output.empty());
+        }
+    }
+}
+
+TEST_F(ExecutionModeTest, RunForBudget) {
+    const std::string source = R"(
+        i: 0
+        Loop:
+            Load & i
+            Add 1
+            Store i
+            SkipEq 10
+            Jump Loop
+    )";
+
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED, snm::ExecutionMode::FUSED,
+                            snm::ExecutionMode::JIT}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile(source));
+
+        EXPECT_EQ(processor.RunFor(0), snm::StopReason::BUDGET_EXHAUSTED);
+        EXPECT_EQ(processor.GetInstructionCount(), 0);
+
+        uint64_t slices = 0;
+        snm::StopReason reason;
+        while ((reason = processor.RunFor(7)) == snm::StopReason::BUDGET_EXHAUSTED) {
+            EXPECT_EQ(processor.GetState(), snm::ProcessorState::PAUSED);
+            EXPECT_EQ(processor.GetInstructionCount(), ++slices * 7);
+        }
+
+        EXPECT_EQ(reason, snm::StopReason::HALTED);
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+        EXPECT_EQ(static_cast<snm::Word>(memory.ReadArgument(0)), 10);
+        EXPECT_EQ(processor.GetInstructionCount(), 60);
+        EXPECT_EQ(slices, 8);
+
+        // Бюджет заканчивается на инструкции, которая переводит IP за конец программы
+        MemoryManager exact_memory;
+        Processor exact(exact_memory);
+        exact.SetExecutionMode(mode);
+        exact_memory.Load(assembler.Compile(source));
+        EXPECT_EQ(exact.RunFor(59), snm::StopReason::BUDGET_EXHAUSTED);
+        EXPECT_EQ(exact.RunFor(1), snm::StopReason::HALTED);
+        EXPECT_EQ(exact.GetState(), snm::ProcessorState::STOPPED);
+
+        exact.Reset();
+        exact_memory.Load(assembler.Compile(source));
+        EXPECT_EQ(exact.RunFor(60), snm::StopReason::HALTED);
+        EXPECT_EQ(exact.GetState(), snm::ProcessorState::STOPPED);
+        EXPECT_EQ(exact.GetInstructionCount(), 60);
+    }
+}
+
+TEST_F(ExecutionModeTest, RunForInput) {
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        DeferredIo io;
+        processor.SetIo(&io);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile("Input W\nAdd W 1\nOutput W\nInput W\nOutput W"));
+
+        EXPECT_EQ(processor.Resume(), snm::StopReason::INPUT_NEEDED);
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::PAUSED_BY_IO);
+        EXPECT_EQ(processor.RunFor(100), snm::StopReason::INPUT_NEEDED);
+        ASSERT_TRUE(io.HasRequest());
+
+        // Значение сохраняется до следующего вызова и не изменяет регистры сразу
+        io.Respond(41);
+        EXPECT_EQ(processor.GetInstructionPointer(), 0);
+
+        EXPECT_EQ(processor.Resume(), snm::StopReason::INPUT_NEEDED);
+        EXPECT_EQ(processor.GetInstructionPointer(), 3);
+        io.Respond(7);
+
+        EXPECT_EQ(processor.Resume(), snm::StopReason::HALTED);
+        EXPECT_EQ(io.output, (std::vector<snm::Word>{42, 7}));
+
+        // Синхронный ввод применяется в том же вызове
+        processor.Reset();
+        ScriptedIo scripted({1, 2});
+        processor.SetIo(&scripted);
+        EXPECT_EQ(processor.Resume(), snm::StopReason::HALTED);
+        ASSERT_EQ(scripted.output.size(), 2);
+        EXPECT_EQ(scripted.output[0].first, 2);
+        EXPECT_EQ(scripted.output[1].first, 2);
+    }
+}
+
+TEST_F(ExecutionModeTest, RunForBreakpointAndError) {
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile("Load 1\nAdd 1\nDiv 0"));
+
+        processor.SetBreakpoint(1);
+        processor.SetBreakpointsEnabled(true);
+        EXPECT_EQ(processor.Resume(), snm::StopReason::BREAKPOINT);
+        EXPECT_EQ(processor.GetInstructionPointer(), 1);
+
+        EXPECT_EQ(processor.Resume(), snm::StopReason::EXECUTION_ERROR);
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+        EXPECT_EQ(processor.GetInstructionPointer(), 2);
+        EXPECT_FALSE(processor.GetLastError().empty());
+    }
+}
+
+TEST_F(ExecutionModeTest, RunSliced) {
+    Assembler assembler{};
+    MemoryManager memory;
+    Processor processor(memory);
+    DeferredIo io;
+    processor.SetIo(&io);
+    memory.Load(assembler.Compile("Load 5\nAdd 1\nAdd 1\nAdd 1\nInput W\nOutput W"));
+
+    std::vector<snm::StopReason> reasons;
+    for (ProcessorTask task = RunSliced(processor, 2); task.Next();) {
+        reasons.push_back(task.GetReason());
+        if (task.GetReason() == snm::StopReason::INPUT_NEEDED) {
+            io.Respond(9);
+        }
+    }
+
+    EXPECT_EQ(reasons, (std::vector<snm::StopReason>{
+                  snm::StopReason::BUDGET_EXHAUSTED,
+                  snm::StopReason::BUDGET_EXHAUSTED,
+                  snm::StopReason::INPUT_NEEDED,
+                  snm::StopReason::HALTED
+              }));
+    EXPECT_EQ(io.output, std::vector<snm::Word>{9});
+}
+
+TEST_F(ExecutionModeTest, StopBeforeRun) {
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile("Load 1\nAdd 1"));
+
+        // Остановка до того, как поток исполнения вызвал Run(), не теряется
+        processor.Stop();
+        processor.Run();
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+        EXPECT_EQ(processor.GetInstructionCount(), 0);
+
+        processor.Run();
+        EXPECT_EQ(static_cast<snm::Word>(processor.GetAccumulator()), 2);
+    }
+}
+
+TEST_F(ExecutionModeTest, SnapshotWhileRunning) {
+    const std::string source = R"(
+        i: 0
+        Loop:
+            Load & i
+            Add 1
+            Store i
+            Jump Loop
+    )";
+
+    Assembler assembler{};
+
+    for (const auto mode : {snm::ExecutionMode::REFERENCE, snm::ExecutionMode::THREADED}) {
+        MemoryManager memory;
+        Processor processor(memory);
+        processor.SetExecutionMode(mode);
+        memory.Load(assembler.Compile(source));
+
+        std::jthread runner([&processor] {
+            processor.Run();
+        });
+
+        uint64_t instruction_count = 0;
+        for (size_t fresh = 0; fresh < 100;) {
+            const auto snapshot = processor.GetSnapshot();
+            if (snapshot->instruction_count <= instruction_count) {
+                std::this_thread::yield();
+                continue;
+            }
+            ++fresh;
+            instruction_count = snapshot->instruction_count;
+
+            // Снимок делается между инструкциями: аккумулятор равен i или, после Add, i + 1
+            const auto accumulator = static_cast<snm::Word>(snapshot->registers.accumulator);
+            const auto counter = static_cast<snm::Word>(snapshot->memory.ReadArgument(0));
+            EXPECT_TRUE(accumulator == counter || accumulator == counter + 1);
+            EXPECT_EQ(snapshot->state, snm::ProcessorState::RUNNING);
+        }
+
+        processor.Stop();
+        runner.join();
+        EXPECT_EQ(processor.GetState(), snm::ProcessorState::STOPPED);
+    }
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/processor.hpp"
+#include "core/profiler.hpp"
+
+#include "sample_programs.hpp"
+
+namespace {
+    using sample_programs::COUNTING_LOOP;
+
+    class ProfilerTest : public testing::Test, public testing::WithParamInterface<snm::ExecutionMode> {
+    protected:
+        Assembler assembler_{};
+        MemoryManager memory_;
+        Processor processor_{memory_};
+        Profiler profiler_;
+        Program program_ = assembler_.CompileProgram(COUNTING_LOOP);
+
+        void SetUp() override {
+            memory_.Load(program_.byte_code);
+            processor_.SetExecutionMode(GetParam());
+            processor_.SetProfiler(&profiler_);
+        }
+    };
+}
+
+TEST_P(ProfilerTest, Counts) {
+    processor_.Run();
+
+    EXPECT_EQ(profiler_.GetInstructionCount(), processor_.GetInstructionCount());
+    EXPECT_EQ(profiler_.GetInstructionCount(), 77);
+
+    EXPECT_EQ(profiler_.GetAddressCount(3), 11);
+    EXPECT_EQ(profiler_.GetAddressCount(5), 1);
+    EXPECT_EQ(profiler_.GetAddressCount(7), 10);
+    EXPECT_EQ(profiler_.GetAddressCount(11), 0);
+
+    EXPECT_EQ(profiler_.GetOpCodeCount(snm::OpCode::LOAD), 21);
+    EXPECT_EQ(profiler_.GetOpCodeCount(snm::OpCode::JUMP), 11);
+    EXPECT_EQ(profiler_.GetOpCodeCount(snm::OpCode::NOPE), 14);
+    EXPECT_EQ(profiler_.GetTypeModifierCount(snm::TypeModifier::W), 21);
+    EXPECT_EQ(profiler_.GetTypeModifierCount(snm::TypeModifier::SW), 56);
+
+    const auto [taken, not_taken] = profiler_.GetBranchCounts(snm::OpCode::SKIP_LOWER);
+    EXPECT_EQ(taken, 10);
+    EXPECT_EQ(not_taken, 1);
+    EXPECT_EQ(profiler_.GetBranchCounts(4).taken, 10);
+
+    const auto lines = profiler_.GetLineCounts(program_.source_map);
+    EXPECT_EQ(lines.at(5), 11);
+    EXPECT_EQ(lines.at(7), 1);
+    EXPECT_FALSE(lines.contains(1));
+
+    profiler_.Reset();
+    EXPECT_EQ(profiler_.GetInstructionCount(), 0);
+}
+
+TEST_P(ProfilerTest, Export) {
+    processor_.Run();
+
+    std::ostringstream csv;
+    profiler_.WriteCsv(csv, program_.source_map);
+    EXPECT_TRUE(csv.str().starts_with("address,line,opcode,type,count,taken,not_taken\n"));
+    EXPECT_NE(csv.str().find("\n4,6,SKIPLO,SW,11,10,1\n"), std::string::npos);
+    EXPECT_NE(csv.str().find("\n5,7,JUMP,W,1,,\n"), std::string::npos);
+
+    std::ostringstream json;
+    profiler_.WriteJson(json, program_.source_map);
+    EXPECT_NE(json.str().find("\"instructions\": 77"), std::string::npos);
+    EXPECT_NE(json.str().find("\"SKIPLO\": {\"taken\": 10, \"not_taken\": 1}"), std::string::npos);
+    EXPECT_NE(json.str().find("{\"line\": 5, \"count\": 11}"), std::string::npos);
+
+    std::ostringstream stacks;
+    profiler_.WriteCollapsedStacks(stacks, program_.source_map, program_.labels);
+    EXPECT_NE(stacks.str().find("I;line 2 1\n"), std::string::npos);
+    EXPECT_NE(stacks.str().find("LOOP;line 5 11\n"), std::string::npos);
+    EXPECT_NE(stacks.str().find("END;line 12 1\n"), std::string::npos);
+}
+
+TEST_P(ProfilerTest, Fusions) {
+    processor_.Run();
+
+    const FusionCounts loop_test = profiler_.GetFusionCounts(snm::Fusion::LOOP_TEST);
+    const FusionCounts increment = profiler_.GetFusionCounts(snm::Fusion::INCREMENT);
+    EXPECT_EQ(profiler_.GetFusionCounts(snm::Fusion::CALL).hits, 0);
+
+    if (GetParam() != snm::ExecutionMode::FUSED) {
+        EXPECT_EQ(loop_test.hits, 0);
+        EXPECT_EQ(increment.hits, 0);
+        return;
+    }
+
+    // Сработавший пропуск завершает проверку цикла до перехода
+    EXPECT_EQ(loop_test.hits, 11);
+    EXPECT_EQ(loop_test.instructions, 23);
+    EXPECT_EQ(increment.hits, 10);
+    EXPECT_EQ(increment.instructions, 30);
+    EXPECT_EQ(increment.fallbacks, 0);
+
+    std::ostringstream json;
+    profiler_.WriteJson(json, program_.source_map);
+    EXPECT_NE(json.str().find("\"increment\": {\"hits\": 10, \"fallbacks\": 0, \"instructions\": 30, \"share\": 0.3896}"),
+              std::string::npos);
+
+    // Бюджет, пересекающий последовательность, исполняет её по одной инструкции
+    profiler_.Reset();
+    processor_.Reset();
+    memory_.ResetData();
+    EXPECT_EQ(processor_.RunFor(6), snm::StopReason::BUDGET_EXHAUSTED);
+    EXPECT_EQ(processor_.GetInstructionCount(), 6);
+    EXPECT_EQ(profiler_.GetFusionCounts(snm::Fusion::INCREMENT).fallbacks, 1);
+
+    profiler_.Reset();
+    EXPECT_EQ(profiler_.GetFusionCounts(snm::Fusion::LOOP_TEST).hits, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Profiler,
+    ProfilerTest,
+    ::testing::Values(
+        snm::ExecutionMode::REFERENCE,
+        snm::ExecutionMode::THREADED,
+        snm::ExecutionMode::FUSED
+    ),
+    [](const testing::TestParamInfo<snm::ExecutionMode>& info) {
+    switch (info.param) {
+    case snm::ExecutionMode::REFERENCE:
+        return "REFERENCE";
+    case snm::ExecutionMode::THREADED:
+        return "THREADED";
+    default:
+        return "FUSED";
+    }
+});
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/program_file.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+namespace {
+    const std::string SOURCE = R"(
+        A: 0
+        Input
+        Store A
+        Input
+        Add & A
+        Output
+        Jump End
+        End: Halt
+    )";
+
+    class ProgramFileTest : public testing::Test {
+    protected:
+        std::string path_ = testing::TempDir() + "program_file_test" + std::string(ProgramFile::EXTENSION);
+
+        void TearDown() override {
+            std::filesystem::remove(path_);
+        }
+
+        void WriteRaw(const snm::ByteCode& data) const {
+            std::ofstream file(path_, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+    };
+}
+
+TEST_F(ProgramFileTest, WriteAndLoad) {
+    Assembler assembler{};
+    const Program program = assembler.CompileProgram(SOURCE);
+    ProgramFile::Write(path_, program);
+
+    const ProgramFile file(path_);
+    EXPECT_TRUE(std::ranges::equal(file.GetByteCode(), program.byte_code));
+    EXPECT_EQ(file.GetLabels(), (snm::LabelMap{{"A", 0}, {"END", 7}}));
+    EXPECT_EQ(file.GetSourceMap(), program.source_map);
+    EXPECT_EQ(ProgramFile::Serialize(program), ProgramFile::Serialize(program));
+
+    std::istringstream input("40 2");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    VirtualMachine virtual_machine(&io);
+    virtual_machine.Load(file.GetByteCode());
+    virtual_machine.Run();
+    io.Flush();
+
+    EXPECT_EQ(output.str(), "42");
+}
+
+TEST_F(ProgramFileTest, InvalidFile) {
+    EXPECT_THROW(ProgramFile(path_ + ".missing"), std::runtime_error);
+
+    WriteRaw({});
+    EXPECT_THROW(ProgramFile{path_}, std::invalid_argument);
+
+    Assembler assembler{};
+    snm::ByteCode data = ProgramFile::Serialize(assembler.CompileProgram(SOURCE));
+
+    WriteRaw(snm::ByteCode(data.begin(), data.end() - 1));
+    EXPECT_THROW(ProgramFile{path_}, std::invalid_argument);
+
+    data[4] = ProgramFile::VERSION + 1;
+    WriteRaw(data);
+    EXPECT_THROW(ProgramFile{path_}, std::invalid_argument);
+
+    data[0] = 'X';
+    WriteRaw(data);
+    EXPECT_THROW(ProgramFile{path_}, std::invalid_argument);
+}
@@ -0,0 +1,43 @@
+#ifndef SAMPLE_PROGRAMS_HPP
+#define SAMPLE_PROGRAMS_HPP
+
+#include <string>
+
+/**
+ * @brief Программы, исполняемые в нескольких тестах.
+ */
+namespace sample_programs {
+    /**
+     * @brief Увеличивает ячейку i (адрес 0) до 1000 и останавливается по Halt. Тело цикла занимает адреса 1-5.
+     */
+    inline const std::string LOOP = R"(
+        i: 0
+        Loop: Load & i
+            Add 1
+            Store i
+            SkipEq 1000
+            Jump Loop
+        Halt
+    )";
+
+    /**
+     * @brief Увеличивает ячейку i (адрес 0) до значения ячейки n (адрес 1) и завершается выходом за конец кода.
+     *
+     * При n = 10 исполняется 77 инструкций.
+     */
+    inline const std::string COUNTING_LOOP = R"(
+        i: 0
+        n: 10
+        Loop:
+            Load & i
+            SkipLo & n
+            Jump End
+            Load & i
+            Add 1
+            Store i
+            Jump Loop
+        End:
+    )";
+}
+
+#endif // SAMPLE_PROGRAMS_HPP
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/snapshot_file.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+#include "sample_programs.hpp"
+
+namespace {
+    using sample_programs::LOOP;
+
+    const std::string SOURCE = R"(
+        A: 0
+        Input
+        Store A
+        Input
+        Add & A
+        Output
+        Halt
+    )";
+
+    /**
+     * @brief Обработчик, не отвечающий на запросы ввода.
+     */
+    class PendingIo final : public ProcessorIo {
+    public:
+        void InputRequest(snm::Type, InputCallback) override {
+        }
+
+        void OutputRequest(snm::Bytes, snm::Type) override {
+        }
+    };
+
+    class SnapshotFileTest : public testing::Test {
+    protected:
+        Assembler assembler_{};
+        snm::ByteCode program_ = assembler_.Compile(SOURCE);
+
+        /**
+         * @brief Восстанавливает снимок в новой машине и исполняет её до останова.
+         * @return Вывод программы.
+         */
+        std::string RunFork(const std::shared_ptr<const ProcessorSnapshot>& snapshot, const std::string& input,
+                            uint64_t& instruction_count) const {
+            std::istringstream input_stream(input);
+            std::ostringstream output;
+            StreamIo io(input_stream, output);
+
+            VirtualMachine fork(&io);
+            fork.Restore(snapshot);
+            fork.Run();
+            io.Flush();
+
+            instruction_count = fork.GetInstructionCount();
+            return output.str();
+        }
+    };
+}
+
+TEST_F(SnapshotFileTest, Fork) {
+    std::istringstream input("40");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    VirtualMachine virtual_machine(&io);
+    virtual_machine.Load(program_);
+    EXPECT_EQ(virtual_machine.RunFor(3), snm::StopReason::BUDGET_EXHAUSTED);
+    const auto checkpoint = virtual_machine.Snapshot();
+
+    uint64_t first_count = 0;
+    uint64_t second_count = 0;
+    EXPECT_EQ(RunFork(checkpoint, "2", first_count), "42");
+    EXPECT_EQ(RunFork(checkpoint, "5", second_count), "45");
+    EXPECT_EQ(first_count, 7);
+    EXPECT_EQ(second_count, 7);
+
+    // Запись в восстановленную машину не меняет снимок и другие машины
+    VirtualMachine fork;
+    fork.Restore(checkpoint);
+    fork.WriteMemory(0, snm::Bytes(100));
+    EXPECT_EQ(static_cast<snm::Word>(fork.ReadMemory(0)), 100);
+    EXPECT_EQ(static_cast<snm::Word>(checkpoint->memory.ReadArgument(0)), 40);
+    EXPECT_EQ(RunFork(checkpoint, "2", first_count), "42");
+    EXPECT_EQ(static_cast<snm::Word>(virtual_machine.ReadMemory(0)), 40);
+}
+
+TEST_F(SnapshotFileTest, RestoreWaitingForInput) {
+    PendingIo pending;
+    VirtualMachine virtual_machine(&pending);
+    virtual_machine.Load(program_);
+    EXPECT_EQ(virtual_machine.RunFor(100), snm::StopReason::INPUT_NEEDED);
+
+    const auto snapshot = virtual_machine.Snapshot();
+    EXPECT_EQ(snapshot->state, snm::ProcessorState::PAUSED_BY_IO);
+    EXPECT_EQ(snapshot->instruction_count, 2);
+
+    // Инструкция ввода повторяется и считается один раз
+    VirtualMachine fork;
+    fork.Restore(snapshot);
+    EXPECT_EQ(fork.GetState(), snm::ProcessorState::PAUSED);
+    EXPECT_EQ(fork.GetRegisters().instruction_pointer, 1);
+
+    uint64_t instruction_count = 0;
+    EXPECT_EQ(RunFork(snapshot, "40 2", instruction_count), "42");
+    EXPECT_EQ(instruction_count, 7);
+}
+
+TEST_F(SnapshotFileTest, SerializeAndDiff) {
+    std::istringstream input("40 2");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    VirtualMachine virtual_machine(&io);
+    virtual_machine.Load(program_);
+    const auto initial = virtual_machine.Snapshot();
+    virtual_machine.Run();
+    virtual_machine.WriteMemory(5000, snm::Bytes(7));
+    const auto snapshot = virtual_machine.Snapshot();
+
+    const SnapshotDiff diff = SnapshotDiff::Compare(*initial, *snapshot);
+    EXPECT_TRUE(diff.accumulator);
+    EXPECT_FALSE(diff.auxiliary);
+    EXPECT_TRUE(diff.instruction_pointer);
+    EXPECT_FALSE(diff.state);
+    EXPECT_TRUE(diff.instruction_count);
+    EXPECT_EQ(diff.cells, (std::vector<snm::Address>{0, 5000}));
+    EXPECT_TRUE(SnapshotDiff::Compare(*snapshot, *snapshot).Empty());
+
+    // Сохраняются образ и только изменённые ячейки
+    const snm::ByteCode data = SnapshotFile::Serialize(*snapshot);
+    EXPECT_EQ(data.size(), 36 + program_.size() + 2 * 6);
+
+    const auto restored = SnapshotFile::Deserialize(data);
+    EXPECT_TRUE(SnapshotDiff::Compare(*snapshot, *restored).Empty());
+    EXPECT_EQ(SnapshotFile::Serialize(*restored), data);
+
+    const std::string path = testing::TempDir() + "snapshot_file_test" + std::string(SnapshotFile::EXTENSION);
+    SnapshotFile::Write(path, *snapshot);
+    EXPECT_TRUE(SnapshotDiff::Compare(*snapshot, *SnapshotFile::Read(path)).Empty());
+    std::filesystem::remove(path);
+
+    VirtualMachine fork;
+    fork.Restore(restored);
+    EXPECT_EQ(static_cast<snm::Word>(fork.GetRegisters().accumulator), 42);
+    EXPECT_EQ(static_cast<snm::Word>(fork.ReadMemory(5000)), 7);
+    EXPECT_EQ(fork.GetInstructionCount(), 7);
+
+    snm::ByteCode corrupted = data;
+    corrupted[6] = 0xFF;
+    EXPECT_THROW((void)SnapshotFile::Deserialize(corrupted), std::invalid_argument);
+    corrupted = data;
+    corrupted.pop_back();
+    EXPECT_THROW((void)SnapshotFile::Deserialize(corrupted), std::invalid_argument);
+    EXPECT_THROW((void)SnapshotFile::Deserialize(program_), std::invalid_argument);
+}
+
+TEST_F(SnapshotFileTest, RestoreInvalidatesTranslatedCode) {
+    VirtualMachine reference;
+    reference.Load(assembler_.Compile(LOOP));
+    reference.SetExecutionMode(snm::ExecutionMode::REFERENCE);
+    EXPECT_EQ(reference.RunFor(500), snm::StopReason::BUDGET_EXHAUSTED);
+    const auto checkpoint = reference.Snapshot();
+
+    // Машина, уже исполнившая программу, восстанавливает снимок с изменённой памятью
+    reference.Restore(checkpoint);
+    reference.WriteMemory(0, snm::Bytes(900));
+    reference.Run();
+
+    for (const snm::ExecutionMode mode : {snm::ExecutionMode::THREADED, snm::ExecutionMode::FUSED,
+                                          snm::ExecutionMode::JIT}) {
+        VirtualMachine virtual_machine;
+        virtual_machine.Load(assembler_.Compile(LOOP));
+        virtual_machine.SetExecutionMode(mode);
+        virtual_machine.Run();
+
+        virtual_machine.Restore(checkpoint);
+        virtual_machine.WriteMemory(0, snm::Bytes(900));
+        virtual_machine.Run();
+
+        EXPECT_EQ(virtual_machine.GetInstructionCount(), reference.GetInstructionCount());
+        EXPECT_EQ(static_cast<snm::Word>(virtual_machine.ReadMemory(0)), 1000);
+        EXPECT_EQ(static_cast<snm::Word>(virtual_machine.GetRegisters().accumulator), 1000);
+    }
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "core/assembler.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+TEST(StreamIoTest, InputAndOutput) {
+    std::istringstream input("17 -3 2.5");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    snm::Bytes value;
+    io.InputRequest(snm::Type::WORD, [&value](const snm::Bytes bytes) { value = bytes; });
+    EXPECT_EQ(static_cast<snm::Word>(value), 17);
+    io.InputRequest(snm::Type::SIGNED_WORD, [&value](const snm::Bytes bytes) { value = bytes; });
+    EXPECT_EQ(static_cast<snm::SignedWord>(value), -3);
+    io.InputRequest(snm::Type::REAL, [&value](const snm::Bytes bytes) { value = bytes; });
+    EXPECT_EQ(static_cast<snm::Real>(value), 2.5f);
+
+    io.OutputRequest(snm::Bytes('O'), snm::Type::BYTE);
+    io.OutputRequest(snm::Bytes('K'), snm::Type::BYTE);
+    io.OutputRequest(snm::Bytes(-42), snm::Type::SIGNED_WORD);
+    EXPECT_TRUE(output.str().empty());
+
+    io.Flush();
+    EXPECT_EQ(output.str(), "OK-42");
+}
+
+TEST(StreamIoTest, InvalidInput) {
+    std::istringstream input("abc");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    const auto callback = [](snm::Bytes) {};
+    EXPECT_THROW(io.InputRequest(snm::Type::WORD, callback), std::runtime_error);
+    EXPECT_THROW(io.InputRequest(snm::Type::WORD, callback), std::runtime_error);
+}
+
+TEST(StreamIoTest, RunProgram) {
+    const std::string source = R"(
+        A: 0
+        Input
+        Store A
+        Input
+        Add & A
+        Output
+    )";
+
+    std::istringstream input("40 2");
+    std::ostringstream output;
+    StreamIo io(input, output);
+
+    Assembler assembler{};
+    VirtualMachine virtual_machine(&io);
+    virtual_machine.Load(assembler.Compile(source));
+    virtual_machine.Run();
+    io.Flush();
+
+    EXPECT_EQ(output.str(), "42");
+    EXPECT_EQ(virtual_machine.GetInstructionCount(), 6);
+}
@@ -0,0 +1,133 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "core/aot_translator.hpp"
+#include "core/assembler.hpp"
+#include "core/program_file.hpp"
+
+/**
+ * @brief Коды завершения sandm-aot.
+ */
+enum ExitCode {
+    SUCCESS = 0, ///< Программа оттранслирована
+    LOAD_ERROR = 2 ///< Неверные аргументы, ошибка чтения, трансляции или записи файла
+};
+
+/**
+ * @brief Параметры запуска, заданные в командной строке.
+ */
+struct Options {
+    std::string path; ///< Путь к исходному коду, байт-коду или файлу программы
+    std::string output; ///< Путь к файлу C++. Если пуст, результат пишется в stdout.
+    std::string name; ///< Имя переменной AotProgram. Если пусто, генерируется функция main.
+    bool bytecode = false; ///< Файл содержит байт-код, а не исходный код
+    bool help = false; ///< Вывести справку и завершиться
+};
+
+namespace {
+    void PrintUsage(std::ostream& stream) {
+        stream << "Usage: sandm-aot [options] <file>\n"
+            "\n"
+            "Translates a SANDM program to a self-contained C++ translation unit. The result is compiled\n"
+            "as C++20 and linked with the core library, which provides the runtime. Files with the .snmb\n"
+            "extension are loaded as assembled programs without assembling.\n"
+            "\n"
+            "Options:\n"
+            "  -b, --bytecode   <file> contains bytecode instead of source code\n"
+            "  -n, --name <identifier>\n"
+            "                   define `extern const AotProgram <identifier>` instead of main() so the\n"
+            "                   program can be run through AotRuntime from other code\n"
+            "  -o, --output <file>\n"
+            "                   write the translation unit to <file> instead of stdout\n"
+            "  -h, --help       show this help\n";
+    }
+
+    bool ParseOptions(const int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string argument = argv[i];
+
+            if (argument == "-b" || argument == "--bytecode") {
+                options.bytecode = true;
+            } else if (argument == "-n" || argument == "--name") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.name = argv[i];
+            } else if (argument == "-o" || argument == "--output") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.output = argv[i];
+            } else if (argument == "-h" || argument == "--help") {
+                options.help = true;
+                return true;
+            } else if (argument.starts_with("-") || !options.path.empty()) {
+                return false;
+            } else {
+                options.path = argument;
+            }
+        }
+
+        return !options.path.empty();
+    }
+
+    std::string ReadFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error(std::format("Cannot open file {}", path));
+        }
+
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    std::string Translate(const Options& options) {
+        if (!options.bytecode && options.path.ends_with(ProgramFile::EXTENSION)) {
+            const ProgramFile file(options.path);
+            return AotTranslator::Translate(file.GetByteCode(), options.name, file.GetLabels());
+        }
+
+        const std::string content = ReadFile(options.path);
+
+        if (options.bytecode) {
+            const snm::ByteCode byte_code(content.begin(), content.end());
+            return AotTranslator::Translate(byte_code, options.name);
+        }
+
+        Assembler assembler;
+        const Program program = assembler.CompileProgram(content);
+        return AotTranslator::Translate(program.byte_code, options.name, program.labels);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(std::cerr);
+        return LOAD_ERROR;
+    }
+
+    if (options.help) {
+        PrintUsage(std::cout);
+        return SUCCESS;
+    }
+
+    try {
+        const std::string source = Translate(options);
+
+        if (options.output.empty()) {
+            std::cout << source;
+        } else {
+            std::ofstream file(options.output, std::ios::binary);
+            if (!(file << source)) {
+                throw std::runtime_error(std::format("Cannot write file {}", options.output));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return LOAD_ERROR;
+    }
+
+    return SUCCESS;
+}
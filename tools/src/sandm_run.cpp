@@ -0,0 +1,311 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "core/assembler.hpp"
+#include "core/input_feed_io.hpp"
+#include "core/io_log_file.hpp"
+#include "core/profiler.hpp"
+#include "core/program_file.hpp"
+#include "core/recording_io.hpp"
+#include "core/replay_io.hpp"
+#include "core/stream_io.hpp"
+#include "core/virtual_machine.hpp"
+
+/**
+ * @brief Коды завершения sandm-run.
+ */
+enum ExitCode {
+    SUCCESS = 0, ///< Программа завершилась без ошибок
+    RUNTIME_ERROR = 1, ///< Ошибка во время выполнения программы
+    LOAD_ERROR = 2 ///< Неверные аргументы, ошибка чтения файла или трансляции
+};
+
+/**
+ * @brief Параметры запуска, заданные в командной строке.
+ */
+struct Options {
+    std::string path; ///< Путь к исходному коду, байт-коду или файлу программы
+    std::string output; ///< Путь к файлу программы, в который записывается результат трансляции
+    std::string profile; ///< Путь к файлу, в который записывается профиль исполнения
+    std::string input; ///< Путь к файлу входных значений. Если пуст, ввод читается из stdin.
+    std::string record; ///< Путь к файлу, в который записывается ввод-вывод программы
+    std::string replay; ///< Путь к воспроизводимой записи ввода-вывода
+    bool bytecode = false; ///< Файл содержит байт-код, а не исходный код
+    bool quiet = false; ///< Не выводить отчёт о выполнении. Сообщения об ошибках выводятся всегда.
+    bool help = false; ///< Вывести справку и завершиться
+    snm::ExecutionMode mode = snm::ExecutionMode::THREADED; ///< Режим исполнения инструкций
+};
+
+/**
+ * @brief Отладочная информация загруженной программы. Для байт-кода без контейнера пуста.
+ */
+struct DebugInfo {
+    snm::SourceToBytecodeMap source_map; ///< Соответствие строк исходного кода адресам байт-кода
+    snm::LabelMap labels; ///< Адреса меток
+};
+
+namespace {
+    void PrintUsage(std::ostream& stream) {
+        stream << "Usage: sandm-run [options] <file>\n"
+            "Assembles and runs a SANDM program. Program input is read from stdin, output is written to stdout,\n"
+            "the execution report is written to stderr. Files with the .snmb extension are loaded as assembled\n"
+            "programs without assembling.\n"
+            "\n"
+            "Options:\n"
+            "  -b, --bytecode   <file> contains bytecode instead of source code\n"
+            "  -c, --compile <output>\n"
+            "                   write the assembled program to <output> (.snmb) instead of running it\n"
+            "  -f, --fused      execute common instruction sequences (increments, loop tests, calls and\n"
+            "                   returns) as single fused operations\n"
+            "  -j, --jit        translate straight-line code and loops to native x86-64 code; falls back\n"
+            "                   to --fused on other platforms and when profiling\n"
+            "  -i, --input <file>\n"
+            "                   read program input from <file>, parsed before the run; stdin is used\n"
+            "                   once the file is exhausted\n"
+            "  -p, --profile <output>\n"
+            "                   write the execution profile to <output>: CSV for .csv, JSON for .json,\n"
+            "                   collapsed stacks for flame graphs otherwise\n"
+            "  -r, --reference  use the reference interpreter instead of the threaded one\n"
+            "  --record <output>\n"
+            "                   write every input value and output value with its type and instruction\n"
+            "                   count to <output> (.snmr), also when the run fails\n"
+            "  --replay <file>  take program input from a recording made with --record without reading\n"
+            "                   stdin and fail at the first output, input request or instruction count\n"
+            "                   that differs from the recording\n"
+            "  -q, --quiet      do not print the status, instruction count and time; error messages are\n"
+            "                   still printed\n"
+            "  -h, --help       show this help\n";
+    }
+
+    bool ParseOptions(const int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string argument = argv[i];
+
+            if (argument == "-b" || argument == "--bytecode") {
+                options.bytecode = true;
+            } else if (argument == "-c" || argument == "--compile") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.output = argv[i];
+            } else if (argument == "-f" || argument == "--fused") {
+                options.mode = snm::ExecutionMode::FUSED;
+            } else if (argument == "-j" || argument == "--jit") {
+                options.mode = snm::ExecutionMode::JIT;
+            } else if (argument == "-i" || argument == "--input") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.input = argv[i];
+            } else if (argument == "-p" || argument == "--profile") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.profile = argv[i];
+            } else if (argument == "--record") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.record = argv[i];
+            } else if (argument == "--replay") {
+                if (++i == argc) {
+                    return false;
+                }
+                options.replay = argv[i];
+            } else if (argument == "-r" || argument == "--reference") {
+                options.mode = snm::ExecutionMode::REFERENCE;
+            } else if (argument == "-q" || argument == "--quiet") {
+                options.quiet = true;
+            } else if (argument == "-h" || argument == "--help") {
+                options.help = true;
+                return true;
+            } else if (argument.starts_with("-") || !options.path.empty()) {
+                return false;
+            } else {
+                options.path = argument;
+            }
+        }
+
+        // Воспроизведение заменяет весь ввод, а его запись совпала бы с воспроизводимой
+        return !options.path.empty()
+               && (options.replay.empty() || (options.input.empty() && options.record.empty()));
+    }
+
+    std::string ReadFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error(std::format("Cannot open file {}", path));
+        }
+
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    bool IsProgramFile(const Options& options) {
+        return !options.bytecode && options.path.ends_with(ProgramFile::EXTENSION);
+    }
+
+    DebugInfo LoadProgram(const Options& options, VirtualMachine& virtual_machine) {
+        if (IsProgramFile(options)) {
+            const ProgramFile file(options.path);
+            virtual_machine.Load(file.GetByteCode());
+            return {file.GetSourceMap(), file.GetLabels()};
+        }
+
+        const std::string content = ReadFile(options.path);
+
+        if (options.bytecode) {
+            virtual_machine.Load(snm::ByteCode(content.begin(), content.end()));
+            return {};
+        }
+
+        Assembler assembler;
+        auto [byte_code, labels, source_map] = assembler.CompileProgram(content);
+        virtual_machine.Load(byte_code);
+        return {std::move(source_map), std::move(labels)};
+    }
+
+    void WriteProfile(const std::string& path, const Profiler& profiler, const DebugInfo& debug_info) {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error(std::format("Cannot open file {}", path));
+        }
+
+        if (path.ends_with(".csv")) {
+            profiler.WriteCsv(file, debug_info.source_map);
+        } else if (path.ends_with(".json")) {
+            profiler.WriteJson(file, debug_info.source_map);
+        } else {
+            profiler.WriteCollapsedStacks(file, debug_info.source_map, debug_info.labels);
+        }
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(std::cerr);
+        return LOAD_ERROR;
+    }
+
+    if (options.help) {
+        PrintUsage(std::cout);
+        return SUCCESS;
+    }
+
+    if (!options.output.empty()) {
+        if (options.bytecode || IsProgramFile(options)) {
+            PrintUsage(std::cerr);
+            return LOAD_ERROR;
+        }
+
+        try {
+            Assembler assembler;
+            ProgramFile::Write(options.output, assembler.CompileProgram(ReadFile(options.path)));
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return LOAD_ERROR;
+        }
+
+        return SUCCESS;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    StreamIo io(std::cin, std::cout);
+    VirtualMachine virtual_machine(&io);
+    virtual_machine.SetExecutionMode(options.mode);
+
+    const auto instruction_counter = [&virtual_machine] {
+        return virtual_machine.GetInstructionCount();
+    };
+
+    std::optional<InputFeedIo> input_feed;
+    std::optional<ReplayIo> replay;
+    try {
+        if (!options.input.empty()) {
+            std::istringstream input(ReadFile(options.input));
+            input_feed.emplace(InputFeedIo::Parse(input), io);
+            virtual_machine.SetProcessorIo(&*input_feed);
+        }
+
+        if (!options.replay.empty()) {
+            replay.emplace(IoLogFile::Read(options.replay), io, instruction_counter);
+            virtual_machine.SetProcessorIo(&*replay);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return LOAD_ERROR;
+    }
+
+    std::optional<RecordingIo> recording;
+    if (!options.record.empty()) {
+        recording.emplace(input_feed ? static_cast<ProcessorIo&>(*input_feed) : io, instruction_counter);
+        virtual_machine.SetProcessorIo(&*recording);
+    }
+
+    Profiler profiler;
+    if (!options.profile.empty()) {
+        virtual_machine.SetProfiler(&profiler);
+    }
+
+    DebugInfo debug_info;
+    try {
+        debug_info = LoadProgram(options, virtual_machine);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return LOAD_ERROR;
+    }
+
+    int exit_code = SUCCESS;
+    std::string status = "halted";
+    std::string error;
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        virtual_machine.Run();
+        if (replay) {
+            replay->Finish();
+        }
+    } catch (const std::exception& e) {
+        exit_code = RUNTIME_ERROR;
+        status = "error";
+        error = e.what();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    io.Flush();
+
+    // Как и ошибки загрузки, сообщение выводится и в режиме -q: после вывода программы
+    if (!error.empty()) {
+        std::cout.flush();
+        std::cerr << error << std::endl;
+    }
+
+    if (recording) {
+        try {
+            IoLogFile::Write(options.record, recording->GetEvents());
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    if (!options.profile.empty()) {
+        try {
+            WriteProfile(options.profile, profiler, debug_info);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    if (!options.quiet) {
+        std::cerr << std::format("\nstatus: {}\ninstructions: {}\ntime: {:.3f} ms\n",
+                                 status, virtual_machine.GetInstructionCount(), elapsed.count());
+    }
+
+    return exit_code;
+}